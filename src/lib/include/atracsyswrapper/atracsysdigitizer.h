@@ -0,0 +1,40 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/** \brief When a digitizing pointer counts as still.
+ *
+ * The last `windowSamples` poses must stay within both spreads (RMS about
+ * their mean). After a point is taken the tip has to move `rearmDistanceMM`
+ * away before the next one, so holding still yields one point, not many.
+ */
+struct AtracsysDigitizerOptions {
+    uint32_t windowSamples = 50;
+    float maxTranslationStdMM = 0.15f;
+    float maxRotationStdDeg = 0.5f;
+    // Samples further than this many RMS from the mean are left out of the average.
+    float rejectionFactor = 2.5f;
+    float rearmDistanceMM = 5.f;
+};
+
+/** \brief A landmark taken by a pointer.
+ *
+ * Positions are the tool tip (the marker origin when the geometry has no
+ * tip offset), in camera coordinates and, when a reference geometry was
+ * seen in every averaged frame, in reference coordinates.
+ */
+struct AtracsysDigitizedPoint {
+    uint32_t geometryId = 0;
+    uint64_t timestampUS = 0;
+    std::array<float, 3> positionMM = { { 0.f, 0.f, 0.f } };
+    bool hasReference = false;
+    std::array<float, 3> positionInReferenceMM = { { 0.f, 0.f, 0.f } };
+    uint32_t samples = 0;
+    uint32_t rejected = 0;
+    float spreadMM = 0.f;
+};
@@ -0,0 +1,67 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <atracsyswrapper/atracsysmarker.h>
+
+/** \brief Pose of one tracked geometry in a frame.
+ *
+ * Plain data with a fixed layout so that frames can be copied into shared
+ * memory or ring buffers without serialisation.
+ *
+ * When the geometry has a tip offset, `tipMM` is the tip in camera
+ * coordinates and `tipUncertaintyMM` its expected error derived from the
+ * registration error. `tipInReferenceMM` is only set when the reference
+ * geometry is visible in the same frame.
+ */
+struct AtracsysPose {
+    uint32_t geometryId = 0;
+    uint32_t geometryPresenceMask = 0;
+    float registrationErrorMM = 0.f;
+    AtracsysMarker::Transform transform = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+
+    bool hasTip = false;
+    bool hasReferenceTip = false;
+    float tipUncertaintyMM = 0.f;
+    std::array<float, 3> tipMM = { { 0.f, 0.f, 0.f } };
+    std::array<float, 3> tipInReferenceMM = { { 0.f, 0.f, 0.f } };
+};
+
+/** \brief All poses reported by the device for one acquisition.
+ *
+ * MAX_POSES covers every geometry host matching can report. Only the first
+ * poseCount poses are meaningful; copyFrom() copies just those, which is
+ * what the frame channels and the shared-memory ring use.
+ */
+struct AtracsysFrame {
+    static const uint32_t MAX_POSES = 64;
+
+    uint64_t index = 0;
+    uint64_t timestampUS = 0;
+    uint32_t poseCount = 0;
+    std::array<AtracsysPose, MAX_POSES> poses;
+
+    // poseCount is clamped, so a frame read torn from a seqlock never overruns.
+    void copyFrom(const AtracsysFrame& other) {
+        const uint32_t count = std::min(other.poseCount, uint32_t(MAX_POSES));
+        index = other.index;
+        timestampUS = other.timestampUS;
+        poseCount = count;
+        memcpy(poses.data(), other.poses.data(), count * sizeof(AtracsysPose));
+    }
+
+    const AtracsysPose* findPose(uint32_t geometryId) const {
+        for (uint32_t i = 0; i < poseCount; ++i) {
+            if (poses[i].geometryId == geometryId) {
+                return &poses[i];
+            }
+        }
+        return nullptr;
+    }
+};
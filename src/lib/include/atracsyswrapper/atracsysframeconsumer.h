@@ -0,0 +1,53 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <atracsyswrapper/atracsysframe.h>
+
+/** \brief How a consumer waits for the next frame.
+ *
+ * BusySpin burns a core but wakes within the cache-line transfer time;
+ * SpinThenPark spins for a bounded number of iterations and then sleeps on a
+ * futex; Block goes straight to a condition variable and costs the most
+ * wake-up latency but no CPU.
+ */
+enum class AtracsysWaitStrategy : uint8_t {
+    BusySpin,
+    SpinThenPark,
+    Block
+};
+
+/** \brief How a rate-limited consumer derives its frames from the device stream.
+ *
+ * Decimate hands over the first device frame at or after each output
+ * instant. Resample interpolates every pose (slerp on rotation, lerp on
+ * translation) at the exact instant, which adds one device frame of latency.
+ * Output instants are multiples of the period on the device clock.
+ */
+enum class AtracsysRateMode : uint8_t {
+    Decimate,
+    Resample
+};
+
+/** \brief In-process reader of the frames built by the acquisition thread.
+ *
+ * Each consumer only sees the latest frame: a consumer that falls behind
+ * skips frames and counts them as missed instead of queueing them. A consumer
+ * is used from a single thread.
+ */
+class AtracsysFrameConsumer {
+public:
+    virtual ~AtracsysFrameConsumer() = default;
+
+    // Waits for a frame newer than the last one returned; false on timeout or shutdown.
+    virtual bool waitNext(AtracsysFrame& frame, uint32_t timeoutMs) = 0;
+
+    // Copies a newer frame if there is one, never waits.
+    virtual bool tryNext(AtracsysFrame& frame) = 0;
+
+    virtual AtracsysWaitStrategy getStrategy() const = 0;
+    virtual uint64_t getMissedCount() const = 0;
+};
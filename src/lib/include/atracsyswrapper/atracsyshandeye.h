@@ -0,0 +1,81 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsysstatus.h>
+
+/** \brief Pair selection and refinement settings of the hand-eye solver.
+ *
+ * Rotation angle and translation along the screw axis of a motion are the
+ * same on both sides of AX = XB; pairs where they disagree beyond the
+ * mismatch limits are badly synchronised or mistracked and are dropped.
+ * Small motions carry little information and are dropped as well.
+ */
+struct AtracsysHandEyeOptions {
+    float minRotationDeg = 10.f;
+    float maxAngleMismatchDeg = 1.f;
+    float maxScrewMismatchMM = 2.f;
+    // Largest rotations are kept first; 0 keeps all accepted pairs.
+    size_t maxPairs = 1000;
+    uint32_t refineIterations = 50;
+    // Weight of rotation residuals in the refinement: one radian counts as this many mm.
+    float rotationScaleMM = 100.f;
+};
+
+struct AtracsysHandEyeResult {
+    bool solved = false;
+    AtracsysMarker::Transform transform = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    size_t candidatePairs = 0;
+    size_t usedPairs = 0;
+    float rotationRmsDeg = 0.f;
+    float translationRmsMM = 0.f;
+};
+
+class ThreadPool;
+
+/** \brief Hand-eye calibration, e.g. ultrasound image plane to probe marker.
+ *
+ * Each station pairs the marker pose (marker into camera) with the pose of
+ * a fixed calibration object measured by the sensor (object into sensor
+ * frame) at the same instant; AtracsysWrapper::poseAt() gives the marker
+ * pose at the sensor timestamp. The solution X maps sensor coordinates into
+ * marker coordinates. With M the marker and S the sensor poses, every pair
+ * of stations gives A = Mj^-1 Mi and B = Sj Si^-1 with AX = XB.
+ *
+ * Tsai-Lenz provides the closed-form estimate, which Levenberg-Marquardt
+ * then refines on rotation and translation residuals jointly. Pair scoring
+ * and the refinement run on the calibration's own threads.
+ */
+class AtracsysHandEyeCalibration {
+public:
+    typedef AtracsysMarker::Transform Transform;
+
+    // `threads` includes the caller; 0 uses one per hardware thread.
+    explicit AtracsysHandEyeCalibration(size_t threads = 0);
+    virtual ~AtracsysHandEyeCalibration();
+
+    AtracsysHandEyeCalibration(const AtracsysHandEyeCalibration&) = delete;
+    AtracsysHandEyeCalibration& operator=(const AtracsysHandEyeCalibration&) = delete;
+
+    void addStation(const Transform& markerPose, const Transform& sensorPose);
+    size_t getStationCount() const { return stations.size(); }
+    void clear() { stations.clear(); }
+
+    AtracsysStatus solve(const AtracsysHandEyeOptions& options, AtracsysHandEyeResult& result) const;
+
+private:
+    struct Station {
+        Transform marker;
+        Transform sensor;
+    };
+
+    std::vector<Station> stations;
+    std::unique_ptr<ThreadPool> pool;
+};
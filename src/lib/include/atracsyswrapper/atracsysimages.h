@@ -0,0 +1,90 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class AtracsysCamera : uint8_t {
+    Left,
+    Right
+};
+
+enum class AtracsysImageEncoding : uint8_t {
+    // Rows packed without padding, little-endian for 16-bit pixels.
+    Raw,
+    // Lossless: residuals to the left neighbour (the pixel above for the first column), Rice coded in blocks of 32.
+    DeltaRice
+};
+
+/** \brief Camera image stage.
+ *
+ * Images are copied into one of `buffers` pooled buffers and processed on
+ * `workers` threads: optionally box-averaged over `downsample` x `downsample`
+ * pixels, then optionally compressed. Buffers circulate between the pool and
+ * the consumer, so once every buffer has grown to the image size nothing is
+ * allocated. When all buffers are in use new images are dropped.
+ */
+struct AtracsysImageOptions {
+    bool enabled = false;
+    uint32_t downsample = 1;
+    bool compress = false;
+    uint32_t buffers = 8;
+    size_t workers = 2;
+};
+
+struct AtracsysImage {
+    uint64_t frameIndex = 0;
+    uint64_t timestampUS = 0;
+    AtracsysCamera camera = AtracsysCamera::Left;
+    // After downsampling.
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t bytesPerPixel = 1;
+    AtracsysImageEncoding encoding = AtracsysImageEncoding::Raw;
+    std::vector<uint8_t> data;
+};
+
+struct AtracsysImageStats {
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;
+    uint64_t processed = 0;
+    // Wrapper only: frames that came and went while its image thread was still copying.
+    uint64_t skipped = 0;
+};
+
+/** \brief Pooled image pipeline, fed by the acquisition thread or by any other image source.
+ *
+ * push() only copies the pixels and queues them, it never waits for the
+ * workers. poll() and wait() hand out finished images in completion order
+ * by swapping buffers with `image.data`; passing the same AtracsysImage
+ * back in returns its old buffer to the pool.
+ */
+class AtracsysImagePipeline {
+public:
+    explicit AtracsysImagePipeline(const AtracsysImageOptions& options = AtracsysImageOptions());
+    virtual ~AtracsysImagePipeline();
+
+    AtracsysImagePipeline(const AtracsysImagePipeline&) = delete;
+    AtracsysImagePipeline& operator=(const AtracsysImagePipeline&) = delete;
+
+    // False when the image is dropped: no free buffer, or invalid dimensions.
+    bool push(AtracsysCamera camera, uint64_t frameIndex, uint64_t timestampUS, const uint8_t* pixels,
+              uint16_t width, uint16_t height, int32_t strideBytes, uint8_t bytesPerPixel);
+
+    bool poll(AtracsysImage& image);
+    bool wait(AtracsysImage& image, uint32_t timeoutMs);
+
+    AtracsysImageStats getStats() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+// Decodes any encoding into packed Raw pixels.
+bool decodeImage(const AtracsysImage& image, std::vector<uint8_t>& pixels);
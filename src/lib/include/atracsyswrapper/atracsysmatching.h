@@ -0,0 +1,25 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** \brief Marker matching on the host instead of the device.
+ *
+ * With `hostMatching` the device only sends triangulated 3D fiducials (up
+ * to `maxFiducials` per frame) and the wrapper identifies the geometries
+ * itself, so geometries the device refuses can still be tracked. A geometry
+ * is reported when at least `minFiducials` of its fiducials are found whose
+ * pairwise distances agree with the geometry within `distanceToleranceMM`
+ * and whose rigid fit leaves an RMS residual below `maxRegistrationErrorMM`.
+ */
+struct AtracsysMatchingOptions {
+    bool hostMatching = false;
+    uint32_t maxFiducials = 128;
+    float distanceToleranceMM = 0.5f;
+    float maxRegistrationErrorMM = 0.5f;
+    uint32_t minFiducials = 3;
+};
@@ -0,0 +1,23 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \brief Indexed triangle mesh, e.g. a bone surface segmented from CT. */
+struct AtracsysMesh {
+    std::vector<std::array<float, 3>> vertices;
+    std::vector<std::array<uint32_t, 3>> triangles;
+};
+
+/** \brief Reads a binary or ASCII STL file.
+ *
+ * STL repeats shared vertices for every facet; identical positions are
+ * merged so the mesh comes back indexed. Facet normals are ignored.
+ */
+bool loadStlMesh(const std::string& fileName, AtracsysMesh& mesh);
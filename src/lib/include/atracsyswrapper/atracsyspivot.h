@@ -0,0 +1,25 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/** \brief State of a running or finished pivot calibration.
+ *
+ * `tipMM` is the tool tip in marker coordinates (what the geometry [pivot]
+ * section stores), `pivotMM` the fixed pivot point in camera coordinates.
+ * The solution is only meaningful once `solved` is set, i.e. the tool was
+ * rotated enough around the pivot for the system to be well conditioned.
+ */
+struct AtracsysPivotCalibration {
+    uint32_t geometryId = 0;
+    uint64_t samples = 0;
+    uint64_t rejected = 0;
+    bool solved = false;
+    std::array<float, 3> tipMM = { { 0.f, 0.f, 0.f } };
+    std::array<float, 3> pivotMM = { { 0.f, 0.f, 0.f } };
+    float rmsMM = 0.f;
+};
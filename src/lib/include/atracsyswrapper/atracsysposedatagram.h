@@ -0,0 +1,81 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <atracsyswrapper/atracsysframe.h>
+
+/** \brief Compact binary pose datagram, one per frame.
+ *
+ * All fields are little endian.
+ *
+ *     header (20 bytes)
+ *       uint32 magic "ATRD", uint8 version, uint8 toolCount, uint16 session,
+ *       uint32 sequence, uint64 timestampUS
+ *     per tool (28 bytes)
+ *       uint32 geometryId, int16[4] quaternion w,x,y,z (scaled by 32767),
+ *       int32[3] translation in micrometres, uint16 registration error in
+ *       micrometres (saturated), uint16 geometry presence mask
+ *
+ * The session changes whenever a publisher (re)starts its sequence at 0.
+ * Frames with more than 51 tools exceed a 1500-byte MTU and are sent as
+ * fragmented datagrams.
+ */
+namespace AtracsysPoseDatagram {
+    static const uint32_t MAGIC = 0x44525441; // "ATRD"
+    static const uint8_t VERSION = 1;
+    static const size_t HEADER_SIZE = 20;
+    static const size_t TOOL_SIZE = 28;
+    static const size_t MAX_SIZE = HEADER_SIZE + TOOL_SIZE * AtracsysFrame::MAX_POSES;
+
+    // Returns the datagram size, 0 if `capacity` is too small.
+    size_t encode(const AtracsysFrame& frame, uint16_t session, uint32_t sequence, uint8_t* buffer, size_t capacity);
+
+    // Fills `frame` (index is set to the sequence number), `session` and `sequence`.
+    bool decode(const uint8_t* buffer, size_t size, AtracsysFrame& frame, uint16_t& session, uint32_t& sequence);
+}
+
+class SocketLibrary;
+
+/** \brief Receives pose datagrams and detects gaps in the sequence.
+ *
+ * Binds the port and joins `group` when it is a multicast address; any other
+ * address (e.g. 127.0.0.1) simply receives unicast datagrams. A new session,
+ * or a sequence more than MAX_REORDER behind the last one, restarts gap
+ * detection instead of discarding the restarted stream as out of order.
+ */
+class AtracsysPoseReceiver {
+public:
+    static const uint32_t MAX_REORDER = 1024;
+
+    AtracsysPoseReceiver();
+    virtual ~AtracsysPoseReceiver();
+
+    AtracsysPoseReceiver(const AtracsysPoseReceiver&) = delete;
+    AtracsysPoseReceiver& operator=(const AtracsysPoseReceiver&) = delete;
+
+    bool open(const std::string& group, uint16_t port, const std::string& interfaceAddress = "0.0.0.0");
+    void close();
+
+    // Waits up to `timeoutMs` for the next valid datagram.
+    bool receive(AtracsysFrame& frame, int timeoutMs);
+
+    uint64_t getReceivedCount() const { return received; }
+    uint64_t getLostCount() const { return lost; }
+    uint64_t getOutOfOrderCount() const { return outOfOrder; }
+
+private:
+    std::unique_ptr<SocketLibrary> socketLibrary;
+    intptr_t socket;
+    bool hasSequence = false;
+    uint16_t lastSession = 0;
+    uint32_t lastSequence = 0;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t outOfOrder = 0;
+};
@@ -0,0 +1,43 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** \brief Non-owning view of a contiguous array, like C++20 std::span.
+ */
+template<typename T>
+class AtracsysSpan {
+public:
+    constexpr AtracsysSpan() = default;
+    constexpr AtracsysSpan(T* data, size_t size) : pointer(data), count(data != nullptr ? size : 0) {}
+
+    constexpr T* data() const { return pointer; }
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+
+    constexpr T* begin() const { return pointer; }
+    constexpr T* end() const { return pointer + count; }
+    constexpr T& operator[](size_t index) const { return pointer[index]; }
+
+private:
+    T* pointer = nullptr;
+    size_t count = 0;
+};
+
+/** \brief Raw detections kept with every frame, see AtracsysRawFrame.
+ *
+ * Frames are acquired into a pool of `buffers` SDK frame buffers holding up
+ * to `maxBlobs` blobs per camera and `maxFiducials` triangulated fiducials.
+ * Every raw frame held by a reader pins one buffer; the acquisition thread
+ * needs one more than the readers pin to keep publishing raw data.
+ */
+struct AtracsysRawDataOptions {
+    bool enabled = false;
+    uint32_t maxBlobs = 256;
+    uint32_t maxFiducials = 128;
+    uint32_t buffers = 4;
+};
@@ -0,0 +1,70 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ftkInterface.h>
+#include <atracsyswrapper/atracsysrawdata.h>
+
+class RawFramePool;
+
+/** \brief Blobs and 3D fiducials behind one published frame.
+ *
+ * Needs the Atracsys SDK headers, so it is only included by code that reads
+ * raw data. The spans point straight into a pooled SDK frame buffer: while
+ * the handle holds it, the acquisition thread writes into the other buffers,
+ * and the spans stay valid until release() or destruction. Handles may
+ * outlive tracking and the wrapper itself.
+ */
+class AtracsysRawFrame {
+public:
+    AtracsysRawFrame() = default;
+    ~AtracsysRawFrame();
+
+    AtracsysRawFrame(AtracsysRawFrame&& other) noexcept;
+    AtracsysRawFrame& operator=(AtracsysRawFrame&& other) noexcept;
+    AtracsysRawFrame(const AtracsysRawFrame&) = delete;
+    AtracsysRawFrame& operator=(const AtracsysRawFrame&) = delete;
+
+    bool isValid() const { return query != nullptr; }
+    void release();
+
+    // AtracsysFrame::index of the pose frame built from the same acquisition.
+    uint64_t getIndex() const { return index; }
+    uint64_t getTimestampUS() const { return timestampUS; }
+
+    AtracsysSpan<const ftkRawData> getLeftBlobs() const {
+        return query != nullptr ? AtracsysSpan<const ftkRawData>(query->rawDataLeft, query->rawDataLeftCount)
+                                : AtracsysSpan<const ftkRawData>();
+    }
+    AtracsysSpan<const ftkRawData> getRightBlobs() const {
+        return query != nullptr ? AtracsysSpan<const ftkRawData>(query->rawDataRight, query->rawDataRightCount)
+                                : AtracsysSpan<const ftkRawData>();
+    }
+    AtracsysSpan<const ftk3DFiducial> getFiducials() const {
+        return query != nullptr ? AtracsysSpan<const ftk3DFiducial>(query->threeDFiducials, query->threeDFiducialsCount)
+                                : AtracsysSpan<const ftk3DFiducial>();
+    }
+
+    // The whole SDK frame, e.g. for the camera images when they are enabled.
+    const ftkFrameQuery* getQuery() const { return query; }
+
+    // True when the device found more detections than the buffers hold.
+    bool isTruncated() const {
+        return query != nullptr && (query->rawDataLeftStat == QS_ERR_OVERFLOW ||
+                                    query->rawDataRightStat == QS_ERR_OVERFLOW ||
+                                    query->threeDFiducialsStat == QS_ERR_OVERFLOW);
+    }
+
+private:
+    friend class RawFramePool;
+
+    std::shared_ptr<RawFramePool> pool;
+    uint32_t slot = 0;
+    const ftkFrameQuery* query = nullptr;
+    uint64_t index = 0;
+    uint64_t timestampUS = 0;
+};
@@ -0,0 +1,44 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \brief Scheduling and memory settings for the acquisition thread.
+ *
+ * Fifo and RoundRobin map to SCHED_FIFO / SCHED_RR on Linux (needs
+ * CAP_SYS_NICE or an rtprio limit) and to time-critical priority on Windows.
+ * An empty `cpus` list leaves the affinity untouched.
+ */
+struct AtracsysRealtimeOptions {
+    enum class Policy : uint8_t {
+        Inherit,
+        Fifo,
+        RoundRobin
+    };
+
+    Policy policy = Policy::Inherit;
+    int priority = 0;
+    std::vector<int> cpus;
+
+    // mlockall() in startTracking() and pre-fault the acquisition thread stack.
+    bool lockMemory = false;
+    size_t prefaultStackBytes = 256 * 1024;
+};
+
+/** \brief Frame arrival jitter seen by the acquisition loop.
+ *
+ * Jitter is the absolute difference between one frame interval and the
+ * running mean interval, measured on the host monotonic clock.
+ */
+struct AtracsysJitterStats {
+    uint64_t samples = 0;
+    double periodUS = 0.0;
+    double meanUS = 0.0;
+    double p99US = 0.0;
+    double maxUS = 0.0;
+};
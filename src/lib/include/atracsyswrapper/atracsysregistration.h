@@ -0,0 +1,86 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsysstatus.h>
+
+/** \brief Settings of the RANSAC registration.
+ *
+ * Hypotheses are fitted to three random correspondences; the one explaining
+ * most pairs within `inlierThresholdMM` is refitted on its inliers. The
+ * number of hypotheses shrinks as the inlier ratio found so far rises, so
+ * that an all-inlier sample is drawn with probability `confidence`.
+ */
+struct AtracsysRansacOptions {
+    float inlierThresholdMM = 2.f;
+    uint32_t maxIterations = 2000;
+    float confidence = 0.999f;
+    size_t minInliers = 3;
+    uint64_t seed = 1;
+};
+
+/** \brief Outcome of a point-based rigid registration.
+ *
+ * `transform` maps source coordinates into target coordinates. Residuals
+ * are listed for every correspondence; FRE is the RMS residual over the
+ * pairs used for the fit (all of them unless RANSAC rejected some).
+ */
+struct AtracsysRegistrationResult {
+    bool valid = false;
+    AtracsysMarker::Transform transform = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    float freMM = 0.f;
+    std::vector<float> residualsMM;
+    std::vector<uint8_t> inliers;
+    size_t inlierCount = 0;
+    uint32_t hypotheses = 0;
+};
+
+struct AtracsysRegistrationProblem {
+    std::vector<std::array<float, 3>> source;
+    std::vector<std::array<float, 3>> target;
+    bool ransac = false;
+    AtracsysRansacOptions ransacOptions;
+};
+
+class ThreadPool;
+
+/** \brief Paired-point rigid registration, e.g. patient landmarks to image space.
+ *
+ * The closed-form solution is Horn's unit quaternion method: the rotation is
+ * the dominant eigenvector of a 4x4 matrix built from the cross-covariance
+ * of the centred point sets, which never yields a reflection. RANSAC
+ * hypotheses and batches run in parallel on the registration's own threads.
+ */
+class AtracsysRegistration {
+public:
+    typedef std::array<float, 3> Point;
+
+    // `threads` includes the caller; 0 uses one per hardware thread.
+    explicit AtracsysRegistration(size_t threads = 0);
+    virtual ~AtracsysRegistration();
+
+    AtracsysRegistration(const AtracsysRegistration&) = delete;
+    AtracsysRegistration& operator=(const AtracsysRegistration&) = delete;
+
+    AtracsysStatus registerPoints(const std::vector<Point>& source, const std::vector<Point>& target,
+                                  AtracsysRegistrationResult& result) const;
+
+    AtracsysStatus registerPointsRansac(const std::vector<Point>& source, const std::vector<Point>& target,
+                                        const AtracsysRansacOptions& options,
+                                        AtracsysRegistrationResult& result) const;
+
+    // Solves all problems, one per thread at a time; returns the number of valid results.
+    size_t registerBatch(const std::vector<AtracsysRegistrationProblem>& problems,
+                         std::vector<AtracsysRegistrationResult>& results) const;
+
+private:
+    std::unique_ptr<ThreadPool> pool;
+};
@@ -0,0 +1,120 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <atracsyswrapper/atracsysframe.h>
+
+/** \brief Layout of the shared-memory pose ring.
+ *
+ * A header followed by `capacity` slots. Each slot is protected by its own
+ * sequence counter (seqlock): odd while the writer is copying, even once the
+ * frame is complete. `published` counts frames written so far; the latest
+ * frame lives in slot (published - 1) % capacity.
+ *
+ * `magic` doubles as the open flag: the writer clears it when it closes the
+ * segment, or when a new writer replaces the segment of one that died
+ * (`writerPid` is no longer running).
+ */
+namespace AtracsysSharedPoses {
+    static const uint32_t MAGIC = 0x50525441; // "ATRP"
+    static const uint32_t VERSION = 4;
+
+    struct Header {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t capacity;
+        uint32_t slotSize;
+        int32_t writerPid;
+        alignas(64) std::atomic<uint64_t> published;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> sequence;
+        uint64_t publication;
+        AtracsysFrame frame;
+    };
+
+    static_assert(std::is_trivially_copyable<AtracsysFrame>::value, "frames are copied with memcpy");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be address free");
+
+    inline size_t segmentSize(uint32_t capacity) {
+        return sizeof(Header) + sizeof(Slot) * capacity;
+    }
+}
+
+/** \brief Read side of the shared-memory pose publisher.
+ *
+ * Opens the segment created by AtracsysWrapper::startSharedMemoryPublisher()
+ * read-only. Reads never block the writer: a torn read is detected through
+ * the slot sequence and retried.
+ *
+ * Every read checks that the writer still holds the segment. Once it has
+ * closed it, or a new writer has replaced it, reads fail and
+ * isPublisherOpen() returns false; close() and open() again to follow the
+ * new segment.
+ */
+class AtracsysSharedPoseReader {
+public:
+    AtracsysSharedPoseReader();
+    virtual ~AtracsysSharedPoseReader();
+
+    AtracsysSharedPoseReader(const AtracsysSharedPoseReader&) = delete;
+    AtracsysSharedPoseReader& operator=(const AtracsysSharedPoseReader&) = delete;
+
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const;
+    bool isPublisherOpen() const;
+
+    uint32_t getCapacity() const;
+    uint64_t getPublishedCount() const;
+
+    // Copies the most recent frame.
+    bool readLatest(AtracsysFrame& frame) const;
+
+    // Copies frame number `publication` (0-based) while it is still in the ring.
+    bool read(uint64_t publication, AtracsysFrame& frame) const;
+
+    // Copies up to `count` of the most recent frames, oldest first; returns the number copied.
+    size_t readHistory(AtracsysFrame* frames, size_t count) const;
+
+    /** \brief Zero-copy access to the latest frame.
+     *
+     * `visitor` gets a reference into shared memory. The return value tells
+     * whether the frame stayed consistent for the whole visit; when it is
+     * false the visitor saw a torn frame and must discard what it computed.
+     */
+    template<typename Visitor>
+    bool visitLatest(Visitor&& visitor) const {
+        if (!isPublisherOpen()) {
+            return false;
+        }
+        const uint64_t published = header->published.load(std::memory_order_acquire);
+        if (published == 0) {
+            return false;
+        }
+        const AtracsysSharedPoses::Slot& slot = slots[(published - 1) % header->capacity];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            return false;
+        }
+        visitor(slot.frame);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+private:
+    bool readSlot(uint64_t publication, AtracsysFrame& frame) const;
+
+    const AtracsysSharedPoses::Header* header = nullptr;
+    const AtracsysSharedPoses::Slot* slots = nullptr;
+    size_t mappedSize = 0;
+};
@@ -0,0 +1,48 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atracsyswrapper/atracsysstatus.h>
+
+struct AtracsysStartupGeometry {
+    std::string filename;
+    std::string geometryId;
+};
+
+/** \brief Everything AtracsysWrapper::initAsync() brings up.
+ *
+ * Geometries are registered as by addGeometry(); with `startTracking` the
+ * frame is sized from the matching, raw data and image options set before
+ * the call.
+ */
+struct AtracsysStartupOptions {
+    std::vector<AtracsysStartupGeometry> geometries;
+    bool startTracking = true;
+};
+
+/** \brief Wall-clock duration of each start-up phase.
+ *
+ * Geometry parsing and frame allocation run alongside enumeration, so the
+ * phases add up to more than `totalUS`. Phases that did not run are zero.
+ */
+struct AtracsysStartupTimings {
+    uint64_t libraryUS = 0;
+    uint64_t enumerationUS = 0;
+    uint64_t optionsUS = 0;
+    uint64_t geometryParsingUS = 0;
+    uint64_t geometryUploadUS = 0;
+    uint64_t frameAllocationUS = 0;
+    uint64_t trackingUS = 0;
+    uint64_t totalUS = 0;
+};
+
+struct AtracsysStartupReport {
+    AtracsysStatus status;
+    AtracsysStartupTimings timings;
+};
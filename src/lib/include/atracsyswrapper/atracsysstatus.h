@@ -0,0 +1,68 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class AtracsysStatusCode : uint8_t {
+    Ok = 0,
+    NotInitialised,
+    LibraryInitFailed,
+    NoDevice,
+    UnknownDevice,
+    OptionFailed,
+    GeometryLoadFailed,
+    GeometryUploadFailed,
+    FrameAllocationFailed,
+    FrameOptionsFailed,
+    NotTracking,
+    FrameTimeout,
+    NoMarkers,
+    MarkerOverflow,
+    InvalidFrame,
+    CloseFailed,
+    ThreadStartFailed,
+    MemoryLockFailed,
+    UnknownGeometry,
+    CalibrationNotSolved,
+    GeometrySaveFailed,
+    InvalidCorrespondences,
+    RegistrationFailed,
+    TooManyPointers,
+    MeshLoadFailed,
+    NoMesh,
+    AcquisitionRunning,
+    TooManyGeometries,
+    Count
+};
+
+/** \brief Result of a wrapper call.
+ *
+ * Carries the wrapper status code and, when the failure came from the SDK,
+ * the raw ftkError value. Copying and inspecting a status never allocates;
+ * the SDK error text is only fetched on demand through
+ * AtracsysWrapper::getLastErrorString().
+ */
+class AtracsysStatus {
+public:
+    constexpr AtracsysStatus() = default;
+    constexpr AtracsysStatus(AtracsysStatusCode code, int32_t ftkError = 0)
+            : code(code), ftkError(ftkError) {}
+
+    constexpr AtracsysStatusCode getCode() const { return code; }
+    constexpr int32_t getFtkError() const { return ftkError; }
+
+    constexpr bool isOk() const { return code == AtracsysStatusCode::Ok; }
+    constexpr explicit operator bool() const { return isOk(); }
+
+    const char* getMessage() const;
+
+private:
+    AtracsysStatusCode code = AtracsysStatusCode::Ok;
+    int32_t ftkError = 0;
+};
+
+const char* toString(AtracsysStatusCode code);
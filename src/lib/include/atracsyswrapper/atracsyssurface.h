@@ -0,0 +1,31 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** \brief Surface sweep settings.
+ *
+ * Tip positions are merged into cubic voxels of `voxelSizeMM`; each voxel
+ * keeps the mean of the tips that fell into it. At most `maxVoxels` are
+ * kept, after that new voxels are refused while existing ones still refine.
+ * With `useReference` points are collected in the reference geometry (see
+ * AtracsysWrapper::setReferenceGeometry()), so the patient may move.
+ */
+struct AtracsysSurfaceOptions {
+    float voxelSizeMM = 1.f;
+    size_t maxVoxels = 200000;
+    bool useReference = true;
+    // Tips less certain than this are skipped; 0 accepts all.
+    float maxTipUncertaintyMM = 0.f;
+};
+
+struct AtracsysSurfaceStats {
+    uint64_t samples = 0;
+    uint64_t skipped = 0;
+    uint64_t refused = 0;
+    size_t voxels = 0;
+};
@@ -0,0 +1,88 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsysmesh.h>
+#include <atracsyswrapper/atracsysstatus.h>
+
+enum class AtracsysIcpMetric : uint8_t {
+    PointToPoint,
+    // Distances along the surface normal; converges in far fewer iterations on smooth surfaces.
+    PointToPlane,
+};
+
+/** \brief ICP settings.
+ *
+ * Each iteration only fits the `inlierFraction` of points closest to the
+ * mesh (trimmed ICP), so points digitized off the modelled surface do not
+ * pull the result. Besides the initial transform, `starts - 1` further
+ * starts rotate the points by `startAngleDeg` about their centroid around
+ * evenly spread axes; the start ending with the lowest RMS wins.
+ */
+struct AtracsysIcpOptions {
+    AtracsysIcpMetric metric = AtracsysIcpMetric::PointToPlane;
+    uint32_t maxIterations = 50;
+    float inlierFraction = 0.9f;
+    // Also drop pairs further apart than this; 0 disables the limit.
+    float maxDistanceMM = 0.f;
+    // Stop once an iteration moves no point by more than this.
+    float convergenceMM = 1e-3f;
+    uint32_t starts = 1;
+    float startAngleDeg = 30.f;
+};
+
+struct AtracsysIcpResult {
+    bool converged = false;
+    AtracsysMarker::Transform transform = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    float rmsMM = 0.f;
+    size_t inliers = 0;
+    uint32_t iterations = 0;
+    uint32_t start = 0;
+};
+
+class MeshBvh;
+class ThreadPool;
+
+/** \brief Registers digitized surface points to a mesh with ICP.
+ *
+ * setMesh() builds an immutable bounding volume hierarchy once; every
+ * registration against it afterwards spreads the closest-point queries
+ * over the registration's own threads. `transform` maps point coordinates
+ * (e.g. the reference geometry) into mesh coordinates.
+ */
+class AtracsysSurfaceRegistration {
+public:
+    typedef std::array<float, 3> Point;
+    typedef AtracsysMarker::Transform Transform;
+
+    // `threads` includes the caller; 0 uses one per hardware thread.
+    explicit AtracsysSurfaceRegistration(size_t threads = 0);
+    virtual ~AtracsysSurfaceRegistration();
+
+    AtracsysSurfaceRegistration(const AtracsysSurfaceRegistration&) = delete;
+    AtracsysSurfaceRegistration& operator=(const AtracsysSurfaceRegistration&) = delete;
+
+    AtracsysStatus setMesh(const AtracsysMesh& mesh);
+    AtracsysStatus loadMesh(const std::string& stlFileName);
+
+    AtracsysStatus registerPoints(const std::vector<Point>& points, const Transform& initial,
+                                  const AtracsysIcpOptions& options, AtracsysIcpResult& result) const;
+
+private:
+    struct Run;
+
+    void runIcp(const std::vector<Point>& points, const Transform& start, const AtracsysIcpOptions& options,
+                Run& run) const;
+
+    std::unique_ptr<MeshBvh> bvh;
+    std::unique_ptr<ThreadPool> pool;
+};
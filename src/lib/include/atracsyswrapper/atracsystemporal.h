@@ -0,0 +1,67 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atracsyswrapper/atracsysframe.h>
+#include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsysstatus.h>
+
+struct AtracsysTemporalOptions {
+    // Grid both motion signals are resampled on; the offset is refined below one grid step.
+    float sampleRateHz = 1000.f;
+    float maxOffsetMS = 500.f;
+    // Weight of angular speed in the motion magnitude: one radian per second counts as this many mm/s.
+    float rotationScaleMM = 100.f;
+};
+
+/** \brief Estimated latency of an external stream.
+ *
+ * `offsetUS` is added to an external timestamp to obtain the tracker
+ * timestamp of the same instant; AtracsysWrapper::setTimeOffset() takes it
+ * as is. `correlation` is the normalised peak in [-1, 1]; values well below
+ * 0.5 mean the recordings did not share enough distinct motion.
+ */
+struct AtracsysTemporalResult {
+    bool solved = false;
+    double offsetUS = 0.0;
+    float correlation = 0.f;
+    size_t gridSamples = 0;
+};
+
+/** \brief Time offset between the tracker and another timestamped stream.
+ *
+ * Both streams are reduced to a motion magnitude (speed of a pose, or of a
+ * scalar position such as an encoder), resampled on a common grid and
+ * cross-correlated through an FFT. The correlation peak is refined by a
+ * parabola through its neighbours. Move the tool with varied, jerky motion
+ * while recording; steady motion has no distinct features to align.
+ */
+class AtracsysTemporalCalibration {
+public:
+    typedef AtracsysMarker::Transform Transform;
+
+    void addTrackerPose(uint64_t timestampUS, const Transform& pose);
+    // Takes the pose of `geometryId` if the frame contains it.
+    void addTrackerFrame(const AtracsysFrame& frame, uint32_t geometryId);
+
+    void addExternalPose(uint64_t timestampUS, const Transform& pose);
+    void addExternalPosition(uint64_t timestampUS, float position);
+
+    void clear();
+
+    AtracsysStatus solve(const AtracsysTemporalOptions& options, AtracsysTemporalResult& result) const;
+
+private:
+    struct Sample {
+        uint64_t timestampUS;
+        Transform pose;
+    };
+
+    std::vector<Sample> tracker;
+    std::vector<Sample> external;
+};
@@ -0,0 +1,92 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <atracsyswrapper/atracsysframe.h>
+#include <atracsyswrapper/atracsysmarker.h>
+
+/** \brief Named coordinate frames linked by rigid transforms.
+ *
+ * Edges map coordinates of a child frame into its parent. Static edges hold
+ * calibrations (tool to tip, reference to image); tracked edges take the pose
+ * of a geometry from each frame passed to update(), i.e. marker into camera.
+ *
+ * lookup(from, to) composes the transforms along the shortest path. Paths
+ * and composed results are cached; a cached result is reused until one of
+ * the edges on its path changes, so with a handful of moving markers most
+ * queries cost a version check per edge. The graph is not thread-safe: feed
+ * and query it from one thread, e.g. the one draining a frame consumer.
+ */
+class AtracsysTransformGraph {
+public:
+    typedef AtracsysMarker::Transform Transform;
+    typedef uint32_t NodeId;
+
+    static const NodeId INVALID_NODE = UINT32_MAX;
+
+    // Returns the id of `name`, creating the frame if needed.
+    NodeId addNode(const std::string& name);
+    NodeId findNode(const std::string& name) const;
+
+    // Adds or replaces the calibration from `child` into `parent`.
+    void setStaticEdge(const std::string& child, const std::string& parent, const Transform& childToParent);
+
+    // `marker` follows geometry `geometryId` as seen from `camera`.
+    void addTrackedEdge(const std::string& marker, const std::string& camera, uint32_t geometryId);
+
+    // Refreshes tracked edges; a geometry missing from the frame makes its edge unusable.
+    void update(const AtracsysFrame& frame);
+
+    // Transform mapping coordinates in `from` into `to`; false if no usable path exists.
+    bool lookup(NodeId from, NodeId to, Transform& result);
+    bool lookup(const std::string& from, const std::string& to, Transform& result);
+
+    uint64_t getCacheHits() const { return cacheHits; }
+    uint64_t getCacheMisses() const { return cacheMisses; }
+
+private:
+    struct Edge {
+        NodeId child;
+        NodeId parent;
+        Transform transform;
+        bool tracked;
+        bool valid;
+        uint32_t geometryId;
+        uint64_t version;
+    };
+
+    struct Step {
+        uint32_t edge;
+        bool forward;
+    };
+
+    struct CacheEntry {
+        uint64_t structure = UINT64_MAX;
+        bool reachable = false;
+        std::vector<Step> path;
+        std::vector<uint64_t> versions;
+        bool composed = false;
+        bool valid = false;
+        Transform result;
+    };
+
+    uint32_t findEdge(NodeId child, NodeId parent) const;
+    uint32_t addEdge(NodeId child, NodeId parent);
+    bool findPath(NodeId from, NodeId to, std::vector<Step>& path) const;
+    bool compose(CacheEntry& entry) const;
+
+    std::unordered_map<std::string, NodeId> names;
+    std::vector<std::vector<Step>> adjacency;
+    std::vector<Edge> edges;
+    std::vector<uint32_t> trackedEdges;
+    std::unordered_map<uint64_t, CacheEntry> cache;
+    uint64_t structure = 0;
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+};
@@ -3,25 +3,188 @@
 //
 #pragma once
 
+#include <array>
+#include <future>
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
+#include <atracsyswrapper/atracsysdigitizer.h>
+#include <atracsyswrapper/atracsysframe.h>
+#include <atracsyswrapper/atracsysframeconsumer.h>
+#include <atracsyswrapper/atracsysimages.h>
+#include <atracsyswrapper/atracsysmatching.h>
 #include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsyspivot.h>
+#include <atracsyswrapper/atracsysrawdata.h>
+#include <atracsyswrapper/atracsysrealtime.h>
+#include <atracsyswrapper/atracsysstartup.h>
+#include <atracsyswrapper/atracsysstatus.h>
+#include <atracsyswrapper/atracsyssurface.h>
+
+class AtracsysRawFrame;
 
 class AtracsysWrapper {
 public:
     AtracsysWrapper() = default;;
     virtual ~AtracsysWrapper() = default;;
 
-    virtual bool init() = 0;
+    virtual AtracsysStatus init() = 0;
+
+    /** \brief init(), the given geometries and optionally startTracking() in one go.
+     *
+     * Geometry files are parsed and the frame is allocated while the device
+     * is enumerated; the report times every phase. The wrapper must not be
+     * used until the future is ready.
+     */
+    virtual std::future<AtracsysStartupReport> initAsync(const AtracsysStartupOptions& options) = 0;
+
+    virtual AtracsysStatus addGeometry(const std::string &filename, const std::string& geometryId) = 0;
+
+    // Applied by the next startTracking(); see AtracsysMatchingOptions.
+    virtual void setMatchingOptions(const AtracsysMatchingOptions& options) = 0;
+
+    /** \brief Blobs and 3D fiducials of every frame, applied by the next startTracking().
+     *
+     * getRawFrame() pins the buffer of the latest frame without copying it
+     * and may be called from any thread; include
+     * <atracsyswrapper/atracsysrawframe.h> to read it. Off by default, so the
+     * pose-only path transfers and keeps no raw data.
+     */
+    virtual void setRawDataOptions(const AtracsysRawDataOptions& options) = 0;
+    virtual bool getRawFrame(AtracsysRawFrame& frame) = 0;
 
-    virtual bool addGeometry(const std::string &filename, const std::string& geometryId) = 0;
+    /** \brief Camera images, applied by the next startTracking().
+     *
+     * The acquisition thread only trades its SDK frame buffer for a pooled
+     * one; a separate image thread copies the pixels of the latest frame
+     * into an AtracsysImagePipeline, so neither the copy nor the processing
+     * holds back pose delivery. Frames that arrive while the image thread is
+     * busy are skipped. pollImage() and waitImage() may be called from any
+     * thread.
+     */
+    virtual void setImageOptions(const AtracsysImageOptions& options) = 0;
+    virtual bool pollImage(AtracsysImage& image) = 0;
+    virtual bool waitImage(AtracsysImage& image, uint32_t timeoutMs) = 0;
+    virtual AtracsysImageStats getImageStats() const = 0;
 
-    virtual bool startTracking() = 0;
-    virtual bool stopTrackking() = 0;
+    // Fails with AcquisitionRunning while the acquisition thread runs.
+    virtual AtracsysStatus startTracking() = 0;
+    virtual AtracsysStatus stopTrackking() = 0;
 
-    virtual void getMarkerPositions() = 0;
+    virtual AtracsysStatus getMarkerPositions() = 0;
 
     static std::unique_ptr<AtracsysWrapper> New();
 
     virtual const std::map<size_t, AtracsysMarker>& getMarkers() const = 0;
+
+    // Status of the last wrapper call and how often each code was reported.
+    virtual AtracsysStatus getLastStatus() const = 0;
+    virtual uint64_t getErrorCount(AtracsysStatusCode code) const = 0;
+    virtual uint64_t getFtkErrorCount(int32_t ftkError) const = 0;
+
+    // Queries the driver for its last error string; allocates, call off the acquisition path.
+    virtual std::string getLastErrorString() const = 0;
+
+    // Acquisition counters in Prometheus text format, optionally served on http://127.0.0.1:<port>/metrics.
+    virtual std::string getMetricsText() const = 0;
+    virtual bool startMetricsServer(uint16_t port) = 0;
+    virtual void stopMetricsServer() = 0;
+
+    /** \brief Runs getMarkerPositions() in a loop on a dedicated thread.
+     *
+     * The thread uses the scheduling given to setRealtimeOptions(); memory is
+     * locked by startTracking() when requested. While it runs, frames are
+     * consumed through the publishers below, and getMarkerPositions() /
+     * getMarkers() must not be called from other threads. Publishers can
+     * only be started or stopped while the thread is not running.
+     */
+    virtual void setRealtimeOptions(const AtracsysRealtimeOptions& options) = 0;
+    virtual AtracsysStatus startAcquisition() = 0;
+    virtual void stopAcquisition() = 0;
+    virtual bool isAcquiring() const = 0;
+    virtual AtracsysJitterStats getJitterStats() const = 0;
+
+    /** \brief Pivot calibration of a tracked tool, fed by the acquisition path.
+     *
+     * Rotate the tool around its fixed tip while the calibration runs.
+     * applyPivotCalibration() stores the solved tip as the tip offset of the
+     * geometry and writes it back to the [pivot] section of the geometry file.
+     */
+    virtual AtracsysStatus startPivotCalibration(uint32_t geometryId, float rejectionFactor = 3.f) = 0;
+    virtual void stopPivotCalibration() = 0;
+    virtual bool getPivotCalibration(AtracsysPivotCalibration& calibration) const = 0;
+    virtual AtracsysStatus applyPivotCalibration() = 0;
+
+    /** \brief Tool tips published with every pose, see AtracsysPose.
+     *
+     * Offsets come from the [pivot] section of the geometry or are set here,
+     * in marker coordinates; they can be changed while tracking. Tips are
+     * also expressed in the reference geometry when one is set.
+     */
+    virtual AtracsysStatus setTipOffset(uint32_t geometryId, const std::array<float, 3>& tipMM) = 0;
+    virtual AtracsysStatus clearTipOffset(uint32_t geometryId) = 0;
+    virtual bool getTipOffset(uint32_t geometryId, std::array<float, 3>& tipMM) const = 0;
+    virtual void setReferenceGeometry(uint32_t geometryId) = 0;
+
+    /** \brief Automatic landmark digitizing, see AtracsysDigitizerOptions.
+     *
+     * Every started pointer yields a point each time it is held still;
+     * pollDigitizedPoint() hands them out in order and is meant for a single
+     * consumer thread.
+     */
+    virtual AtracsysStatus startDigitizing(uint32_t geometryId,
+                                           const AtracsysDigitizerOptions& options = AtracsysDigitizerOptions()) = 0;
+    virtual void stopDigitizing(uint32_t geometryId) = 0;
+    virtual bool pollDigitizedPoint(AtracsysDigitizedPoint& point) = 0;
+
+    /** \brief Surface sweep with a pointer, see AtracsysSurfaceOptions.
+     *
+     * Starting again discards the previous surface. getSurfacePoints()
+     * appends one point per voxel, ready for surface registration.
+     */
+    virtual AtracsysStatus startSurfaceAcquisition(uint32_t geometryId,
+                                                   const AtracsysSurfaceOptions& options = AtracsysSurfaceOptions()) = 0;
+    virtual void stopSurfaceAcquisition() = 0;
+    virtual void clearSurface() = 0;
+    virtual size_t getSurfacePoints(std::vector<std::array<float, 3>>& points) = 0;
+    virtual AtracsysSurfaceStats getSurfaceStats() = 0;
+
+    /** \brief Past poses per geometry, indexed by device timestamp.
+     *
+     * Geometries added after setPoseHistoryCapacity() keep the last `samples`
+     * poses (0 or 1 disables the history). poseAt() interpolates between the
+     * two neighbouring samples and is lock-free, so it can be called from any
+     * thread while the acquisition thread runs.
+     */
+    virtual void setPoseHistoryCapacity(uint32_t samples) = 0;
+    virtual bool poseAt(uint32_t geometryId, uint64_t timestampUS, AtracsysPose& pose) const = 0;
+    virtual bool getPoseHistoryRange(uint32_t geometryId, uint64_t& oldestUS, uint64_t& newestUS) const = 0;
+
+    /** \brief Clock of the pose history queries.
+     *
+     * Once an offset is set, poseAt() and getPoseHistoryRange() take and
+     * return timestamps of the external stream: the offset (see
+     * AtracsysTemporalCalibration) is added before looking up the history.
+     */
+    virtual void setTimeOffset(int64_t offsetUS) = 0;
+    virtual int64_t getTimeOffset() const = 0;
+
+    // Waits on frames from any thread; may be created while the acquisition thread runs.
+    virtual std::unique_ptr<AtracsysFrameConsumer> createConsumer(
+            AtracsysWaitStrategy strategy = AtracsysWaitStrategy::Block, uint32_t spinIterations = 20000) = 0;
+
+    // Same, but only woken at `rateHz`; nullptr when all rate slots are in use.
+    virtual std::unique_ptr<AtracsysFrameConsumer> createRateConsumer(
+            double rateHz, AtracsysRateMode mode = AtracsysRateMode::Decimate,
+            AtracsysWaitStrategy strategy = AtracsysWaitStrategy::Block, uint32_t spinIterations = 20000) = 0;
+
+    // Publishes every frame into the POSIX shared-memory ring `name`, see AtracsysSharedPoseReader;
+    // fails while another running process publishes under the same name.
+    virtual bool startSharedMemoryPublisher(const std::string& name, uint32_t capacity = 1024) = 0;
+    virtual void stopSharedMemoryPublisher() = 0;
+
+    // Sends one compact datagram per frame to `group`:`port`, see AtracsysPoseReceiver.
+    virtual bool startPoseMulticast(const std::string& group, uint16_t port, uint8_t ttl = 1) = 0;
+    virtual void stopPoseMulticast() = 0;
 };
@@ -0,0 +1,183 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "acquisitionmetrics.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+void appendSample(std::string& out, const char* name, const std::string& labels, double value) {
+    char number[32];
+    snprintf(number, sizeof(number), "%.17g", value);
+    out += name;
+    out += '{';
+    out += labels;
+    out += "} ";
+    out += number;
+    out += '\n';
+}
+
+void appendSample(std::string& out, const char* name, const std::string& labels, uint64_t value) {
+    char number[32];
+    snprintf(number, sizeof(number), "%" PRIu64, value);
+    out += name;
+    out += '{';
+    out += labels;
+    out += "} ";
+    out += number;
+    out += '\n';
+}
+
+// Label values escape backslash, double quote and line feed.
+void appendLabel(std::string& out, const char* name, const std::string& value) {
+    out += ',';
+    out += name;
+    out += "=\"";
+    for (char c : value) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                out += c;
+        }
+    }
+    out += '"';
+}
+
+}
+
+AcquisitionMetrics::AcquisitionMetrics() = default;
+
+void AcquisitionMetrics::setSerialNumber(uint64_t serialNumber) {
+    this->serialNumber.store(serialNumber, std::memory_order_relaxed);
+}
+
+size_t AcquisitionMetrics::registerGeometry(uint32_t geometryId, const std::string& name) {
+    size_t slot = findGeometry(geometryId);
+    if (slot < MAX_GEOMETRIES) {
+        return slot;
+    }
+
+    for (slot = 0; slot < MAX_GEOMETRIES; ++slot) {
+        GeometrySlot& geometry = geometries[slot];
+        if (!geometry.used.load(std::memory_order_acquire)) {
+            geometry.geometryId = geometryId;
+            geometry.name = name;
+            geometry.used.store(true, std::memory_order_release);
+            return slot;
+        }
+    }
+    return MAX_GEOMETRIES;
+}
+
+size_t AcquisitionMetrics::findGeometry(uint32_t geometryId) const {
+    for (size_t slot = 0; slot < MAX_GEOMETRIES; ++slot) {
+        const GeometrySlot& geometry = geometries[slot];
+        if (!geometry.used.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (geometry.geometryId == geometryId) {
+            return slot;
+        }
+    }
+    return MAX_GEOMETRIES;
+}
+
+std::string AcquisitionMetrics::toPrometheus(const ErrorCounters& errors) const {
+    std::string out;
+    out.reserve(4096);
+
+    char serial[32];
+    snprintf(serial, sizeof(serial), "serial=\"0x%016" PRIx64 "\"", serialNumber.load(std::memory_order_relaxed));
+    const std::string device = serial;
+
+    const uint64_t acquired = framesAcquired.load(std::memory_order_relaxed);
+
+    appendHeader(out, "atracsys_frames_acquired_total", "counter", "Frames returned by ftkGetLastFrame.");
+    appendSample(out, "atracsys_frames_acquired_total", device, acquired);
+    appendHeader(out, "atracsys_frames_without_markers_total", "counter", "Frames without any marker.");
+    appendSample(out, "atracsys_frames_without_markers_total", device,
+                 framesWithoutMarkers.load(std::memory_order_relaxed));
+    appendHeader(out, "atracsys_marker_overflows_total", "counter", "Frames flagged QS_ERR_OVERFLOW.");
+    appendSample(out, "atracsys_marker_overflows_total", device,
+                 markerOverflows.load(std::memory_order_relaxed));
+    appendHeader(out, "atracsys_frame_timeouts_total", "counter", "Failed ftkGetLastFrame calls.");
+    appendSample(out, "atracsys_frame_timeouts_total", device,
+                 frameTimeouts.load(std::memory_order_relaxed));
+
+    const AtracsysJitterStats stats = jitter.snapshot();
+    appendHeader(out, "atracsys_frame_period_us", "gauge", "Running mean of the host frame interval.");
+    appendSample(out, "atracsys_frame_period_us", device, stats.periodUS);
+    appendHeader(out, "atracsys_frame_jitter_us", "gauge", "Deviation of the frame interval from the mean.");
+    for (const auto& sample : { std::make_pair("mean", stats.meanUS), std::make_pair("p99", stats.p99US),
+                                std::make_pair("max", stats.maxUS) }) {
+        std::string labels = device;
+        appendLabel(labels, "stat", sample.first);
+        appendSample(out, "atracsys_frame_jitter_us", labels, sample.second);
+    }
+
+    appendHeader(out, "atracsys_status_total", "counter", "Wrapper calls by returned status.");
+    for (size_t code = 0; code < static_cast<size_t>(AtracsysStatusCode::Count); ++code) {
+        std::string labels = device;
+        appendLabel(labels, "status", toString(static_cast<AtracsysStatusCode>(code)));
+        appendSample(out, "atracsys_status_total", labels,
+                     errors.getCount(static_cast<AtracsysStatusCode>(code)));
+    }
+
+    std::string labels[MAX_GEOMETRIES];
+    size_t count = 0;
+    for (; count < MAX_GEOMETRIES && geometries[count].used.load(std::memory_order_acquire); ++count) {
+        labels[count] = device;
+        appendLabel(labels[count], "geometry", std::to_string(geometries[count].geometryId));
+        appendLabel(labels[count], "name", geometries[count].name);
+    }
+
+    appendHeader(out, "atracsys_marker_visible_frames_total", "counter", "Frames in which the geometry was tracked.");
+    for (size_t slot = 0; slot < count; ++slot) {
+        appendSample(out, "atracsys_marker_visible_frames_total", labels[slot],
+                     markers[slot].visibleFrames.load(std::memory_order_relaxed));
+    }
+    appendHeader(out, "atracsys_marker_visibility_ratio", "gauge", "Visible frames over acquired frames.");
+    for (size_t slot = 0; slot < count; ++slot) {
+        const uint64_t visible = markers[slot].visibleFrames.load(std::memory_order_relaxed);
+        appendSample(out, "atracsys_marker_visibility_ratio", labels[slot],
+                     acquired > 0 ? double(visible) / double(acquired) : 0.0);
+    }
+    appendHeader(out, "atracsys_marker_registration_error_mean_mm", "gauge", "Mean registration error.");
+    for (size_t slot = 0; slot < count; ++slot) {
+        const uint64_t visible = markers[slot].visibleFrames.load(std::memory_order_relaxed);
+        const double sum = markers[slot].registrationErrorSum.load(std::memory_order_relaxed);
+        appendSample(out, "atracsys_marker_registration_error_mean_mm", labels[slot],
+                     visible > 0 ? sum / double(visible) : 0.0);
+    }
+    appendHeader(out, "atracsys_marker_registration_error_mm", "gauge", "Last registration error.");
+    for (size_t slot = 0; slot < count; ++slot) {
+        appendSample(out, "atracsys_marker_registration_error_mm", labels[slot],
+                     markers[slot].registrationErrorLast.load(std::memory_order_relaxed));
+    }
+
+    return out;
+}
@@ -0,0 +1,87 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "errorcounters.h"
+#include "jitterstats.h"
+#include "markermatcher.h"
+
+/** \brief Acquisition health counters.
+ *
+ * Written by the acquisition path only, read by the metrics endpoint. All
+ * updates are relaxed atomic stores on preallocated slots, so they are cheap
+ * enough to stay enabled at full frame rate. Geometries must be registered
+ * before tracking starts.
+ */
+class AcquisitionMetrics {
+public:
+    static const size_t MAX_GEOMETRIES = MarkerMatcher::MAX_GEOMETRIES;
+
+    struct MarkerCounters {
+        std::atomic<uint64_t> visibleFrames{0};
+        std::atomic<double> registrationErrorSum{0.0};
+        std::atomic<double> registrationErrorLast{0.0};
+    };
+
+    AcquisitionMetrics();
+
+    void setSerialNumber(uint64_t serialNumber);
+
+    // Returns the slot index of the geometry, or MAX_GEOMETRIES when full.
+    size_t registerGeometry(uint32_t geometryId, const std::string& name);
+    size_t findGeometry(uint32_t geometryId) const;
+
+    void frameAcquired() { increment(framesAcquired); }
+    void frameWithoutMarkers() { increment(framesWithoutMarkers); }
+    void markerOverflow() { increment(markerOverflows); }
+    void frameTimeout() {
+        increment(frameTimeouts);
+        jitter.frameMissed();
+    }
+    void frameArrived(uint64_t nowUS) { jitter.frameArrived(nowUS); }
+    AtracsysJitterStats getJitter() const { return jitter.snapshot(); }
+
+    void markerSeen(size_t slot, float registrationErrorMM) {
+        if (slot >= MAX_GEOMETRIES) {
+            return;
+        }
+        MarkerCounters& counters = markers[slot];
+        increment(counters.visibleFrames);
+        // Single writer: a load/store pair is enough and stays lock-free.
+        counters.registrationErrorSum.store(
+                counters.registrationErrorSum.load(std::memory_order_relaxed) + registrationErrorMM,
+                std::memory_order_relaxed);
+        counters.registrationErrorLast.store(registrationErrorMM, std::memory_order_relaxed);
+    }
+
+    // Prometheus text exposition format (version 0.0.4).
+    std::string toPrometheus(const ErrorCounters& errors) const;
+
+private:
+    struct GeometrySlot {
+        std::atomic<bool> used{false};
+        uint32_t geometryId = 0;
+        // Written once before `used` is set, then only read.
+        std::string name;
+    };
+
+    static void increment(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> serialNumber{0};
+    std::atomic<uint64_t> framesAcquired{0};
+    std::atomic<uint64_t> framesWithoutMarkers{0};
+    std::atomic<uint64_t> markerOverflows{0};
+    std::atomic<uint64_t> frameTimeouts{0};
+    JitterStats jitter;
+
+    std::array<GeometrySlot, MAX_GEOMETRIES> geometries;
+    std::array<MarkerCounters, MAX_GEOMETRIES> markers;
+};
@@ -5,33 +5,104 @@
 #include "atracsysdevice.h"
 #include "helpers.hpp"
 
-static const unsigned ENABLE_ONBOARD_PROCESSING_OPTION = 6000;
-static const unsigned SENDING_IMAGES_OPTION = 6003;
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const int MAX_OPTION_ATTEMPTS = 3;
+const std::chrono::milliseconds OPTION_RETRY_DELAY(10);
+
+}
 
 
 AtracsysDevice::AtracsysDevice(ftkLibrary library)
         : library(library) {
-    DeviceData device( retrieveLastDevice( library ) );
-    type = device.Type;
-    serialNumber = device.SerialNumber;
 }
 
 AtracsysDevice::~AtracsysDevice() = default;
 
 
-void AtracsysDevice::setOnboardProcessing(bool enable) {
-    if ( ftkSetInt32( library, serialNumber, ENABLE_ONBOARD_PROCESSING_OPTION, 1 ) != FTK_OK )
-    {
-        //error( "Cannot process data directly on the SpryTrack." );
+AtracsysStatus AtracsysDevice::stageOption(DeviceOption option, int32 value) {
+    const DeviceOptionInfo& info = getDeviceOptionInfo(option);
+    if (value < info.minimum || value > info.maximum) {
+        return AtracsysStatus(AtracsysStatusCode::OptionFailed);
     }
+    OptionState& state = options[size_t(option)];
+    state.pending = !state.known || state.value != value;
+    state.staged = value;
+    return AtracsysStatus();
+}
 
+AtracsysStatus AtracsysDevice::applyOptions() {
+    // Every queued option is attempted; the first failure is reported.
+    AtracsysStatus result;
+    for (size_t i = 0; i < options.size(); ++i) {
+        OptionState& state = options[i];
+        if (!state.pending) {
+            continue;
+        }
+        state.pending = false;
+        const AtracsysStatus status = writeOption(DeviceOption(i), state.staged);
+        if (!status && result) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+AtracsysStatus AtracsysDevice::setOption(DeviceOption option, int32 value) {
+    const AtracsysStatus status = stageOption(option, value);
+    if (!status) {
+        return status;
+    }
+    return applyOptions();
 }
 
-void AtracsysDevice::setSendingImages(bool enable) {
-    if ( ftkSetInt32( library, serialNumber, SENDING_IMAGES_OPTION, 0 ) != FTK_OK )
-    {
-        //error( "Cannot disable images sending on the SpryTrack." );
+bool AtracsysDevice::getOption(DeviceOption option, int32& value) const {
+    const OptionState& state = options[size_t(option)];
+    if (!state.known) {
+        return false;
     }
+    value = state.value;
+    return true;
+}
+
+AtracsysStatus AtracsysDevice::setOnboardProcessing(bool enable) {
+    return setOption(DeviceOption::OnboardProcessing, enable ? 1 : 0);
+}
+
+AtracsysStatus AtracsysDevice::setSendingImages(bool enable) {
+    return setOption(DeviceOption::SendingImages, enable ? 1 : 0);
+}
+
+AtracsysStatus AtracsysDevice::writeOption(DeviceOption option, int32 value) {
+    const uint32 id = getDeviceOptionInfo(option).id;
+    OptionState& state = options[size_t(option)];
+    // Whatever the device holds after a failed write is unknown.
+    state.known = false;
+
+    ftkError err = FTK_OK;
+    for (int attempt = 0; attempt < MAX_OPTION_ATTEMPTS; ++attempt) {
+        if (attempt > 0) {
+            std::this_thread::sleep_for(OPTION_RETRY_DELAY * attempt);
+        }
+        err = ftkSetInt32( library, serialNumber, id, value );
+        if ( err != FTK_OK ) {
+            continue;
+        }
+        int32 readBack = 0;
+        err = ftkGetInt32( library, serialNumber, id, &readBack, FTK_VALUE );
+        if ( err != FTK_OK ) {
+            continue;
+        }
+        if (readBack == value) {
+            state.value = value;
+            state.known = true;
+            return AtracsysStatus();
+        }
+    }
+    return AtracsysStatus(AtracsysStatusCode::OptionFailed, err);
 }
 
 ftkDeviceType AtracsysDevice::getType() const {
@@ -42,6 +113,28 @@ uint64 AtracsysDevice::getSerialNumber() const {
     return serialNumber;
 }
 
-void AtracsysDevice::init() {
+AtracsysStatus AtracsysDevice::init() {
+    DeviceData device{};
+    ftkError err = enumerateLastDevice(library, device, allowSimulator);
+    if (err > FTK_OK) {
+        return AtracsysStatus(AtracsysStatusCode::NoDevice, err);
+    }
+    if (device.SerialNumber == 0uLL) {
+        return AtracsysStatus(AtracsysStatusCode::NoDevice, err);
+    }
+
+    switch (device.Type) {
+        case DEV_SPRYTRACK_180:
+        case DEV_FUSIONTRACK_500:
+        case DEV_FUSIONTRACK_250:
+        case DEV_SIMULATOR:
+            break;
+        default:
+            return AtracsysStatus(AtracsysStatusCode::UnknownDevice);
+    }
 
+    type = device.Type;
+    serialNumber = device.SerialNumber;
+    options.fill(OptionState());
+    return AtracsysStatus();
 }
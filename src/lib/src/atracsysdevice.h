@@ -7,17 +7,28 @@
 
 #include <ftkTypes.h>
 #include <ftkInterface.h>
+#include <array>
 #include <memory>
+#include <atracsyswrapper/atracsysstatus.h>
+#include "deviceoptions.h"
 
 class AtracsysDevice {
 public:
     explicit AtracsysDevice(const ftkLibrary library);
     virtual ~AtracsysDevice();
 
-    void init();
+    AtracsysStatus init();
 
-    void setOnboardProcessing(bool enable);
-    void setSendingImages(bool enable);
+    // Queues a value for applyOptions(); values equal to the cached one are dropped.
+    AtracsysStatus stageOption(DeviceOption option, int32 value);
+    // Writes every queued value, reads it back and retries failed or mismatching writes.
+    AtracsysStatus applyOptions();
+    AtracsysStatus setOption(DeviceOption option, int32 value);
+    // Last value written and verified since init(), without a device round trip.
+    bool getOption(DeviceOption option, int32& value) const;
+
+    AtracsysStatus setOnboardProcessing(bool enable);
+    AtracsysStatus setSendingImages(bool enable);
 
     ftkDeviceType getType() const;
 
@@ -25,9 +36,19 @@ public:
 
 private:
     ftkLibrary library;
-    uint64 serialNumber;
-    ftkDeviceType type;
+    uint64 serialNumber = 0uLL;
+    ftkDeviceType type = DEV_UNKNOWN_DEVICE;
     bool allowSimulator = true;
+
+    struct OptionState {
+        int32 value = 0;
+        int32 staged = 0;
+        bool known = false;
+        bool pending = false;
+    };
+    std::array<OptionState, size_t(DeviceOption::Count)> options{};
+
+    AtracsysStatus writeOption(DeviceOption option, int32 value);
 };
 
 
@@ -0,0 +1,454 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsyshandeye.h"
+#include "linearsolve.h"
+#include "symmetriceigen.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const size_t PAIRS_PER_TASK = 64;
+// Pair selection tasks per pool thread, enough for rows of uneven length to balance.
+const size_t SELECTION_TASKS_PER_THREAD = 4;
+// Smallest over largest spread of the rotation axes; below this the axes are (nearly) parallel.
+const double MIN_AXIS_SPREAD = 1e-3;
+const double JACOBIAN_STEP = 1e-6;
+
+struct Rigid {
+    double r[3][3];
+    double t[3];
+};
+
+struct Motion {
+    Rigid a;
+    Rigid b;
+    double rodriguesA[3];
+    double rodriguesB[3];
+    double axisA[3];
+    double angle;
+};
+
+Rigid fromTransform(const AtracsysMarker::Transform& transform) {
+    Rigid result;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result.r[row][column] = transform[row][column];
+        }
+        result.t[row] = transform[row][3];
+    }
+    return result;
+}
+
+Rigid multiply(const Rigid& x, const Rigid& y) {
+    Rigid result;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result.r[row][column] = x.r[row][0] * y.r[0][column] + x.r[row][1] * y.r[1][column] + x.r[row][2] * y.r[2][column];
+        }
+        result.t[row] = x.r[row][0] * y.t[0] + x.r[row][1] * y.t[1] + x.r[row][2] * y.t[2] + x.t[row];
+    }
+    return result;
+}
+
+Rigid inverse(const Rigid& x) {
+    Rigid result;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result.r[row][column] = x.r[column][row];
+        }
+    }
+    for (int row = 0; row < 3; ++row) {
+        result.t[row] = -(result.r[row][0] * x.t[0] + result.r[row][1] * x.t[1] + result.r[row][2] * x.t[2]);
+    }
+    return result;
+}
+
+// Unit quaternion (w >= 0) of a rotation matrix, Shepperd's method.
+void quaternion(const double r[3][3], double q[4]) {
+    const double trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0.0) {
+        const double s = std::sqrt(trace + 1.0) * 2.0;
+        q[0] = 0.25 * s;
+        q[1] = (r[2][1] - r[1][2]) / s;
+        q[2] = (r[0][2] - r[2][0]) / s;
+        q[3] = (r[1][0] - r[0][1]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        const double s = std::sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]) * 2.0;
+        q[0] = (r[2][1] - r[1][2]) / s;
+        q[1] = 0.25 * s;
+        q[2] = (r[0][1] + r[1][0]) / s;
+        q[3] = (r[0][2] + r[2][0]) / s;
+    }
+    else if (r[1][1] > r[2][2]) {
+        const double s = std::sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]) * 2.0;
+        q[0] = (r[0][2] - r[2][0]) / s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = 0.25 * s;
+        q[3] = (r[1][2] + r[2][1]) / s;
+    }
+    else {
+        const double s = std::sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]) * 2.0;
+        q[0] = (r[1][0] - r[0][1]) / s;
+        q[1] = (r[0][2] + r[2][0]) / s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+        q[3] = 0.25 * s;
+    }
+    const double sign = q[0] < 0.0 ? -1.0 : 1.0;
+    const double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int k = 0; k < 4; ++k) {
+        q[k] *= sign / norm;
+    }
+}
+
+// Rotation by angle |v| around v.
+void exponential(const double v[3], double r[3][3]) {
+    const double angle = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    const double k[3] = { angle > 0.0 ? v[0] / angle : 1.0, angle > 0.0 ? v[1] / angle : 0.0, angle > 0.0 ? v[2] / angle : 0.0 };
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double skew[3][3] = { { 0.0, -k[2], k[1] }, { k[2], 0.0, -k[0] }, { -k[1], k[0], 0.0 } };
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            r[row][column] = (row == column ? c : 0.0) + s * skew[row][column] + (1.0 - c) * k[row] * k[column];
+        }
+    }
+}
+
+// Six residuals of AX = XB: rotation mismatch (scaled to mm), then translation mismatch.
+void residuals(const Motion& motion, const Rigid& x, double rotationScale, double out[6]) {
+    const Rigid ax = multiply(motion.a, x);
+    const Rigid xb = multiply(x, motion.b);
+    // Skew part of (AX)(XB)^T is sin(angle) * axis of the remaining rotation.
+    double e[3][3];
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            e[row][column] = ax.r[row][0] * xb.r[column][0] + ax.r[row][1] * xb.r[column][1] + ax.r[row][2] * xb.r[column][2];
+        }
+    }
+    out[0] = 0.5 * (e[2][1] - e[1][2]) * rotationScale;
+    out[1] = 0.5 * (e[0][2] - e[2][0]) * rotationScale;
+    out[2] = 0.5 * (e[1][0] - e[0][1]) * rotationScale;
+    for (int k = 0; k < 3; ++k) {
+        out[3 + k] = ax.t[k] - xb.t[k];
+    }
+}
+
+// X * exp(delta[0..2]) with translation offset delta[3..5].
+Rigid perturb(const Rigid& x, const double delta[6]) {
+    Rigid step;
+    exponential(delta, step.r);
+    step.t[0] = step.t[1] = step.t[2] = 0.0;
+    Rigid result = multiply(x, step);
+    for (int k = 0; k < 3; ++k) {
+        result.t[k] = x.t[k] + delta[3 + k];
+    }
+    return result;
+}
+
+struct NormalEquations {
+    double jtj[6][6] = {};
+    double jtr[6] = {};
+    double cost = 0.0;
+};
+
+bool tsaiLenz(const std::vector<Motion>& motions, Rigid& x) {
+    // Rotation: skew(Pa + Pb) * P' = Pb - Pa over all pairs, with P the modified Rodrigues vectors.
+    double m[3][3] = {};
+    double v[3] = {};
+    for (const Motion& motion : motions) {
+        const double s[3] = { motion.rodriguesA[0] + motion.rodriguesB[0],
+                              motion.rodriguesA[1] + motion.rodriguesB[1],
+                              motion.rodriguesA[2] + motion.rodriguesB[2] };
+        const double skew[3][3] = { { 0.0, -s[2], s[1] }, { s[2], 0.0, -s[0] }, { -s[1], s[0], 0.0 } };
+        const double d[3] = { motion.rodriguesB[0] - motion.rodriguesA[0],
+                              motion.rodriguesB[1] - motion.rodriguesA[1],
+                              motion.rodriguesB[2] - motion.rodriguesA[2] };
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                for (int k = 0; k < 3; ++k) {
+                    m[row][column] += skew[k][row] * skew[k][column];
+                }
+            }
+            for (int k = 0; k < 3; ++k) {
+                v[row] += skew[k][row] * d[k];
+            }
+        }
+    }
+    double prime[3];
+    if (!solveLinear<3>(m, v, prime)) {
+        return false;
+    }
+    const double primeSquared = prime[0] * prime[0] + prime[1] * prime[1] + prime[2] * prime[2];
+    double p[3];
+    for (int k = 0; k < 3; ++k) {
+        p[k] = 2.0 * prime[k] / std::sqrt(1.0 + primeSquared);
+    }
+    const double pSquared = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+    const double root = std::sqrt(std::max(0.0, 4.0 - pSquared));
+    const double skewP[3][3] = { { 0.0, -p[2], p[1] }, { p[2], 0.0, -p[0] }, { -p[1], p[0], 0.0 } };
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            x.r[row][column] = (row == column ? 1.0 - 0.5 * pSquared : 0.0) +
+                               0.5 * (p[row] * p[column] + root * skewP[row][column]);
+        }
+    }
+
+    // Translation: (Ra - I) * t = R * tb - ta.
+    double n[3][3] = {};
+    double w[3] = {};
+    for (const Motion& motion : motions) {
+        double c[3][3];
+        double d[3];
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                c[row][column] = motion.a.r[row][column] - (row == column ? 1.0 : 0.0);
+            }
+            d[row] = x.r[row][0] * motion.b.t[0] + x.r[row][1] * motion.b.t[1] + x.r[row][2] * motion.b.t[2] - motion.a.t[row];
+        }
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                for (int k = 0; k < 3; ++k) {
+                    n[row][column] += c[k][row] * c[k][column];
+                }
+            }
+            for (int k = 0; k < 3; ++k) {
+                w[row] += c[k][row] * d[k];
+            }
+        }
+    }
+    return solveLinear<3>(n, w, x.t);
+}
+
+}
+
+AtracsysHandEyeCalibration::AtracsysHandEyeCalibration(size_t threads)
+        : pool(new ThreadPool(threads)) {
+}
+
+AtracsysHandEyeCalibration::~AtracsysHandEyeCalibration() = default;
+
+void AtracsysHandEyeCalibration::addStation(const Transform& markerPose, const Transform& sensorPose) {
+    stations.push_back({ markerPose, sensorPose });
+}
+
+AtracsysStatus AtracsysHandEyeCalibration::solve(const AtracsysHandEyeOptions& options, AtracsysHandEyeResult& result) const {
+    result = AtracsysHandEyeResult();
+
+    const double minAngle = options.minRotationDeg * PI / 180.0;
+    const double maxAngleMismatch = options.maxAngleMismatchDeg * PI / 180.0;
+    const double rotationScale = options.rotationScaleMM;
+
+    std::vector<Rigid> markers(stations.size());
+    std::vector<Rigid> sensors(stations.size());
+    std::vector<Rigid> markerInverses(stations.size());
+    std::vector<Rigid> sensorInverses(stations.size());
+    for (size_t i = 0; i < stations.size(); ++i) {
+        markers[i] = fromTransform(stations[i].marker);
+        sensors[i] = fromTransform(stations[i].sensor);
+        markerInverses[i] = inverse(markers[i]);
+        sensorInverses[i] = inverse(sensors[i]);
+    }
+
+    // Score all station pairs (i, j > i). Each task keeps only its maxPairs
+    // largest rotations in a min-heap, so memory is bounded by
+    // selectionTasks * maxPairs instead of growing with the square of the
+    // station count.
+    const auto largerAngle = [](const Motion& a, const Motion& b) { return a.angle > b.angle; };
+    const size_t selectionTasks = std::min(stations.size(), pool->getThreadCount() * SELECTION_TASKS_PER_THREAD);
+    std::vector<std::vector<Motion>> kept(selectionTasks);
+    std::vector<size_t> candidates(selectionTasks, 0);
+    pool->parallelFor(selectionTasks, [&](size_t task) {
+        std::vector<Motion>& heap = kept[task];
+        // Rows get shorter with i, so they are dealt out in turn.
+        for (size_t i = task; i < stations.size(); i += selectionTasks) {
+            for (size_t j = i + 1; j < stations.size(); ++j) {
+                Motion motion;
+                motion.a = multiply(markerInverses[j], markers[i]);
+                motion.b = multiply(sensors[j], sensorInverses[i]);
+
+                double qa[4];
+                double qb[4];
+                quaternion(motion.a.r, qa);
+                quaternion(motion.b.r, qb);
+                const double sineA = std::sqrt(qa[1] * qa[1] + qa[2] * qa[2] + qa[3] * qa[3]);
+                const double sineB = std::sqrt(qb[1] * qb[1] + qb[2] * qb[2] + qb[3] * qb[3]);
+                const double angleA = 2.0 * std::atan2(sineA, qa[0]);
+                const double angleB = 2.0 * std::atan2(sineB, qb[0]);
+                if (angleA < minAngle || angleB < minAngle || std::fabs(angleA - angleB) > maxAngleMismatch) {
+                    continue;
+                }
+
+                double screwA = 0.0;
+                double screwB = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                    motion.axisA[k] = qa[1 + k] / sineA;
+                    motion.rodriguesA[k] = 2.0 * qa[1 + k];
+                    motion.rodriguesB[k] = 2.0 * qb[1 + k];
+                    screwA += motion.axisA[k] * motion.a.t[k];
+                    screwB += qb[1 + k] / sineB * motion.b.t[k];
+                }
+                if (std::fabs(screwA - screwB) > options.maxScrewMismatchMM) {
+                    continue;
+                }
+                motion.angle = 0.5 * (angleA + angleB);
+                ++candidates[task];
+
+                if (options.maxPairs == 0) {
+                    heap.push_back(motion);
+                }
+                else if (heap.size() < options.maxPairs) {
+                    heap.push_back(motion);
+                    std::push_heap(heap.begin(), heap.end(), largerAngle);
+                }
+                else if (motion.angle > heap.front().angle) {
+                    std::pop_heap(heap.begin(), heap.end(), largerAngle);
+                    heap.back() = motion;
+                    std::push_heap(heap.begin(), heap.end(), largerAngle);
+                }
+            }
+        }
+    });
+
+    std::vector<Motion> motions;
+    for (size_t task = 0; task < selectionTasks; ++task) {
+        result.candidatePairs += candidates[task];
+        motions.insert(motions.end(), kept[task].begin(), kept[task].end());
+    }
+    if (options.maxPairs > 0 && motions.size() > options.maxPairs) {
+        std::nth_element(motions.begin(), motions.begin() + options.maxPairs, motions.end(), largerAngle);
+        motions.resize(options.maxPairs);
+    }
+    result.usedPairs = motions.size();
+
+    // Parallel rotation axes leave the rotation about them undetermined.
+    double spread[3][3] = {};
+    for (const Motion& motion : motions) {
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                spread[row][column] += motion.axisA[row] * motion.axisA[column];
+            }
+        }
+    }
+    double spreadValues[3];
+    double spreadAxes[3][3];
+    symmetricEigen<3>(spread, spreadValues, spreadAxes);
+    std::sort(spreadValues, spreadValues + 3);
+    Rigid x;
+    if (motions.size() < 2 || spreadValues[1] < MIN_AXIS_SPREAD * spreadValues[2] || !tsaiLenz(motions, x)) {
+        return AtracsysStatus(AtracsysStatusCode::CalibrationNotSolved);
+    }
+
+    // Levenberg-Marquardt on X, normal equations accumulated in parallel chunks.
+    const size_t tasks = (motions.size() + PAIRS_PER_TASK - 1) / PAIRS_PER_TASK;
+    std::vector<NormalEquations> partial(tasks);
+    auto accumulate = [&](const Rigid& estimate, bool withJacobian) {
+        pool->parallelFor(tasks, [&](size_t task) {
+            NormalEquations& sum = partial[task];
+            sum = NormalEquations();
+            const size_t last = std::min(motions.size(), (task + 1) * PAIRS_PER_TASK);
+            for (size_t m = task * PAIRS_PER_TASK; m < last; ++m) {
+                double r[6];
+                residuals(motions[m], estimate, rotationScale, r);
+                for (int k = 0; k < 6; ++k) {
+                    sum.cost += r[k] * r[k];
+                }
+                if (!withJacobian) {
+                    continue;
+                }
+                double jacobian[6][6];
+                for (int p = 0; p < 6; ++p) {
+                    double delta[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+                    delta[p] = JACOBIAN_STEP;
+                    double shifted[6];
+                    residuals(motions[m], perturb(estimate, delta), rotationScale, shifted);
+                    for (int k = 0; k < 6; ++k) {
+                        jacobian[k][p] = (shifted[k] - r[k]) / JACOBIAN_STEP;
+                    }
+                }
+                for (int p = 0; p < 6; ++p) {
+                    for (int q = 0; q < 6; ++q) {
+                        for (int k = 0; k < 6; ++k) {
+                            sum.jtj[p][q] += jacobian[k][p] * jacobian[k][q];
+                        }
+                    }
+                    for (int k = 0; k < 6; ++k) {
+                        sum.jtr[p] += jacobian[k][p] * r[k];
+                    }
+                }
+            }
+        });
+        NormalEquations total;
+        for (const NormalEquations& sum : partial) {
+            total.cost += sum.cost;
+            for (int p = 0; p < 6; ++p) {
+                total.jtr[p] += sum.jtr[p];
+                for (int q = 0; q < 6; ++q) {
+                    total.jtj[p][q] += sum.jtj[p][q];
+                }
+            }
+        }
+        return total;
+    };
+
+    double lambda = 1e-3;
+    NormalEquations current = accumulate(x, true);
+    for (uint32_t iteration = 0; iteration < options.refineIterations; ++iteration) {
+        double m[6][6];
+        double b[6];
+        for (int p = 0; p < 6; ++p) {
+            for (int q = 0; q < 6; ++q) {
+                m[p][q] = current.jtj[p][q] * (p == q ? 1.0 + lambda : 1.0);
+            }
+            b[p] = -current.jtr[p];
+        }
+        double delta[6];
+        if (!solveLinear<6>(m, b, delta)) {
+            break;
+        }
+        const Rigid candidate = perturb(x, delta);
+        const NormalEquations next = accumulate(candidate, false);
+        if (next.cost < current.cost) {
+            x = candidate;
+            lambda = std::max(lambda * 0.1, 1e-12);
+            const double improvement = current.cost - next.cost;
+            current = accumulate(x, true);
+            if (improvement <= 1e-12 * current.cost) {
+                break;
+            }
+        }
+        else {
+            lambda *= 10.0;
+            if (lambda > 1e8) {
+                break;
+            }
+        }
+    }
+
+    double rotationSum = 0.0;
+    double translationSum = 0.0;
+    for (const Motion& motion : motions) {
+        double r[6];
+        residuals(motion, x, 1.0, r);
+        const double sine = std::min(1.0, std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]));
+        rotationSum += std::asin(sine) * std::asin(sine);
+        translationSum += r[3] * r[3] + r[4] * r[4] + r[5] * r[5];
+    }
+    result.rotationRmsDeg = float(std::sqrt(rotationSum / double(motions.size())) * 180.0 / PI);
+    result.translationRmsMM = float(std::sqrt(translationSum / double(motions.size())));
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result.transform[row][column] = float(x.r[row][column]);
+        }
+        result.transform[row][3] = float(x.t[row]);
+    }
+    result.solved = true;
+    return AtracsysStatus();
+}
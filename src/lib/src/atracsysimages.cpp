@@ -0,0 +1,467 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsysimages.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// FIFO of slot indices; never holds more than the slot count it was sized for.
+class IndexQueue {
+public:
+    explicit IndexQueue(size_t capacity) : items(capacity) {}
+
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t index) {
+        items[(head + count) % items.size()] = index;
+        ++count;
+    }
+
+    uint32_t pop() {
+        const uint32_t index = items[head];
+        head = (head + 1) % items.size();
+        --count;
+        return index;
+    }
+
+private:
+    std::vector<uint32_t> items;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+uint32_t readPixel(const uint8_t* pixels, size_t index, uint8_t bytesPerPixel) {
+    return bytesPerPixel == 2 ? uint32_t(pixels[2 * index]) | uint32_t(pixels[2 * index + 1]) << 8 : pixels[index];
+}
+
+void writePixel(uint8_t* pixels, size_t index, uint8_t bytesPerPixel, uint32_t value) {
+    if (bytesPerPixel == 2) {
+        pixels[2 * index] = uint8_t(value);
+        pixels[2 * index + 1] = uint8_t(value >> 8);
+    }
+    else {
+        pixels[index] = uint8_t(value);
+    }
+}
+
+void boxAverage(const uint8_t* pixels, uint16_t width, uint16_t height, uint8_t bytesPerPixel, uint32_t factor,
+                std::vector<uint8_t>& result) {
+    const size_t outWidth = width / factor;
+    const size_t outHeight = height / factor;
+    const uint32_t area = factor * factor;
+    result.resize(outWidth * outHeight * bytesPerPixel);
+    for (size_t y = 0; y < outHeight; ++y) {
+        for (size_t x = 0; x < outWidth; ++x) {
+            uint32_t sum = 0;
+            for (size_t dy = 0; dy < factor; ++dy) {
+                const size_t row = (y * factor + dy) * width + x * factor;
+                for (size_t dx = 0; dx < factor; ++dx) {
+                    sum += readPixel(pixels, row + dx, bytesPerPixel);
+                }
+            }
+            writePixel(result.data(), y * outWidth + x, bytesPerPixel, (sum + area / 2) / area);
+        }
+    }
+}
+
+// Residual of every pixel to its left neighbour, or to the pixel above in the first column.
+void predict(const uint8_t* pixels, uint16_t width, uint16_t height, uint8_t bytesPerPixel,
+             std::vector<uint8_t>& residuals) {
+    const uint32_t mask = bytesPerPixel == 2 ? 0xFFFFu : 0xFFu;
+    residuals.resize(size_t(width) * height * bytesPerPixel);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            const size_t index = y * width + x;
+            const uint32_t prediction = x > 0 ? readPixel(pixels, index - 1, bytesPerPixel)
+                                              : (y > 0 ? readPixel(pixels, index - width, bytesPerPixel) : 0u);
+            writePixel(residuals.data(), index, bytesPerPixel,
+                       (readPixel(pixels, index, bytesPerPixel) - prediction) & mask);
+        }
+    }
+}
+
+void unpredict(uint8_t* pixels, uint16_t width, uint16_t height, uint8_t bytesPerPixel) {
+    const uint32_t mask = bytesPerPixel == 2 ? 0xFFFFu : 0xFFu;
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            const size_t index = y * width + x;
+            const uint32_t prediction = x > 0 ? readPixel(pixels, index - 1, bytesPerPixel)
+                                              : (y > 0 ? readPixel(pixels, index - width, bytesPerPixel) : 0u);
+            writePixel(pixels, index, bytesPerPixel, (readPixel(pixels, index, bytesPerPixel) + prediction) & mask);
+        }
+    }
+}
+
+// Rice coding of zigzagged residuals, with the parameter chosen per block from the block mean.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& output) : output(output) { output.clear(); }
+
+    void write(uint32_t value, uint32_t bits) {
+        accumulator |= uint64_t(value) << used;
+        used += bits;
+        while (used >= 8) {
+            output.push_back(uint8_t(accumulator));
+            accumulator >>= 8;
+            used -= 8;
+        }
+    }
+
+    void flush() {
+        if (used > 0) {
+            output.push_back(uint8_t(accumulator));
+        }
+    }
+
+private:
+    std::vector<uint8_t>& output;
+    uint64_t accumulator = 0;
+    uint32_t used = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::vector<uint8_t>& input) : input(input) {}
+
+    bool read(uint32_t bits, uint32_t& value) {
+        while (used < bits) {
+            if (position == input.size()) {
+                return false;
+            }
+            accumulator |= uint64_t(input[position++]) << used;
+            used += 8;
+        }
+        value = uint32_t(accumulator & ((uint64_t(1) << bits) - 1));
+        accumulator >>= bits;
+        used -= bits;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& input;
+    size_t position = 0;
+    uint64_t accumulator = 0;
+    uint32_t used = 0;
+};
+
+const size_t RICE_BLOCK = 32;
+const uint32_t RICE_PARAMETER_BITS = 5;
+// Quotients this long are escaped and the value stored verbatim.
+const uint32_t RICE_ESCAPE = 24;
+
+uint32_t zigzag(uint32_t residual, uint8_t bytesPerPixel) {
+    const int32_t value = bytesPerPixel == 2 ? int32_t(int16_t(residual)) : int32_t(int8_t(residual));
+    return value >= 0 ? uint32_t(value) << 1 : (uint32_t(-value) << 1) - 1;
+}
+
+uint32_t unzigzag(uint32_t value, uint8_t bytesPerPixel) {
+    const int32_t signedValue = (value & 1u) != 0 ? -int32_t((value + 1) >> 1) : int32_t(value >> 1);
+    return uint32_t(signedValue) & (bytesPerPixel == 2 ? 0xFFFFu : 0xFFu);
+}
+
+void riceEncode(const std::vector<uint8_t>& residuals, uint8_t bytesPerPixel, std::vector<uint8_t>& output) {
+    const size_t count = residuals.size() / bytesPerPixel;
+    const uint32_t rawBits = 8u * bytesPerPixel + 1;
+    BitWriter writer(output);
+    for (size_t first = 0; first < count; first += RICE_BLOCK) {
+        const size_t last = std::min(count, first + RICE_BLOCK);
+        uint64_t sum = 0;
+        for (size_t i = first; i < last; ++i) {
+            sum += zigzag(readPixel(residuals.data(), i, bytesPerPixel), bytesPerPixel);
+        }
+        const uint64_t mean = sum / (last - first);
+        uint32_t k = 0;
+        while (k < rawBits && (uint64_t(1) << (k + 1)) <= mean) {
+            ++k;
+        }
+        writer.write(k, RICE_PARAMETER_BITS);
+
+        for (size_t i = first; i < last; ++i) {
+            const uint32_t value = zigzag(readPixel(residuals.data(), i, bytesPerPixel), bytesPerPixel);
+            const uint32_t quotient = value >> k;
+            if (quotient >= RICE_ESCAPE) {
+                writer.write((1u << RICE_ESCAPE) - 1, RICE_ESCAPE);
+                writer.write(value, rawBits);
+                continue;
+            }
+            // Unary quotient: `quotient` ones and a terminating zero.
+            writer.write((1u << quotient) - 1, quotient + 1);
+            if (k > 0) {
+                writer.write(value & ((1u << k) - 1), k);
+            }
+        }
+    }
+    writer.flush();
+}
+
+bool riceDecode(const std::vector<uint8_t>& input, uint8_t bytesPerPixel, size_t count, std::vector<uint8_t>& pixels) {
+    const uint32_t rawBits = 8u * bytesPerPixel + 1;
+    pixels.resize(count * bytesPerPixel);
+    BitReader reader(input);
+    for (size_t first = 0; first < count; first += RICE_BLOCK) {
+        const size_t last = std::min(count, first + RICE_BLOCK);
+        uint32_t k;
+        if (!reader.read(RICE_PARAMETER_BITS, k) || k > rawBits) {
+            return false;
+        }
+        for (size_t i = first; i < last; ++i) {
+            uint32_t quotient = 0;
+            uint32_t bit;
+            for (;;) {
+                if (!reader.read(1, bit)) {
+                    return false;
+                }
+                if (bit == 0) {
+                    break;
+                }
+                if (++quotient == RICE_ESCAPE) {
+                    break;
+                }
+            }
+            uint32_t value;
+            if (quotient == RICE_ESCAPE) {
+                if (!reader.read(rawBits, value)) {
+                    return false;
+                }
+            }
+            else {
+                uint32_t remainder = 0;
+                if (k > 0 && !reader.read(k, remainder)) {
+                    return false;
+                }
+                value = (quotient << k) | remainder;
+            }
+            writePixel(pixels.data(), i, bytesPerPixel, unzigzag(value, bytesPerPixel));
+        }
+    }
+    return true;
+}
+
+}
+
+struct AtracsysImagePipeline::State {
+    struct Slot {
+        AtracsysImage image;
+        std::vector<uint8_t> input;
+        uint16_t width = 0;
+        uint16_t height = 0;
+    };
+
+    explicit State(const AtracsysImageOptions& options)
+            : options(options),
+              slots(std::max<uint32_t>(options.buffers, 1)),
+              pending(slots.size()),
+              finished(slots.size()) {
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            available.push_back(i);
+        }
+    }
+
+    void run();
+    void process(Slot& slot, std::vector<uint8_t>& downsampled, std::vector<uint8_t>& residuals) const;
+    void take(AtracsysImage& image);
+
+    const AtracsysImageOptions options;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> available;
+    IndexQueue pending;
+    IndexQueue finished;
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable ready;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> processed{0};
+};
+
+void AtracsysImagePipeline::State::run() {
+    // Per worker, so they keep their capacity from one image to the next.
+    std::vector<uint8_t> downsampled;
+    std::vector<uint8_t> residuals;
+    for (;;) {
+        uint32_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            index = pending.pop();
+        }
+
+        process(slots[index], downsampled, residuals);
+        processed.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push(index);
+        }
+        ready.notify_all();
+    }
+}
+
+void AtracsysImagePipeline::State::process(Slot& slot, std::vector<uint8_t>& downsampled,
+                                           std::vector<uint8_t>& residuals) const {
+    AtracsysImage& image = slot.image;
+    const uint32_t factor = std::max<uint32_t>(options.downsample, 1);
+    const uint8_t* pixels = slot.input.data();
+    image.width = slot.width;
+    image.height = slot.height;
+    if (factor > 1) {
+        boxAverage(pixels, slot.width, slot.height, image.bytesPerPixel, factor, downsampled);
+        pixels = downsampled.data();
+        image.width = uint16_t(slot.width / factor);
+        image.height = uint16_t(slot.height / factor);
+    }
+
+    if (options.compress) {
+        predict(pixels, image.width, image.height, image.bytesPerPixel, residuals);
+        riceEncode(residuals, image.bytesPerPixel, image.data);
+        image.encoding = AtracsysImageEncoding::DeltaRice;
+        return;
+    }
+    image.encoding = AtracsysImageEncoding::Raw;
+    if (factor > 1) {
+        std::swap(image.data, downsampled);
+    }
+    else {
+        std::swap(image.data, slot.input);
+    }
+}
+
+void AtracsysImagePipeline::State::take(AtracsysImage& image) {
+    const uint32_t index = finished.pop();
+    AtracsysImage& source = slots[index].image;
+    image.frameIndex = source.frameIndex;
+    image.timestampUS = source.timestampUS;
+    image.camera = source.camera;
+    image.width = source.width;
+    image.height = source.height;
+    image.bytesPerPixel = source.bytesPerPixel;
+    image.encoding = source.encoding;
+    std::swap(image.data, source.data);
+    available.push_back(index);
+}
+
+AtracsysImagePipeline::AtracsysImagePipeline(const AtracsysImageOptions& options)
+        : state(new State(options)) {
+    const size_t workers = std::max<size_t>(options.workers, 1);
+    for (size_t i = 0; i < workers; ++i) {
+        state->workers.emplace_back(&State::run, state.get());
+    }
+}
+
+AtracsysImagePipeline::~AtracsysImagePipeline() {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->work.notify_all();
+    state->ready.notify_all();
+    for (std::thread& worker : state->workers) {
+        worker.join();
+    }
+}
+
+bool AtracsysImagePipeline::push(AtracsysCamera camera, uint64_t frameIndex, uint64_t timestampUS,
+                                 const uint8_t* pixels, uint16_t width, uint16_t height, int32_t strideBytes,
+                                 uint8_t bytesPerPixel) {
+    const size_t rowBytes = size_t(width) * bytesPerPixel;
+    const uint32_t factor = std::max<uint32_t>(state->options.downsample, 1);
+    if (pixels == nullptr || (bytesPerPixel != 1 && bytesPerPixel != 2) || width < factor || height < factor ||
+        strideBytes < int32_t(rowBytes)) {
+        state->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t index;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->available.empty()) {
+            state->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        index = state->available.back();
+        state->available.pop_back();
+    }
+
+    // The slot belongs to this call until it is queued.
+    State::Slot& slot = state->slots[index];
+    slot.input.resize(rowBytes * height);
+    for (size_t y = 0; y < height; ++y) {
+        memcpy(slot.input.data() + y * rowBytes, pixels + y * size_t(strideBytes), rowBytes);
+    }
+    slot.width = width;
+    slot.height = height;
+    slot.image.frameIndex = frameIndex;
+    slot.image.timestampUS = timestampUS;
+    slot.image.camera = camera;
+    slot.image.bytesPerPixel = bytesPerPixel;
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->pending.push(index);
+    }
+    state->work.notify_one();
+    state->pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AtracsysImagePipeline::poll(AtracsysImage& image) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->finished.empty()) {
+        return false;
+    }
+    state->take(image);
+    return true;
+}
+
+bool AtracsysImagePipeline::wait(AtracsysImage& image, uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->ready.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                               [this] { return state->stopping || !state->finished.empty(); }) ||
+        state->finished.empty()) {
+        return false;
+    }
+    state->take(image);
+    return true;
+}
+
+AtracsysImageStats AtracsysImagePipeline::getStats() const {
+    AtracsysImageStats stats;
+    stats.pushed = state->pushed.load(std::memory_order_relaxed);
+    stats.dropped = state->dropped.load(std::memory_order_relaxed);
+    stats.processed = state->processed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool decodeImage(const AtracsysImage& image, std::vector<uint8_t>& pixels) {
+    const size_t size = size_t(image.width) * image.height * image.bytesPerPixel;
+    switch (image.encoding) {
+        case AtracsysImageEncoding::Raw:
+            if (image.data.size() != size) {
+                return false;
+            }
+            pixels.assign(image.data.begin(), image.data.end());
+            return true;
+        case AtracsysImageEncoding::DeltaRice:
+            if (!riceDecode(image.data, image.bytesPerPixel, size / image.bytesPerPixel, pixels)) {
+                return false;
+            }
+            unpredict(pixels.data(), image.width, image.height, image.bytesPerPixel);
+            return true;
+    }
+    return false;
+}
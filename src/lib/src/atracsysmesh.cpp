@@ -0,0 +1,136 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsysmesh.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+const size_t BINARY_HEADER_SIZE = 80;
+const size_t BINARY_FACET_SIZE = 50;
+
+struct VertexKey {
+    uint32_t bits[3];
+
+    bool operator==(const VertexKey& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (uint32_t bits : key.bits) {
+            hash = (hash ^ bits) * 0x100000001B3ull;
+        }
+        return size_t(hash);
+    }
+};
+
+class MeshBuilder {
+public:
+    explicit MeshBuilder(AtracsysMesh& mesh) : mesh(mesh) {
+        mesh.vertices.clear();
+        mesh.triangles.clear();
+    }
+
+    void addFacet(const float corners[3][3]) {
+        std::array<uint32_t, 3> triangle;
+        for (int k = 0; k < 3; ++k) {
+            VertexKey key;
+            // -0 and +0 are the same position.
+            for (int axis = 0; axis < 3; ++axis) {
+                const float value = corners[k][axis] == 0.f ? 0.f : corners[k][axis];
+                memcpy(&key.bits[axis], &value, sizeof(float));
+            }
+            auto found = indices.find(key);
+            if (found == indices.end()) {
+                found = indices.emplace(key, uint32_t(mesh.vertices.size())).first;
+                mesh.vertices.push_back({ { corners[k][0], corners[k][1], corners[k][2] } });
+            }
+            triangle[k] = found->second;
+        }
+        // Collapsed facets carry no surface.
+        if (triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[0] != triangle[2]) {
+            mesh.triangles.push_back(triangle);
+        }
+    }
+
+private:
+    AtracsysMesh& mesh;
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> indices;
+};
+
+bool loadBinary(const std::string& data, AtracsysMesh& mesh) {
+    uint32_t count = 0;
+    memcpy(&count, data.data() + BINARY_HEADER_SIZE, sizeof(count));
+    if (data.size() < BINARY_HEADER_SIZE + 4 + size_t(count) * BINARY_FACET_SIZE) {
+        return false;
+    }
+
+    MeshBuilder builder(mesh);
+    mesh.vertices.reserve(count / 2 + 3);
+    mesh.triangles.reserve(count);
+    const char* facet = data.data() + BINARY_HEADER_SIZE + 4;
+    for (uint32_t i = 0; i < count; ++i, facet += BINARY_FACET_SIZE) {
+        float corners[3][3];
+        // Skip the 12-byte normal; the 2-byte attribute count trails the corners.
+        memcpy(corners, facet + 12, sizeof(corners));
+        builder.addFacet(corners);
+    }
+    return !mesh.triangles.empty();
+}
+
+bool loadAscii(const std::string& data, AtracsysMesh& mesh) {
+    MeshBuilder builder(mesh);
+    std::istringstream stream(data);
+    std::string word;
+    float corners[3][3];
+    int corner = 0;
+    while (stream >> word) {
+        if (word == "vertex") {
+            if (corner == 3 || !(stream >> corners[corner][0] >> corners[corner][1] >> corners[corner][2])) {
+                return false;
+            }
+            ++corner;
+        }
+        else if (word == "endloop") {
+            if (corner != 3) {
+                return false;
+            }
+            builder.addFacet(corners);
+            corner = 0;
+        }
+    }
+    return !mesh.triangles.empty();
+}
+
+}
+
+bool loadStlMesh(const std::string& fileName, AtracsysMesh& mesh) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string data = contents.str();
+
+    // Binary files may also start with "solid"; the size check tells them apart.
+    if (data.size() >= BINARY_HEADER_SIZE + 4) {
+        uint32_t count = 0;
+        memcpy(&count, data.data() + BINARY_HEADER_SIZE, sizeof(count));
+        if (data.size() == BINARY_HEADER_SIZE + 4 + size_t(count) * BINARY_FACET_SIZE) {
+            return loadBinary(data, mesh);
+        }
+    }
+    if (data.compare(0, 5, "solid") == 0) {
+        return loadAscii(data, mesh);
+    }
+    return data.size() >= BINARY_HEADER_SIZE + 4 && loadBinary(data, mesh);
+}
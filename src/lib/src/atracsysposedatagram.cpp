@@ -0,0 +1,244 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsysposedatagram.h"
+#include "posemath.h"
+#include "socketcompat.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+void put16(uint8_t*& out, uint16_t value) {
+    out[0] = uint8_t(value);
+    out[1] = uint8_t(value >> 8);
+    out += 2;
+}
+
+void put32(uint8_t*& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = uint8_t(value >> (8 * i));
+    }
+    out += 4;
+}
+
+void put64(uint8_t*& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = uint8_t(value >> (8 * i));
+    }
+    out += 8;
+}
+
+uint16_t get16(const uint8_t*& in) {
+    uint16_t value = uint16_t(in[0] | (in[1] << 8));
+    in += 2;
+    return value;
+}
+
+uint32_t get32(const uint8_t*& in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= uint32_t(in[i]) << (8 * i);
+    }
+    in += 4;
+    return value;
+}
+
+uint64_t get64(const uint8_t*& in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= uint64_t(in[i]) << (8 * i);
+    }
+    in += 8;
+    return value;
+}
+
+int16_t quantizeUnit(float value) {
+    return int16_t(std::lround(std::max(-1.f, std::min(1.f, value)) * 32767.f));
+}
+
+int32_t quantizeMicrometres(float millimetres) {
+    const double micrometres = double(millimetres) * 1000.0;
+    return int32_t(std::max(-2147483647.0, std::min(2147483647.0, std::round(micrometres))));
+}
+
+}
+
+size_t AtracsysPoseDatagram::encode(const AtracsysFrame& frame, uint16_t session, uint32_t sequence, uint8_t* buffer,
+                                    size_t capacity) {
+    const uint32_t count = std::min(frame.poseCount, uint32_t(AtracsysFrame::MAX_POSES));
+    const size_t size = HEADER_SIZE + TOOL_SIZE * count;
+    if (capacity < size) {
+        return 0;
+    }
+
+    uint8_t* out = buffer;
+    put32(out, MAGIC);
+    *out++ = VERSION;
+    *out++ = uint8_t(count);
+    put16(out, session);
+    put32(out, sequence);
+    put64(out, frame.timestampUS);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const AtracsysPose& pose = frame.poses[i];
+        const posemath::Quaternion q = posemath::fromRotation(pose.transform);
+
+        put32(out, pose.geometryId);
+        put16(out, uint16_t(quantizeUnit(q.w)));
+        put16(out, uint16_t(quantizeUnit(q.x)));
+        put16(out, uint16_t(quantizeUnit(q.y)));
+        put16(out, uint16_t(quantizeUnit(q.z)));
+        for (int k = 0; k < 3; ++k) {
+            put32(out, uint32_t(quantizeMicrometres(pose.transform[k][3])));
+        }
+        const float error = std::round(pose.registrationErrorMM * 1000.f);
+        put16(out, uint16_t(std::max(0.f, std::min(65535.f, error))));
+        put16(out, uint16_t(pose.geometryPresenceMask));
+    }
+    return size;
+}
+
+bool AtracsysPoseDatagram::decode(const uint8_t* buffer, size_t size, AtracsysFrame& frame, uint16_t& session,
+                                  uint32_t& sequence) {
+    if (size < HEADER_SIZE) {
+        return false;
+    }
+
+    const uint8_t* in = buffer;
+    if (get32(in) != MAGIC || *in++ != VERSION) {
+        return false;
+    }
+    const uint32_t count = *in++;
+    const uint16_t datagramSession = get16(in);
+    if (count > AtracsysFrame::MAX_POSES || size < HEADER_SIZE + TOOL_SIZE * count) {
+        return false;
+    }
+
+    session = datagramSession;
+    sequence = get32(in);
+    frame.index = sequence;
+    frame.timestampUS = get64(in);
+    frame.poseCount = count;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        AtracsysPose& pose = frame.poses[i];
+        pose.geometryId = get32(in);
+
+        posemath::Quaternion q;
+        q.w = int16_t(get16(in)) / 32767.f;
+        q.x = int16_t(get16(in)) / 32767.f;
+        q.y = int16_t(get16(in)) / 32767.f;
+        q.z = int16_t(get16(in)) / 32767.f;
+        pose.transform = posemath::identity();
+        posemath::setRotation(posemath::normalized(q), pose.transform);
+        for (int k = 0; k < 3; ++k) {
+            pose.transform[k][3] = int32_t(get32(in)) / 1000.f;
+        }
+        pose.registrationErrorMM = get16(in) / 1000.f;
+        pose.geometryPresenceMask = get16(in);
+    }
+    return true;
+}
+
+AtracsysPoseReceiver::AtracsysPoseReceiver()
+        : socketLibrary(std::make_unique<SocketLibrary>()),
+          socket(intptr_t(INVALID_SOCKET_HANDLE)) {
+}
+
+AtracsysPoseReceiver::~AtracsysPoseReceiver() {
+    close();
+}
+
+bool AtracsysPoseReceiver::open(const std::string& group, uint16_t port, const std::string& interfaceAddress) {
+    close();
+
+    SocketHandle handle = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (handle == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    int bufferSize = 1 << 20;
+    setsockopt(handle, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(handle);
+        return false;
+    }
+
+    in_addr groupAddress{};
+    if (inet_pton(AF_INET, group.c_str(), &groupAddress) != 1) {
+        closeSocket(handle);
+        return false;
+    }
+    if (IN_MULTICAST(ntohl(groupAddress.s_addr))) {
+        ip_mreq request{};
+        request.imr_multiaddr = groupAddress;
+        inet_pton(AF_INET, interfaceAddress.c_str(), &request.imr_interface);
+        if (setsockopt(handle, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                       reinterpret_cast<const char*>(&request), sizeof(request)) != 0) {
+            closeSocket(handle);
+            return false;
+        }
+    }
+
+    socket = intptr_t(handle);
+    hasSequence = false;
+    return true;
+}
+
+void AtracsysPoseReceiver::close() {
+    if (SocketHandle(socket) != INVALID_SOCKET_HANDLE) {
+        closeSocket(SocketHandle(socket));
+        socket = intptr_t(INVALID_SOCKET_HANDLE);
+    }
+}
+
+bool AtracsysPoseReceiver::receive(AtracsysFrame& frame, int timeoutMs) {
+    const SocketHandle handle = SocketHandle(socket);
+    if (handle == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    uint8_t buffer[AtracsysPoseDatagram::MAX_SIZE];
+    while (true) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(handle, &readable);
+        timeval timeout{ timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+        if (select(int(handle) + 1, &readable, nullptr, nullptr, &timeout) <= 0) {
+            return false;
+        }
+
+        const int size = recv(handle, reinterpret_cast<char*>(buffer), sizeof(buffer), 0);
+        uint16_t session = 0;
+        uint32_t sequence = 0;
+        if (size <= 0 || !AtracsysPoseDatagram::decode(buffer, size_t(size), frame, session, sequence)) {
+            continue;
+        }
+
+        ++received;
+        const int32_t delta = int32_t(sequence - lastSequence);
+        // A restarted publisher counts again from 0.
+        if (hasSequence && session == lastSession && delta >= -int32_t(MAX_REORDER)) {
+            if (delta <= 0) {
+                // Late or duplicated datagram, the caller already has newer poses.
+                ++outOfOrder;
+                continue;
+            }
+            lost += uint64_t(delta - 1);
+        }
+        hasSequence = true;
+        lastSession = session;
+        lastSequence = sequence;
+        return true;
+    }
+}
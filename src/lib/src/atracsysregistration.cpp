@@ -0,0 +1,262 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsysregistration.h"
+#include "posemath.h"
+#include "rigidfit.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+typedef AtracsysRegistration::Point Point;
+typedef AtracsysMarker::Transform Transform;
+
+const uint32_t HYPOTHESES_PER_TASK = 32;
+const int MAX_REFINEMENTS = 8;
+
+struct Hypothesis {
+    size_t inliers = 0;
+    double cost = std::numeric_limits<double>::infinity();
+    uint32_t index = UINT32_MAX;
+    Transform transform;
+
+    bool betterThan(const Hypothesis& other) const {
+        if (inliers != other.inliers) {
+            return inliers > other.inliers;
+        }
+        if (cost != other.cost) {
+            return cost < other.cost;
+        }
+        return index < other.index;
+    }
+};
+
+float residual(const Transform& transform, const Point& source, const Point& target) {
+    const Point mapped = posemath::transformPoint(transform, source);
+    const float dx = mapped[0] - target[0];
+    const float dy = mapped[1] - target[1];
+    const float dz = mapped[2] - target[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Residuals of all pairs, FRE over the pairs flagged in result.inliers.
+void evaluate(const std::vector<Point>& source, const std::vector<Point>& target, AtracsysRegistrationResult& result) {
+    result.residualsMM.resize(source.size());
+    double sum = 0.0;
+    for (size_t i = 0; i < source.size(); ++i) {
+        result.residualsMM[i] = residual(result.transform, source[i], target[i]);
+        if (result.inliers[i] != 0) {
+            sum += double(result.residualsMM[i]) * result.residualsMM[i];
+        }
+    }
+    result.freMM = result.inlierCount > 0 ? float(std::sqrt(sum / double(result.inlierCount))) : 0.f;
+}
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+bool collinear(const Point& a, const Point& b, const Point& c) {
+    const float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    const float cross[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+    const float area = cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+    const float lengths = (u[0] * u[0] + u[1] * u[1] + u[2] * u[2]) * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    return area <= 1e-6f * lengths;
+}
+
+// Hypotheses needed to draw one all-inlier triple with the given confidence.
+uint32_t requiredHypotheses(size_t inliers, size_t count, float confidence, uint32_t maximum) {
+    const double ratio = double(inliers) / double(count);
+    const double good = ratio * ratio * ratio;
+    if (good >= 1.0) {
+        return 1;
+    }
+    if (good <= 0.0) {
+        return maximum;
+    }
+    const double needed = std::ceil(std::log(1.0 - confidence) / std::log(1.0 - good));
+    return needed < double(maximum) ? uint32_t(std::max(needed, 1.0)) : maximum;
+}
+
+AtracsysStatus checkCorrespondences(const std::vector<Point>& source, const std::vector<Point>& target,
+                                    AtracsysRegistrationResult& result) {
+    result = AtracsysRegistrationResult();
+    if (source.size() != target.size() || source.size() < 3 || source.size() > UINT32_MAX) {
+        return AtracsysStatus(AtracsysStatusCode::InvalidCorrespondences);
+    }
+    return AtracsysStatus();
+}
+
+}
+
+AtracsysRegistration::AtracsysRegistration(size_t threads)
+        : pool(new ThreadPool(threads)) {
+}
+
+AtracsysRegistration::~AtracsysRegistration() = default;
+
+AtracsysStatus AtracsysRegistration::registerPoints(const std::vector<Point>& source, const std::vector<Point>& target,
+                                                    AtracsysRegistrationResult& result) const {
+    AtracsysStatus status = checkCorrespondences(source, target, result);
+    if (!status) {
+        return status;
+    }
+    if (!fitRigid(source.data(), target.data(), nullptr, source.size(), result.transform)) {
+        return AtracsysStatus(AtracsysStatusCode::RegistrationFailed);
+    }
+
+    result.inliers.assign(source.size(), 1);
+    result.inlierCount = source.size();
+    evaluate(source, target, result);
+    result.valid = true;
+    return status;
+}
+
+AtracsysStatus AtracsysRegistration::registerPointsRansac(const std::vector<Point>& source, const std::vector<Point>& target,
+                                                          const AtracsysRansacOptions& options,
+                                                          AtracsysRegistrationResult& result) const {
+    AtracsysStatus status = checkCorrespondences(source, target, result);
+    if (!status) {
+        return status;
+    }
+
+    const uint32_t count = uint32_t(source.size());
+    const uint32_t maxIterations = std::max<uint32_t>(options.maxIterations, 1);
+    const size_t minInliers = std::max<size_t>(options.minInliers, 3);
+    const float threshold = options.inlierThresholdMM;
+
+    std::atomic<uint32_t> required{maxIterations};
+    std::atomic<size_t> bestInliers{0};
+    std::atomic<uint32_t> evaluated{0};
+    std::vector<Hypothesis> best((maxIterations + HYPOTHESES_PER_TASK - 1) / HYPOTHESES_PER_TASK);
+
+    pool->parallelFor(best.size(), [&](size_t task) {
+        const uint32_t first = uint32_t(task) * HYPOTHESES_PER_TASK;
+        const uint32_t last = std::min(first + HYPOTHESES_PER_TASK, maxIterations);
+        for (uint32_t iteration = first; iteration < last; ++iteration) {
+            if (iteration >= required.load(std::memory_order_relaxed)) {
+                break;
+            }
+            evaluated.fetch_add(1, std::memory_order_relaxed);
+
+            // Seeded per hypothesis, so the samples do not depend on the scheduling.
+            uint64_t state = options.seed ^ (uint64_t(iteration) * 0xD1B54A32D192ED03ull);
+            uint32_t sample[3];
+            sample[0] = uint32_t(splitMix64(state) % count);
+            do {
+                sample[1] = uint32_t(splitMix64(state) % count);
+            } while (sample[1] == sample[0]);
+            do {
+                sample[2] = uint32_t(splitMix64(state) % count);
+            } while (sample[2] == sample[0] || sample[2] == sample[1]);
+
+            if (collinear(source[sample[0]], source[sample[1]], source[sample[2]])) {
+                continue;
+            }
+            Hypothesis hypothesis;
+            if (!fitRigid(source.data(), target.data(), sample, 3, hypothesis.transform)) {
+                continue;
+            }
+            hypothesis.index = iteration;
+            hypothesis.cost = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                const float error = residual(hypothesis.transform, source[i], target[i]);
+                if (error <= threshold) {
+                    ++hypothesis.inliers;
+                    hypothesis.cost += double(error) * error;
+                }
+            }
+            if (!hypothesis.betterThan(best[task])) {
+                continue;
+            }
+            best[task] = hypothesis;
+
+            size_t known = bestInliers.load(std::memory_order_relaxed);
+            while (hypothesis.inliers > known &&
+                   !bestInliers.compare_exchange_weak(known, hypothesis.inliers, std::memory_order_relaxed)) {
+            }
+            if (hypothesis.inliers > known) {
+                const uint32_t needed = requiredHypotheses(hypothesis.inliers, count, options.confidence, maxIterations);
+                uint32_t current = required.load(std::memory_order_relaxed);
+                while (needed < current && !required.compare_exchange_weak(current, needed, std::memory_order_relaxed)) {
+                }
+            }
+        }
+    });
+
+    Hypothesis winner;
+    for (const Hypothesis& candidate : best) {
+        if (candidate.betterThan(winner)) {
+            winner = candidate;
+        }
+    }
+    result.hypotheses = evaluated.load(std::memory_order_relaxed);
+    if (winner.inliers < minInliers) {
+        return AtracsysStatus(AtracsysStatusCode::RegistrationFailed);
+    }
+
+    // Refit on the consensus set until it stops changing.
+    result.transform = winner.transform;
+    std::vector<uint32_t> inliers;
+    std::vector<uint32_t> previous;
+    for (int refinement = 0; refinement < MAX_REFINEMENTS; ++refinement) {
+        inliers.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (residual(result.transform, source[i], target[i]) <= threshold) {
+                inliers.push_back(i);
+            }
+        }
+        if (inliers.size() < minInliers) {
+            inliers.swap(previous);
+            break;
+        }
+        if (inliers == previous) {
+            break;
+        }
+        Transform refined;
+        if (!fitRigid(source.data(), target.data(), inliers.data(), inliers.size(), refined)) {
+            break;
+        }
+        result.transform = refined;
+        previous = inliers;
+    }
+    if (inliers.size() < minInliers) {
+        return AtracsysStatus(AtracsysStatusCode::RegistrationFailed);
+    }
+
+    result.inliers.assign(count, 0);
+    for (uint32_t i : inliers) {
+        result.inliers[i] = 1;
+    }
+    result.inlierCount = inliers.size();
+    evaluate(source, target, result);
+    result.valid = true;
+    return status;
+}
+
+size_t AtracsysRegistration::registerBatch(const std::vector<AtracsysRegistrationProblem>& problems,
+                                           std::vector<AtracsysRegistrationResult>& results) const {
+    results.resize(problems.size());
+    std::atomic<size_t> valid{0};
+    pool->parallelFor(problems.size(), [&](size_t index) {
+        const AtracsysRegistrationProblem& problem = problems[index];
+        // Runs inline on the worker: the nested parallelFor does not fan out again.
+        const AtracsysStatus status = problem.ransac
+                ? registerPointsRansac(problem.source, problem.target, problem.ransacOptions, results[index])
+                : registerPoints(problem.source, problem.target, results[index]);
+        if (status) {
+            valid.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    return valid.load(std::memory_order_relaxed);
+}
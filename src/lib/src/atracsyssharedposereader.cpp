@@ -0,0 +1,153 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsyssharedposes.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace AtracsysSharedPoses;
+
+namespace {
+const int MAX_READ_ATTEMPTS = 64;
+}
+
+AtracsysSharedPoseReader::AtracsysSharedPoseReader() = default;
+
+AtracsysSharedPoseReader::~AtracsysSharedPoseReader() {
+    close();
+}
+
+bool AtracsysSharedPoseReader::open(const std::string& name) {
+    close();
+#ifdef _WIN32
+    return false;
+#else
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    const Header* mapped = static_cast<const Header*>(address);
+    if (mapped->magic.load(std::memory_order_acquire) != MAGIC || mapped->version != VERSION ||
+        mapped->slotSize != sizeof(Slot) || mapped->capacity == 0 ||
+        segmentSize(mapped->capacity) > static_cast<size_t>(info.st_size)) {
+        munmap(address, static_cast<size_t>(info.st_size));
+        return false;
+    }
+
+    header = mapped;
+    slots = reinterpret_cast<const Slot*>(static_cast<const char*>(address) + sizeof(Header));
+    mappedSize = static_cast<size_t>(info.st_size);
+    return true;
+#endif
+}
+
+void AtracsysSharedPoseReader::close() {
+#ifndef _WIN32
+    if (header != nullptr) {
+        munmap(const_cast<Header*>(header), mappedSize);
+    }
+#endif
+    header = nullptr;
+    slots = nullptr;
+    mappedSize = 0;
+}
+
+bool AtracsysSharedPoseReader::isOpen() const {
+    return header != nullptr;
+}
+
+bool AtracsysSharedPoseReader::isPublisherOpen() const {
+    return header != nullptr && header->magic.load(std::memory_order_acquire) == MAGIC;
+}
+
+uint32_t AtracsysSharedPoseReader::getCapacity() const {
+    return header != nullptr ? header->capacity : 0;
+}
+
+uint64_t AtracsysSharedPoseReader::getPublishedCount() const {
+    return isPublisherOpen() ? header->published.load(std::memory_order_acquire) : 0;
+}
+
+bool AtracsysSharedPoseReader::readLatest(AtracsysFrame& frame) const {
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint64_t published = getPublishedCount();
+        if (published == 0) {
+            return false;
+        }
+        if (readSlot(published - 1, frame)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AtracsysSharedPoseReader::read(uint64_t publication, AtracsysFrame& frame) const {
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint64_t published = getPublishedCount();
+        if (publication >= published || published - publication > header->capacity) {
+            return false;
+        }
+        if (readSlot(publication, frame)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t AtracsysSharedPoseReader::readHistory(AtracsysFrame* frames, size_t count) const {
+    const uint64_t published = getPublishedCount();
+    if (published == 0 || count == 0) {
+        return 0;
+    }
+
+    // Keep one slot of margin: the oldest slot is the next one the writer reuses.
+    uint64_t available = published < header->capacity ? published : header->capacity - 1;
+    if (count > available) {
+        count = static_cast<size_t>(available);
+    }
+
+    size_t copied = 0;
+    for (uint64_t publication = published - count; publication < published; ++publication) {
+        if (read(publication, frames[copied])) {
+            ++copied;
+        }
+    }
+    return copied;
+}
+
+bool AtracsysSharedPoseReader::readSlot(uint64_t publication, AtracsysFrame& frame) const {
+    if (!isPublisherOpen()) {
+        return false;
+    }
+
+    const Slot& slot = slots[publication % header->capacity];
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if ((before & 1u) != 0) {
+        return false;
+    }
+
+    const uint64_t stored = slot.publication;
+    frame.copyFrom(slot.frame);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return slot.sequence.load(std::memory_order_relaxed) == before && stored == publication;
+}
@@ -0,0 +1,73 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsysstatus.h"
+
+const char* toString(AtracsysStatusCode code) {
+    switch (code) {
+        case AtracsysStatusCode::Ok:
+            return "ok";
+        case AtracsysStatusCode::NotInitialised:
+            return "wrapper not initialised";
+        case AtracsysStatusCode::LibraryInitFailed:
+            return "cannot initialise driver";
+        case AtracsysStatusCode::NoDevice:
+            return "no device connected";
+        case AtracsysStatusCode::UnknownDevice:
+            return "unknown device type";
+        case AtracsysStatusCode::OptionFailed:
+            return "cannot set device option";
+        case AtracsysStatusCode::GeometryLoadFailed:
+            return "cannot load geometry file";
+        case AtracsysStatusCode::GeometryUploadFailed:
+            return "cannot set geometry on device";
+        case AtracsysStatusCode::FrameAllocationFailed:
+            return "cannot create frame instance";
+        case AtracsysStatusCode::FrameOptionsFailed:
+            return "cannot set frame options";
+        case AtracsysStatusCode::NotTracking:
+            return "tracking not started";
+        case AtracsysStatusCode::FrameTimeout:
+            return "could not load frame";
+        case AtracsysStatusCode::NoMarkers:
+            return "no markers";
+        case AtracsysStatusCode::MarkerOverflow:
+            return "marker overflow";
+        case AtracsysStatusCode::InvalidFrame:
+            return "invalid frame status";
+        case AtracsysStatusCode::CloseFailed:
+            return "cannot close driver";
+        case AtracsysStatusCode::ThreadStartFailed:
+            return "cannot start acquisition thread";
+        case AtracsysStatusCode::MemoryLockFailed:
+            return "cannot lock process memory";
+        case AtracsysStatusCode::UnknownGeometry:
+            return "geometry not loaded";
+        case AtracsysStatusCode::CalibrationNotSolved:
+            return "calibration not solved";
+        case AtracsysStatusCode::GeometrySaveFailed:
+            return "cannot write geometry file";
+        case AtracsysStatusCode::InvalidCorrespondences:
+            return "need at least 3 point pairs";
+        case AtracsysStatusCode::RegistrationFailed:
+            return "degenerate or inconsistent point pairs";
+        case AtracsysStatusCode::TooManyPointers:
+            return "too many digitizing pointers";
+        case AtracsysStatusCode::MeshLoadFailed:
+            return "cannot load mesh";
+        case AtracsysStatusCode::NoMesh:
+            return "no mesh set";
+        case AtracsysStatusCode::AcquisitionRunning:
+            return "stop the acquisition thread first";
+        case AtracsysStatusCode::TooManyGeometries:
+            return "too many geometries";
+        case AtracsysStatusCode::Count:
+            break;
+    }
+    return "unknown status";
+}
+
+const char* AtracsysStatus::getMessage() const {
+    return toString(code);
+}
@@ -0,0 +1,344 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsyssurfaceregistration.h"
+#include "linearsolve.h"
+#include "meshbvh.h"
+#include "posemath.h"
+#include "rigidfit.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+typedef AtracsysSurfaceRegistration::Point Point;
+typedef AtracsysMarker::Transform Transform;
+
+const double PI = 3.14159265358979323846;
+const size_t POINTS_PER_TASK = 256;
+// Keeps the point-to-plane system solvable when the surface lets points slide along it.
+const double PLANE_DAMPING = 1e-9;
+
+// Rotation by angle |v| around v, about `center`.
+Transform rotationAbout(const double v[3], const double center[3]) {
+    const double angle = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    Transform result = posemath::identity();
+    if (angle > 0.0) {
+        const double half = 0.5 * angle;
+        const double scale = std::sin(half) / angle;
+        posemath::Quaternion q;
+        q.w = float(std::cos(half));
+        q.x = float(v[0] * scale);
+        q.y = float(v[1] * scale);
+        q.z = float(v[2] * scale);
+        posemath::setRotation(posemath::normalized(q), result);
+    }
+    for (int row = 0; row < 3; ++row) {
+        result[row][3] = float(center[row] - result[row][0] * center[0] - result[row][1] * center[1] -
+                               result[row][2] * center[2]);
+    }
+    return result;
+}
+
+// Spreads the low 10 bits of v to every third bit.
+uint32_t spreadBits(uint32_t v) {
+    v &= 0x3FF;
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// Z-order copy of the points: neighbouring queries then walk the same BVH nodes while they are in cache.
+std::vector<Point> spatiallySorted(const std::vector<Point>& points) {
+    float min[3];
+    float max[3];
+    for (int k = 0; k < 3; ++k) {
+        min[k] = std::numeric_limits<float>::max();
+        max[k] = -std::numeric_limits<float>::max();
+    }
+    for (const Point& point : points) {
+        for (int k = 0; k < 3; ++k) {
+            min[k] = std::min(min[k], point[k]);
+            max[k] = std::max(max[k], point[k]);
+        }
+    }
+    const float extent = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+    const float scale = extent > 0.f ? 1023.f / extent : 0.f;
+
+    std::vector<std::pair<uint32_t, uint32_t>> codes(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        uint32_t code = 0;
+        for (int k = 0; k < 3; ++k) {
+            code |= spreadBits(uint32_t((points[i][k] - min[k]) * scale)) << k;
+        }
+        codes[i] = { code, uint32_t(i) };
+    }
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<Point> result(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        result[i] = points[codes[i].second];
+    }
+    return result;
+}
+
+}
+
+struct AtracsysSurfaceRegistration::Run {
+    Transform transform;
+    bool converged = false;
+    float rmsMM = std::numeric_limits<float>::max();
+    size_t inliers = 0;
+    uint32_t iterations = 0;
+
+    std::vector<Point> moved;
+    std::vector<Point> closest;
+    std::vector<Point> normals;
+    std::vector<float> distances;
+    std::vector<float> sorted;
+    std::vector<uint32_t> hints;
+    std::vector<uint32_t> selected;
+    std::vector<float> taskReach;
+    std::vector<std::array<double, 28>> taskSums;
+};
+
+AtracsysSurfaceRegistration::AtracsysSurfaceRegistration(size_t threads)
+        : pool(new ThreadPool(threads)) {
+}
+
+AtracsysSurfaceRegistration::~AtracsysSurfaceRegistration() = default;
+
+AtracsysStatus AtracsysSurfaceRegistration::setMesh(const AtracsysMesh& mesh) {
+    std::unique_ptr<MeshBvh> fresh(new MeshBvh());
+    if (!fresh->build(mesh)) {
+        return AtracsysStatus(AtracsysStatusCode::MeshLoadFailed);
+    }
+    bvh = std::move(fresh);
+    return AtracsysStatus();
+}
+
+AtracsysStatus AtracsysSurfaceRegistration::loadMesh(const std::string& stlFileName) {
+    AtracsysMesh mesh;
+    if (!loadStlMesh(stlFileName, mesh)) {
+        return AtracsysStatus(AtracsysStatusCode::MeshLoadFailed);
+    }
+    return setMesh(mesh);
+}
+
+AtracsysStatus AtracsysSurfaceRegistration::registerPoints(const std::vector<Point>& points, const Transform& initial,
+                                                           const AtracsysIcpOptions& options,
+                                                           AtracsysIcpResult& result) const {
+    result = AtracsysIcpResult();
+    if (!bvh) {
+        return AtracsysStatus(AtracsysStatusCode::NoMesh);
+    }
+    if (points.size() < 3 || points.size() >= UINT32_MAX) {
+        return AtracsysStatus(AtracsysStatusCode::InvalidCorrespondences);
+    }
+
+    const std::vector<Point> sorted = spatiallySorted(points);
+    double centroid[3] = { 0.0, 0.0, 0.0 };
+    for (const Point& point : points) {
+        const Point moved = posemath::transformPoint(initial, point);
+        for (int k = 0; k < 3; ++k) {
+            centroid[k] += moved[k] / double(points.size());
+        }
+    }
+
+    Run best;
+    Run run;
+    const uint32_t starts = std::max<uint32_t>(options.starts, 1);
+    for (uint32_t start = 0; start < starts; ++start) {
+        Transform transform = initial;
+        if (start > 0) {
+            // Fibonacci sphere: evenly spread rotation axes.
+            const double m = double(starts - 1);
+            const double i = double(start - 1);
+            const double z = 1.0 - 2.0 * (i + 0.5) / m;
+            const double radius = std::sqrt(std::max(0.0, 1.0 - z * z));
+            const double azimuth = i * PI * (3.0 - std::sqrt(5.0));
+            const double angle = options.startAngleDeg * PI / 180.0;
+            const double axis[3] = { radius * std::cos(azimuth) * angle, radius * std::sin(azimuth) * angle, z * angle };
+            transform = posemath::multiply(rotationAbout(axis, centroid), initial);
+        }
+
+        runIcp(sorted, transform, options, run);
+        if (run.rmsMM < best.rmsMM) {
+            best.transform = run.transform;
+            best.converged = run.converged;
+            best.rmsMM = run.rmsMM;
+            best.inliers = run.inliers;
+            best.iterations = run.iterations;
+            result.start = start;
+        }
+    }
+
+    if (best.inliers < 3) {
+        return AtracsysStatus(AtracsysStatusCode::RegistrationFailed);
+    }
+    result.converged = best.converged;
+    result.transform = best.transform;
+    result.rmsMM = best.rmsMM;
+    result.inliers = best.inliers;
+    result.iterations = best.iterations;
+    return AtracsysStatus();
+}
+
+void AtracsysSurfaceRegistration::runIcp(const std::vector<Point>& points, const Transform& start,
+                                         const AtracsysIcpOptions& options, Run& run) const {
+    const size_t count = points.size();
+    const size_t tasks = (count + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+    run.transform = start;
+    run.converged = false;
+    run.iterations = 0;
+    run.moved.resize(count);
+    run.closest.resize(count);
+    run.normals.resize(count);
+    run.distances.resize(count);
+    run.hints.assign(count, uint32_t(MeshBvh::NO_TRIANGLE));
+    run.taskReach.resize(tasks);
+    run.taskSums.resize(tasks);
+
+    const size_t keep = std::max<size_t>(3, std::min(count, size_t(std::ceil(options.inlierFraction * double(count)))));
+    const float maxDistanceSquared = options.maxDistanceMM > 0.f ? options.maxDistanceMM * options.maxDistanceMM
+                                                                 : std::numeric_limits<float>::max();
+
+    // Closest points in parallel, then the trimmed inlier set; returns the largest |p| seen.
+    auto correspond = [&]() {
+        pool->parallelFor(tasks, [&](size_t task) {
+            float reach = 0.f;
+            const size_t last = std::min(count, (task + 1) * POINTS_PER_TASK);
+            for (size_t i = task * POINTS_PER_TASK; i < last; ++i) {
+                run.moved[i] = posemath::transformPoint(run.transform, points[i]);
+                MeshBvh::Hit hit;
+                if (!bvh->closest(run.moved[i], run.hints[i], hit)) {
+                    // Above any threshold, so the point never enters the inlier set.
+                    run.distances[i] = std::numeric_limits<float>::infinity();
+                    continue;
+                }
+                run.hints[i] = hit.triangle;
+                run.closest[i] = hit.point;
+                run.normals[i] = hit.normal;
+                run.distances[i] = hit.distanceSquared;
+                const Point& p = run.moved[i];
+                reach = std::max(reach, p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+            }
+            run.taskReach[task] = reach;
+        });
+
+        run.sorted = run.distances;
+        std::nth_element(run.sorted.begin(), run.sorted.begin() + (keep - 1), run.sorted.end());
+        const float threshold = std::min(run.sorted[keep - 1], maxDistanceSquared);
+        run.selected.clear();
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            if (run.distances[i] <= threshold) {
+                run.selected.push_back(uint32_t(i));
+                sum += run.distances[i];
+            }
+        }
+        run.inliers = run.selected.size();
+        run.rmsMM = run.inliers > 0 ? float(std::sqrt(sum / double(run.inliers))) : std::numeric_limits<float>::max();
+        return std::sqrt(*std::max_element(run.taskReach.begin(), run.taskReach.end()));
+    };
+
+    for (;;) {
+        const float reach = correspond();
+        if (run.iterations == options.maxIterations || run.inliers < 3) {
+            break;
+        }
+        ++run.iterations;
+
+        Transform step;
+        bool solved = false;
+        if (options.metric == AtracsysIcpMetric::PointToPlane) {
+            // Linearised n . (p + w x p + t - q) = 0 about the inlier centroid, for conditioning.
+            double center[3] = { 0.0, 0.0, 0.0 };
+            for (uint32_t i : run.selected) {
+                for (int k = 0; k < 3; ++k) {
+                    center[k] += run.moved[i][k];
+                }
+            }
+            for (int k = 0; k < 3; ++k) {
+                center[k] /= double(run.selected.size());
+            }
+
+            const size_t selectedTasks = (run.selected.size() + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+            pool->parallelFor(selectedTasks, [&](size_t task) {
+                // Upper triangle of J^T J (21 entries), then J^T r (6 entries).
+                std::array<double, 28>& sums = run.taskSums[task];
+                sums.fill(0.0);
+                const size_t last = std::min(run.selected.size(), (task + 1) * POINTS_PER_TASK);
+                for (size_t s = task * POINTS_PER_TASK; s < last; ++s) {
+                    const uint32_t i = run.selected[s];
+                    const double p[3] = { run.moved[i][0] - center[0], run.moved[i][1] - center[1], run.moved[i][2] - center[2] };
+                    const double n[3] = { run.normals[i][0], run.normals[i][1], run.normals[i][2] };
+                    const double j[6] = { p[1] * n[2] - p[2] * n[1], p[2] * n[0] - p[0] * n[2], p[0] * n[1] - p[1] * n[0],
+                                          n[0], n[1], n[2] };
+                    const double r = n[0] * (run.moved[i][0] - run.closest[i][0]) +
+                                     n[1] * (run.moved[i][1] - run.closest[i][1]) +
+                                     n[2] * (run.moved[i][2] - run.closest[i][2]);
+                    int entry = 0;
+                    for (int a = 0; a < 6; ++a) {
+                        for (int b = a; b < 6; ++b) {
+                            sums[entry++] += j[a] * j[b];
+                        }
+                        sums[21 + a] += j[a] * r;
+                    }
+                }
+            });
+
+            double m[6][6] = {};
+            double rhs[6] = {};
+            for (size_t task = 0; task < selectedTasks; ++task) {
+                const std::array<double, 28>& sums = run.taskSums[task];
+                int entry = 0;
+                for (int a = 0; a < 6; ++a) {
+                    for (int b = a; b < 6; ++b) {
+                        m[a][b] += sums[entry];
+                        m[b][a] = m[a][b];
+                        ++entry;
+                    }
+                    rhs[a] -= sums[21 + a];
+                }
+            }
+            double trace = 0.0;
+            for (int a = 0; a < 6; ++a) {
+                trace += m[a][a];
+            }
+            for (int a = 0; a < 6; ++a) {
+                m[a][a] += PLANE_DAMPING * trace;
+            }
+
+            double x[6];
+            if (solveLinear<6>(m, rhs, x)) {
+                step = rotationAbout(x, center);
+                for (int k = 0; k < 3; ++k) {
+                    step[k][3] += float(x[3 + k]);
+                }
+                solved = true;
+            }
+        }
+        if (!solved && !fitRigid(run.moved.data(), run.closest.data(), run.selected.data(), run.selected.size(), step)) {
+            break;
+        }
+        run.transform = posemath::multiply(step, run.transform);
+
+        // Largest displacement the step can cause: |t| + angle * |p|.
+        const double trace = double(step[0][0]) + step[1][1] + step[2][2];
+        const double angle = std::acos(std::max(-1.0, std::min(1.0, 0.5 * (trace - 1.0))));
+        const double translation = std::sqrt(double(step[0][3]) * step[0][3] + double(step[1][3]) * step[1][3] +
+                                             double(step[2][3]) * step[2][3]);
+        if (translation + angle * reach < options.convergenceMM) {
+            run.converged = true;
+            correspond();
+            break;
+        }
+    }
+}
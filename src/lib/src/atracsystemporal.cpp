@@ -0,0 +1,249 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsystemporal.h"
+#include "posemath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+const double PI = 3.14159265358979323846;
+// Keeps a bogus timestamp from allocating gigabytes of grid.
+const size_t MAX_GRID_SAMPLES = size_t(1) << 24;
+// Fewer overlapping samples than this cannot give a meaningful peak.
+const size_t MIN_GRID_SAMPLES = 64;
+
+struct Speed {
+    double timeUS;
+    double value;
+};
+
+// Motion magnitude between consecutive samples, stamped at their midpoint.
+template<typename Sample>
+std::vector<Speed> speeds(std::vector<Sample> samples, double rotationScale) {
+    std::sort(samples.begin(), samples.end(),
+              [](const Sample& a, const Sample& b) { return a.timestampUS < b.timestampUS; });
+
+    std::vector<Speed> result;
+    result.reserve(samples.size());
+    for (size_t i = 1; i < samples.size(); ++i) {
+        const Sample& a = samples[i - 1];
+        const Sample& b = samples[i];
+        if (b.timestampUS == a.timestampUS) {
+            continue;
+        }
+        const double seconds = double(b.timestampUS - a.timestampUS) * 1e-6;
+
+        double distance = 0.0;
+        double trace = 0.0;
+        for (int row = 0; row < 3; ++row) {
+            const double d = double(b.pose[row][3]) - a.pose[row][3];
+            distance += d * d;
+            for (int k = 0; k < 3; ++k) {
+                trace += double(a.pose[k][row]) * b.pose[k][row];
+            }
+        }
+        const double angle = std::acos(std::max(-1.0, std::min(1.0, 0.5 * (trace - 1.0))));
+        result.push_back({ 0.5 * (double(a.timestampUS) + double(b.timestampUS)),
+                           (std::sqrt(distance) + rotationScale * angle) / seconds });
+    }
+    return result;
+}
+
+// Linear resampling; grid points outside the signal stay NaN.
+std::vector<double> resample(const std::vector<Speed>& signal, double startUS, double stepUS, size_t count) {
+    std::vector<double> grid(count, std::nan(""));
+    size_t next = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double time = startUS + double(i) * stepUS;
+        while (next < signal.size() && signal[next].timeUS < time) {
+            ++next;
+        }
+        if (next == 0 || next == signal.size()) {
+            if (next < signal.size() && signal[next].timeUS == time) {
+                grid[i] = signal[next].value;
+            }
+            continue;
+        }
+        const Speed& a = signal[next - 1];
+        const Speed& b = signal[next];
+        grid[i] = a.value + (b.value - a.value) * (time - a.timeUS) / (b.timeUS - a.timeUS);
+    }
+    return grid;
+}
+
+// Zero mean, unit energy over the covered points; uncovered points become 0.
+bool normalise(std::vector<double>& grid) {
+    double sum = 0.0;
+    size_t covered = 0;
+    for (double value : grid) {
+        if (!std::isnan(value)) {
+            sum += value;
+            ++covered;
+        }
+    }
+    if (covered < MIN_GRID_SAMPLES) {
+        return false;
+    }
+    const double mean = sum / double(covered);
+    double energy = 0.0;
+    for (double& value : grid) {
+        value = std::isnan(value) ? 0.0 : value - mean;
+        energy += value * value;
+    }
+    if (energy <= 0.0) {
+        return false;
+    }
+    const double scale = 1.0 / std::sqrt(energy);
+    for (double& value : grid) {
+        value *= scale;
+    }
+    return true;
+}
+
+// In-place iterative radix-2 FFT; `inverse` omits the 1/N scaling.
+void fft(std::vector<Complex>& data, bool inverse) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        const double angle = (inverse ? 2.0 : -2.0) * PI / double(length);
+        const Complex root(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += length) {
+            Complex twiddle(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                const Complex even = data[start + k];
+                const Complex odd = data[start + k + length / 2] * twiddle;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                twiddle *= root;
+            }
+        }
+    }
+}
+
+}
+
+void AtracsysTemporalCalibration::addTrackerPose(uint64_t timestampUS, const Transform& pose) {
+    tracker.push_back({ timestampUS, pose });
+}
+
+void AtracsysTemporalCalibration::addTrackerFrame(const AtracsysFrame& frame, uint32_t geometryId) {
+    const AtracsysPose* pose = frame.findPose(geometryId);
+    if (pose != nullptr) {
+        addTrackerPose(frame.timestampUS, pose->transform);
+    }
+}
+
+void AtracsysTemporalCalibration::addExternalPose(uint64_t timestampUS, const Transform& pose) {
+    external.push_back({ timestampUS, pose });
+}
+
+void AtracsysTemporalCalibration::addExternalPosition(uint64_t timestampUS, float position) {
+    Transform pose = posemath::identity();
+    pose[0][3] = position;
+    external.push_back({ timestampUS, pose });
+}
+
+void AtracsysTemporalCalibration::clear() {
+    tracker.clear();
+    external.clear();
+}
+
+AtracsysStatus AtracsysTemporalCalibration::solve(const AtracsysTemporalOptions& options,
+                                                  AtracsysTemporalResult& result) const {
+    result = AtracsysTemporalResult();
+    const AtracsysStatus notSolved(AtracsysStatusCode::CalibrationNotSolved);
+    if (options.sampleRateHz <= 0.f || options.maxOffsetMS < 0.f) {
+        return notSolved;
+    }
+
+    const std::vector<Speed> a = speeds(tracker, options.rotationScaleMM);
+    const std::vector<Speed> b = speeds(external, options.rotationScaleMM);
+    if (a.size() < 2 || b.size() < 2) {
+        return notSolved;
+    }
+
+    // Overlap widened by the largest offset searched, so shifted features stay on the grid.
+    const double stepUS = 1e6 / options.sampleRateHz;
+    const double maxOffsetUS = options.maxOffsetMS * 1e3;
+    const double startUS = std::max(a.front().timeUS, b.front().timeUS) - maxOffsetUS;
+    const double endUS = std::min(a.back().timeUS, b.back().timeUS) + maxOffsetUS;
+    if (endUS <= startUS || (endUS - startUS) / stepUS >= double(MAX_GRID_SAMPLES)) {
+        return notSolved;
+    }
+    const size_t count = size_t((endUS - startUS) / stepUS) + 1;
+    const size_t maxLag = std::min(count - 1, size_t(maxOffsetUS / stepUS));
+
+    std::vector<double> x = resample(a, startUS, stepUS, count);
+    std::vector<double> y = resample(b, startUS, stepUS, count);
+    if (!normalise(x) || !normalise(y)) {
+        return notSolved;
+    }
+
+    // Both real signals go through one complex FFT: z = x + iy.
+    size_t size = 1;
+    while (size < count + maxLag) {
+        size <<= 1;
+    }
+    std::vector<Complex> z(size, Complex(0.0, 0.0));
+    for (size_t i = 0; i < count; ++i) {
+        z[i] = Complex(x[i], y[i]);
+    }
+    fft(z, false);
+
+    // X = (Z[k] + conj Z[-k]) / 2, Y = (Z[k] - conj Z[-k]) / 2i; correlation spectrum conj(X) * Y.
+    std::vector<Complex> spectrum(size);
+    for (size_t k = 0; k < size; ++k) {
+        const Complex mirrored = std::conj(z[(size - k) & (size - 1)]);
+        const Complex fx = 0.5 * (z[k] + mirrored);
+        const Complex fy = Complex(0.0, -0.5) * (z[k] - mirrored);
+        spectrum[k] = std::conj(fx) * fy;
+    }
+    fft(spectrum, true);
+
+    // c[lag] = sum x[n] y[n + lag]; negative lags wrap around to the end.
+    auto correlation = [&](long lag) {
+        return spectrum[size_t(lag + long(size)) & (size - 1)].real() / double(size);
+    };
+    long peak = 0;
+    double best = correlation(0);
+    for (long lag = -long(maxLag); lag <= long(maxLag); ++lag) {
+        const double value = correlation(lag);
+        if (value > best) {
+            best = value;
+            peak = lag;
+        }
+    }
+
+    double fraction = 0.0;
+    if (peak > -long(maxLag) && peak < long(maxLag)) {
+        const double before = correlation(peak - 1);
+        const double after = correlation(peak + 1);
+        const double curvature = before - 2.0 * best + after;
+        if (curvature < 0.0) {
+            fraction = 0.5 * (before - after) / curvature;
+        }
+    }
+
+    // A feature at tracker time t shows up in the external stream at t + lag.
+    result.offsetUS = -(double(peak) + fraction) * stepUS;
+    result.correlation = float(best);
+    result.gridSamples = count;
+    result.solved = true;
+    return AtracsysStatus();
+}
@@ -0,0 +1,201 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "atracsyswrapper/atracsystransformgraph.h"
+#include "posemath.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+const uint32_t NO_EDGE = UINT32_MAX;
+}
+
+AtracsysTransformGraph::NodeId AtracsysTransformGraph::addNode(const std::string& name) {
+    auto found = names.find(name);
+    if (found != names.end()) {
+        return found->second;
+    }
+    const NodeId id = NodeId(adjacency.size());
+    names.emplace(name, id);
+    adjacency.emplace_back();
+    return id;
+}
+
+AtracsysTransformGraph::NodeId AtracsysTransformGraph::findNode(const std::string& name) const {
+    auto found = names.find(name);
+    return found != names.end() ? found->second : INVALID_NODE;
+}
+
+uint32_t AtracsysTransformGraph::findEdge(NodeId child, NodeId parent) const {
+    for (const Step& step : adjacency[child]) {
+        const Edge& edge = edges[step.edge];
+        if (edge.child == child && edge.parent == parent) {
+            return step.edge;
+        }
+    }
+    return NO_EDGE;
+}
+
+uint32_t AtracsysTransformGraph::addEdge(NodeId child, NodeId parent) {
+    const uint32_t index = uint32_t(edges.size());
+    Edge edge{};
+    edge.child = child;
+    edge.parent = parent;
+    edge.transform = posemath::identity();
+    edges.push_back(edge);
+    adjacency[child].push_back({ index, true });
+    adjacency[parent].push_back({ index, false });
+    // Every cached path may now have a shorter alternative.
+    ++structure;
+    return index;
+}
+
+void AtracsysTransformGraph::setStaticEdge(const std::string& child, const std::string& parent,
+                                           const Transform& childToParent) {
+    const NodeId childId = addNode(child);
+    const NodeId parentId = addNode(parent);
+    uint32_t index = findEdge(childId, parentId);
+    if (index == NO_EDGE) {
+        index = addEdge(childId, parentId);
+    }
+
+    Edge& edge = edges[index];
+    edge.transform = childToParent;
+    edge.tracked = false;
+    edge.valid = true;
+    ++edge.version;
+}
+
+void AtracsysTransformGraph::addTrackedEdge(const std::string& marker, const std::string& camera, uint32_t geometryId) {
+    const NodeId markerId = addNode(marker);
+    const NodeId cameraId = addNode(camera);
+    uint32_t index = findEdge(markerId, cameraId);
+    if (index == NO_EDGE) {
+        index = addEdge(markerId, cameraId);
+    }
+
+    Edge& edge = edges[index];
+    if (!edge.tracked) {
+        trackedEdges.push_back(index);
+    }
+    edge.tracked = true;
+    edge.valid = false;
+    edge.geometryId = geometryId;
+    ++edge.version;
+}
+
+void AtracsysTransformGraph::update(const AtracsysFrame& frame) {
+    for (uint32_t index : trackedEdges) {
+        Edge& edge = edges[index];
+        const AtracsysPose* pose = frame.findPose(edge.geometryId);
+        if (pose != nullptr) {
+            edge.transform = pose->transform;
+            edge.valid = true;
+            ++edge.version;
+        }
+        else if (edge.valid) {
+            edge.valid = false;
+            ++edge.version;
+        }
+    }
+}
+
+bool AtracsysTransformGraph::findPath(NodeId from, NodeId to, std::vector<Step>& path) const {
+    // Breadth-first: every edge costs the same, so the first hit is a shortest path.
+    std::vector<Step> reachedBy(adjacency.size(), Step{ NO_EDGE, false });
+    std::vector<bool> visited(adjacency.size(), false);
+    std::deque<NodeId> queue;
+    visited[from] = true;
+    queue.push_back(from);
+
+    while (!queue.empty() && !visited[to]) {
+        const NodeId node = queue.front();
+        queue.pop_front();
+        for (const Step& step : adjacency[node]) {
+            const Edge& edge = edges[step.edge];
+            const NodeId next = step.forward ? edge.parent : edge.child;
+            if (!visited[next]) {
+                visited[next] = true;
+                reachedBy[next] = step;
+                queue.push_back(next);
+            }
+        }
+    }
+    if (!visited[to]) {
+        return false;
+    }
+
+    path.clear();
+    for (NodeId node = to; node != from;) {
+        const Step step = reachedBy[node];
+        path.push_back(step);
+        const Edge& edge = edges[step.edge];
+        node = step.forward ? edge.child : edge.parent;
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+bool AtracsysTransformGraph::compose(CacheEntry& entry) const {
+    entry.versions.resize(entry.path.size());
+    entry.composed = true;
+    entry.valid = true;
+
+    Transform result = posemath::identity();
+    for (size_t i = 0; i < entry.path.size(); ++i) {
+        const Step& step = entry.path[i];
+        const Edge& edge = edges[step.edge];
+        entry.versions[i] = edge.version;
+        if (!edge.valid) {
+            entry.valid = false;
+            continue;
+        }
+        // Forward steps go child -> parent with the edge transform, backward ones with its inverse.
+        result = posemath::multiply(step.forward ? edge.transform : posemath::inverse(edge.transform), result);
+    }
+    entry.result = result;
+    return entry.valid;
+}
+
+bool AtracsysTransformGraph::lookup(NodeId from, NodeId to, Transform& result) {
+    if (from >= adjacency.size() || to >= adjacency.size()) {
+        return false;
+    }
+    if (from == to) {
+        result = posemath::identity();
+        return true;
+    }
+
+    CacheEntry& entry = cache[(uint64_t(from) << 32) | to];
+    if (entry.structure != structure) {
+        entry.structure = structure;
+        entry.reachable = findPath(from, to, entry.path);
+        entry.composed = false;
+    }
+    if (!entry.reachable) {
+        return false;
+    }
+
+    bool fresh = entry.composed;
+    for (size_t i = 0; fresh && i < entry.path.size(); ++i) {
+        fresh = edges[entry.path[i].edge].version == entry.versions[i];
+    }
+
+    if (fresh) {
+        ++cacheHits;
+    }
+    else {
+        ++cacheMisses;
+        compose(entry);
+    }
+    if (entry.valid) {
+        result = entry.result;
+    }
+    return entry.valid;
+}
+
+bool AtracsysTransformGraph::lookup(const std::string& from, const std::string& to, Transform& result) {
+    return lookup(findNode(from), findNode(to), result);
+}
@@ -3,104 +3,465 @@
 //
 
 #include "atracsyswrapperimpl.h"
+#include "atracsyswrapper/atracsysrawframe.h"
 #include "helpers.hpp"
 #include "geometryHelper.hpp"
 #include "atracsyswrapper/atracsysmarker.h"
+#include "realtime.h"
+#include "posemath.h"
+
+#include <algorithm>
+#include <chrono>
+
+static_assert(MarkerMatcher::MAX_GEOMETRIES <= AtracsysFrame::MAX_POSES, "every host match must fit in a frame");
+
+namespace {
+
+// How often the image thread checks that it should stop when no frame comes.
+const uint32_t IMAGE_WAIT_MS = 100;
+
+uint64_t steadyMicroseconds() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct ParsedGeometry {
+    ftkGeometry geometry{};
+    GeometryPivot pivot{};
+    bool parsed = false;
+};
+
+// The local file only; the installation directory needs the device.
+void parseGeometries(const std::vector<AtracsysStartupGeometry>& files, std::vector<ParsedGeometry>& parsed) {
+    parsed.resize(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::ifstream input(files[i].filename.c_str());
+        parsed[i].parsed = !input.fail() && loadFile(input, parsed[i].geometry, &parsed[i].pivot);
+    }
+}
+
+}
 
 AtracsysWrapperImpl::AtracsysWrapperImpl()
         : AtracsysWrapper(),
         library(nullptr),
-          device(nullptr) {
+          device(nullptr),
+          frame(nullptr),
+          frameChannel(std::make_shared<FrameChannel>()),
+          rateFanout(std::make_shared<RateFanout>()) {
+    addFrameListener(frameChannel.get());
+    addFrameListener(rateFanout.get());
+    addFrameListener(&poseHistory);
+    addFrameListener(&pivotCalibration);
+    addFrameListener(&digitizer);
+    addFrameListener(&surface);
 }
 
 AtracsysWrapperImpl::~AtracsysWrapperImpl() {
-	ftkDeleteFrame(frame);
+    stopAcquisition();
+    frameChannel->close();
+    rateFanout->close();
+    stopPoseMulticast();
+    stopSharedMemoryPublisher();
+    stopMetricsServer();
+    stopTrackking();
+
+    if (library != nullptr && FTK_OK != ftkClose(&library)) {
+        report(AtracsysStatus(AtracsysStatusCode::CloseFailed));
+    }
+}
+
+AtracsysStatus AtracsysWrapperImpl::init() {
+    AtracsysStatus status = initLibrary();
+    if (status) {
+        status = initDevice();
+    }
+    if (status) {
+        status = applyDeviceOptions();
+    }
+    return report(status);
+}
+
+std::future<AtracsysStartupReport> AtracsysWrapperImpl::initAsync(const AtracsysStartupOptions& options) {
+    return std::async(std::launch::async, [this, options]() {
+        return startup(options);
+    });
+}
+
+AtracsysStartupReport AtracsysWrapperImpl::startup(const AtracsysStartupOptions& options) {
+    AtracsysStartupReport result;
+    AtracsysStartupTimings& timings = result.timings;
+    const uint64_t startUS = steadyMicroseconds();
+
+    std::vector<ParsedGeometry> parsed;
+    std::future<void> parsing = std::async(std::launch::async, [&options, &parsed, &timings]() {
+        const uint64_t phaseUS = steadyMicroseconds();
+        parseGeometries(options.geometries, parsed);
+        timings.geometryParsingUS = steadyMicroseconds() - phaseUS;
+    });
+
+    uint64_t phaseUS = steadyMicroseconds();
+    result.status = initLibrary();
+    timings.libraryUS = steadyMicroseconds() - phaseUS;
+
+    // The frame only needs the library; it is sized while the USB bus is enumerated.
+    std::future<AtracsysStatus> allocation;
+    if (result.status && options.startTracking) {
+        const FrameLayout layout = getFrameLayout();
+        allocation = std::async(std::launch::async, [this, layout, &timings]() {
+            const uint64_t allocationUS = steadyMicroseconds();
+            const AtracsysStatus status = allocateFrame(layout);
+            timings.frameAllocationUS = steadyMicroseconds() - allocationUS;
+            return status;
+        });
+    }
+
+    if (result.status) {
+        phaseUS = steadyMicroseconds();
+        result.status = initDevice();
+        timings.enumerationUS = steadyMicroseconds() - phaseUS;
+    }
+    if (result.status) {
+        phaseUS = steadyMicroseconds();
+        result.status = applyDeviceOptions();
+        timings.optionsUS = steadyMicroseconds() - phaseUS;
+    }
+
+    parsing.wait();
+    if (allocation.valid()) {
+        const AtracsysStatus status = allocation.get();
+        if (result.status) {
+            result.status = status;
+        }
+    }
+
+    if (result.status) {
+        phaseUS = steadyMicroseconds();
+        for (size_t i = 0; i < options.geometries.size() && result.status; ++i) {
+            const AtracsysStartupGeometry& file = options.geometries[i];
+            if (!parsed[i].parsed) {
+                result.status = loadGeometryFile(file.filename, file.geometryId);
+                continue;
+            }
+            const std::array<float, 3> tip = { { parsed[i].pivot.position.x, parsed[i].pivot.position.y,
+                                                 parsed[i].pivot.position.z } };
+            result.status = registerGeometry(parsed[i].geometry, parsed[i].pivot.present ? &tip : nullptr,
+                                             file.filename, file.geometryId);
+        }
+        timings.geometryUploadUS = steadyMicroseconds() - phaseUS;
+    }
+
+    const bool tracking = result.status && options.startTracking;
+    if (tracking) {
+        phaseUS = steadyMicroseconds();
+        result.status = startTracking();
+        timings.trackingUS = steadyMicroseconds() - phaseUS;
+    }
 
-    if (FTK_OK != ftkClose(&library)) {
-        checkError(library);
+    timings.totalUS = steadyMicroseconds() - startUS;
+    // startTracking() reports its own status.
+    if (!tracking) {
+        report(result.status);
     }
+    return result;
 }
 
-bool AtracsysWrapperImpl::init() {
+AtracsysStatus AtracsysWrapperImpl::initLibrary() {
     library = ftkInit();
     if (library == nullptr) {
-        return false;
+        return AtracsysStatus(AtracsysStatusCode::LibraryInitFailed);
     }
+    return AtracsysStatus();
+}
 
+AtracsysStatus AtracsysWrapperImpl::initDevice() {
     device = std::make_unique<AtracsysDevice>(library);
-    if (device->getType() == DEV_SPRYTRACK_180) {
-        device->setOnboardProcessing(true);
-        device->setSendingImages(false);
+    const AtracsysStatus status = device->init();
+    if (!status) {
+        device.reset();
+        return status;
     }
+    metrics.setSerialNumber(device->getSerialNumber());
+    return status;
+}
 
-    return true;
+AtracsysStatus AtracsysWrapperImpl::applyDeviceOptions() {
+    if (device->getType() != DEV_SPRYTRACK_180) {
+        return AtracsysStatus();
+    }
+    device->stageOption(DeviceOption::OnboardProcessing, 1);
+    device->stageOption(DeviceOption::SendingImages, 0);
+    return device->applyOptions();
 }
 
-bool AtracsysWrapperImpl::addGeometry(const std::string &filename, const std::string& geometryId) {
+AtracsysStatus AtracsysWrapperImpl::addGeometry(const std::string &filename, const std::string& geometryId) {
+    if (device == nullptr) {
+        return report(AtracsysStatus(AtracsysStatusCode::NotInitialised));
+    }
+    return report(loadGeometryFile(filename, geometryId));
+}
+
+AtracsysStatus AtracsysWrapperImpl::loadGeometryFile(const std::string& filename, const std::string& geometryId) {
     ftkGeometry geometry{};
-    bool success = false;
-    switch (loadGeometry(library, device->getSerialNumber(), filename, geometry)) {
+    GeometryPivot pivot{};
+    const int loaded = loadGeometry(library, device->getSerialNumber(), filename, geometry, &pivot);
+    switch (loaded) {
         case 1:            //cout << "Loaded from installation directory." << endl;
-        case 0:
-            if (ftkSetGeometry(library, device->getSerialNumber(), &geometry) != 0) {
-                //checkError(*library);
-            }
-            geometries[geometryId] = geometry;
-            markers[geometry.geometryId] = AtracsysMarker(geometry.geometryId);
-			markers[geometry.geometryId].setName(geometryId);
-            success = true;
-            break;
+        case 0: {
+            const std::array<float, 3> tip = { { pivot.position.x, pivot.position.y, pivot.position.z } };
+            // Files from the installation directory are not ours to rewrite.
+            return registerGeometry(geometry, pivot.present ? &tip : nullptr,
+                                    loaded == 0 ? filename : std::string(), geometryId);
+        }
         default:
-            success = false;
-            // error cannnot laod geometry file
+            return AtracsysStatus(AtracsysStatusCode::GeometryLoadFailed);
     }
-    return success;
 }
 
-bool AtracsysWrapperImpl::startTracking() {
-    frame = ftkCreateFrame();
-    if ( frame == nullptr)
+AtracsysStatus AtracsysWrapperImpl::registerGeometry(ftkGeometry& geometry, const std::array<float, 3>* tipMM,
+                                                     const std::string& filename, const std::string& geometryId) {
+    // Every per-geometry table holds MarkerMatcher::MAX_GEOMETRIES entries.
+    if (markers.find(geometry.geometryId) == markers.end() && markers.size() >= MarkerMatcher::MAX_GEOMETRIES) {
+        return AtracsysStatus(AtracsysStatusCode::TooManyGeometries);
+    }
+
+    // With host matching the device never needs to accept the geometry.
+    ftkError err = ftkSetGeometry(library, device->getSerialNumber(), &geometry);
+    if (err != FTK_OK && !matchingOptions.hostMatching) {
+        return AtracsysStatus(AtracsysStatusCode::GeometryUploadFailed, err);
+    }
+    geometries[geometryId] = geometry;
+    markers[geometry.geometryId] = AtracsysMarker(geometry.geometryId);
+    markers[geometry.geometryId].setName(geometryId);
+    if (metrics.registerGeometry(geometry.geometryId, geometryId) >= AcquisitionMetrics::MAX_GEOMETRIES) {
+        return AtracsysStatus(AtracsysStatusCode::TooManyGeometries);
+    }
+    if (poseHistoryCapacity >= 2 && !poseHistory.addTrack(geometry.geometryId, poseHistoryCapacity)) {
+        return AtracsysStatus(AtracsysStatusCode::TooManyGeometries);
+    }
+    if (!filename.empty()) {
+        geometryFiles[geometry.geometryId] = filename;
+    }
     {
-        return false;       //error( "Cannot create frame instance" );
+        std::array<std::array<float, 3>, FTK_MAX_FIDUCIALS> fiducials;
+        const size_t count = std::min<size_t>(geometry.pointsCount, FTK_MAX_FIDUCIALS);
+        for (size_t i = 0; i < count; ++i) {
+            fiducials[i] = { { geometry.positions[i].x, geometry.positions[i].y, geometry.positions[i].z } };
+        }
+        if (!tipOffsets.setGeometry(geometry.geometryId, fiducials.data(), count)) {
+            return AtracsysStatus(AtracsysStatusCode::TooManyGeometries);
+        }
+        if (!markerMatcher.addGeometry(geometry.geometryId, fiducials.data(), count) &&
+            matchingOptions.hostMatching) {
+            return AtracsysStatus(AtracsysStatusCode::GeometryUploadFailed);
+        }
+    }
+    if (tipMM != nullptr) {
+        tipOffsets.setTip(geometry.geometryId, *tipMM);
+    }
+    return AtracsysStatus();
+}
+
+void AtracsysWrapperImpl::setMatchingOptions(const AtracsysMatchingOptions& options) {
+    matchingOptions = options;
+}
+
+void AtracsysWrapperImpl::setRawDataOptions(const AtracsysRawDataOptions& options) {
+    rawDataOptions = options;
+}
+
+bool AtracsysWrapperImpl::getRawFrame(AtracsysRawFrame& frame) {
+    const std::shared_ptr<RawFramePool> pool = std::atomic_load(&rawFrames);
+    if (pool == nullptr || !rawFramesPublic.load(std::memory_order_acquire)) {
+        frame.release();
+        return false;
+    }
+    return pool->acquire(frame);
+}
+
+void AtracsysWrapperImpl::setImageOptions(const AtracsysImageOptions& options) {
+    imageOptions = options;
+}
+
+bool AtracsysWrapperImpl::pollImage(AtracsysImage& image) {
+    const std::shared_ptr<AtracsysImagePipeline> pipeline = std::atomic_load(&images);
+    return pipeline != nullptr && pipeline->poll(image);
+}
+
+bool AtracsysWrapperImpl::waitImage(AtracsysImage& image, uint32_t timeoutMs) {
+    const std::shared_ptr<AtracsysImagePipeline> pipeline = std::atomic_load(&images);
+    return pipeline != nullptr && pipeline->wait(image, timeoutMs);
+}
+
+AtracsysImageStats AtracsysWrapperImpl::getImageStats() const {
+    const std::shared_ptr<AtracsysImagePipeline> pipeline = std::atomic_load(&images);
+    AtracsysImageStats stats = pipeline != nullptr ? pipeline->getStats() : AtracsysImageStats();
+    stats.skipped = imagesSkipped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+AtracsysStatus AtracsysWrapperImpl::startTracking() {
+    if (device == nullptr) {
+        return report(AtracsysStatus(AtracsysStatusCode::NotInitialised));
+    }
+    // The acquisition thread reads the frame, the matcher and the pipelines set up here.
+    if (isAcquiring()) {
+        return report(AtracsysStatus(AtracsysStatusCode::AcquisitionRunning));
+    }
+
+    const FrameLayout layout = getFrameLayout();
+    hostMatching = matchingOptions.hostMatching;
+    markerMatcher.setOptions(matchingOptions);
+    hostFiducials.reserve(layout.matchedFiducials);
+
+    if (device->getType() == DEV_SPRYTRACK_180) {
+        const AtracsysStatus status = device->setSendingImages(imageOptions.enabled);
+        if (!status) {
+            return report(status);
+        }
+    }
+
+    const AtracsysStatus frameStatus = allocateFrame(layout);
+    if (!frameStatus) {
+        return report(frameStatus);
+    }
+
+    stopImageThread();
+    // The image thread pins one more buffer, the one it copies the pixels from.
+    std::shared_ptr<RawFramePool> pool;
+    if (rawDataOptions.enabled || layout.pixels) {
+        const uint32_t buffers = rawDataOptions.enabled ? rawDataOptions.buffers + (layout.pixels ? 1u : 0u) : 3u;
+        pool = std::make_shared<RawFramePool>();
+        const AtracsysStatus status = pool->create(buffers, layout.pixels, layout.blobs, layout.fiducials,
+                                                   layout.markers);
+        if (!status) {
+            return report(status);
+        }
+    }
+    std::shared_ptr<AtracsysImagePipeline> pipeline;
+    if (layout.pixels) {
+        pipeline = std::make_shared<AtracsysImagePipeline>(imageOptions);
+    }
+    rawFramesPublic.store(rawDataOptions.enabled, std::memory_order_release);
+    std::atomic_store(&rawFrames, pool);
+    std::atomic_store(&images, pipeline);
+    imagesSkipped.store(0, std::memory_order_relaxed);
+    if (pipeline != nullptr) {
+        startImageThread(pipeline, pool);
     }
 
-    ftkError err( ftkSetFrameOptions( false, false, 16u, 16u, 0u, 16u, frame ) );
+    // After the frame buffers exist, so they are locked as well.
+    if (realtimeOptions.lockMemory && !lockProcessMemory()) {
+        return report(AtracsysStatus(AtracsysStatusCode::MemoryLockFailed));
+    }
+    return report(AtracsysStatus());
+}
+
+AtracsysWrapperImpl::FrameLayout AtracsysWrapperImpl::getFrameLayout() const {
+    // Host matching only needs the 3D fiducials; otherwise only the device markers are read.
+    const bool host = matchingOptions.hostMatching;
+    const bool rawData = rawDataOptions.enabled;
+    FrameLayout layout;
+    layout.matchedFiducials = host ? std::min<uint32>(matchingOptions.maxFiducials, MarkerMatcher::MAX_FIDUCIALS) : 0u;
+    layout.pixels = imageOptions.enabled;
+    layout.blobs = rawData ? rawDataOptions.maxBlobs : 16u;
+    layout.fiducials = std::max<uint32>(layout.matchedFiducials, rawData ? rawDataOptions.maxFiducials : 0u);
+    layout.markers = host ? 0u : 16u;
+    return layout;
+}
 
+AtracsysStatus AtracsysWrapperImpl::allocateFrame(const FrameLayout& layout) {
+    if (frame == nullptr) {
+        frame = ftkCreateFrame();
+        frameSized = false;
+    }
+    if ( frame == nullptr)
+    {
+        return AtracsysStatus(AtracsysStatusCode::FrameAllocationFailed);
+    }
+    // Already sized, e.g. by initAsync() while the device was enumerated.
+    if (frameSized && layout == frameLayout) {
+        return AtracsysStatus();
+    }
+
+    ftkError err( ftkSetFrameOptions( layout.pixels, false, layout.blobs, layout.blobs, layout.fiducials,
+                                      layout.markers, frame ) );
     if ( err != FTK_OK )
     {
         ftkDeleteFrame( frame );
-//        checkError( *library );
+        frame = nullptr;
+        frameSized = false;
+        return AtracsysStatus(AtracsysStatusCode::FrameOptionsFailed, err);
     }
-    return true;
+    frameLayout = layout;
+    frameSized = true;
+    return AtracsysStatus();
 }
 
-bool AtracsysWrapperImpl::stopTrackking() {
-    return false;
+AtracsysStatus AtracsysWrapperImpl::stopTrackking() {
+    stopAcquisition();
+    stopImageThread();
+    rawFramesPublic.store(false, std::memory_order_release);
+    std::atomic_store(&rawFrames, std::shared_ptr<RawFramePool>());
+    std::atomic_store(&images, std::shared_ptr<AtracsysImagePipeline>());
+    if (frame != nullptr) {
+        ftkDeleteFrame(frame);
+        frame = nullptr;
+        frameSized = false;
+    }
+    return AtracsysStatus();
 }
 
-void AtracsysWrapperImpl::getMarkerPositions() {
+AtracsysStatus AtracsysWrapperImpl::getMarkerPositions() {
+    if (frame == nullptr) {
+        return report(AtracsysStatus(AtracsysStatusCode::NotTracking));
+    }
+
     ftkError err = ftkGetLastFrame(library, device->getSerialNumber(), frame, 100u );
     if ( err != FTK_OK )
     {
-        std::cout << "could not load frame" << std::endl;
-        return;
+        metrics.frameTimeout();
+        return report(AtracsysStatus(AtracsysStatusCode::FrameTimeout, err));
+    }
+    metrics.frameArrived(steadyMicroseconds());
+    metrics.frameAcquired();
+
+    currentFrame.index = frameIndex++;
+    currentFrame.timestampUS = frame->imageHeader != nullptr ? frame->imageHeader->timestampUS : 0u;
+    currentFrame.poseCount = 0;
+
+    const ftkMarker* frameMarkers = frame->markers;
+    uint32 markersCount = frame->markersCount;
+    if (hostMatching) {
+        // A truncated fiducial cloud would silently lose markers.
+        if (frame->threeDFiducialsStat == QS_ERR_OVERFLOW) {
+            metrics.markerOverflow();
+            return report(AtracsysStatus(AtracsysStatusCode::MarkerOverflow));
+        }
+        frameMarkers = hostMarkers.data();
+        markersCount = matchOnHost();
     }
 
-    if ( frame->markersCount == 0u )
+    if ( markersCount == 0u )
     {
-        std::cout << "no markers" << std::endl;
-        return;
+        metrics.frameWithoutMarkers();
+        publishFrame();
+        return report(AtracsysStatus(AtracsysStatusCode::NoMarkers));
     }
 
-    if ( frame->markersStat == QS_ERR_OVERFLOW )
+    if ( !hostMatching && frame->markersStat == QS_ERR_OVERFLOW )
     {
-        std::cout << "marker overflow" << std::endl;
-        return;
+        metrics.markerOverflow();
+        return report(AtracsysStatus(AtracsysStatusCode::MarkerOverflow));
     }
 
-    for ( uint32 i = 0; i < frame->markersCount; ++i )
+    const uint32_t reference = referenceGeometry.load(std::memory_order_relaxed);
+    AtracsysMarker::Transform referenceInverse;
+    bool referenceSeen = false;
+
+    for ( uint32 i = 0; i < markersCount; ++i )
     {
-        ftkMarker marker = frame->markers[i];
+        ftkMarker marker = frameMarkers[i];
 		AtracsysMarker& atrMarker = markers[marker.geometryId];
         atrMarker.setGeometryPresenceMask(marker.geometryPresenceMask);
         atrMarker.setRegistrationError(marker.registrationErrorMM);
@@ -116,10 +477,452 @@ void AtracsysWrapperImpl::getMarkerPositions() {
 		transform[1][3] = marker.translationMM[1];
 		transform[2][3] = marker.translationMM[2];
         atrMarker.setTransform(transform);
+        metrics.markerSeen(metrics.findGeometry(marker.geometryId), marker.registrationErrorMM);
+
+        if (marker.geometryId == reference) {
+            referenceInverse = posemath::inverse(transform);
+            referenceSeen = true;
+        }
+
+        if (currentFrame.poseCount < AtracsysFrame::MAX_POSES) {
+            AtracsysPose& pose = currentFrame.poses[currentFrame.poseCount++];
+            pose.geometryId = marker.geometryId;
+            pose.geometryPresenceMask = marker.geometryPresenceMask;
+            pose.registrationErrorMM = marker.registrationErrorMM;
+            pose.transform = transform;
+
+            std::array<float, 3> tip;
+            float uncertaintyScale;
+            pose.hasTip = tipOffsets.getTip(marker.geometryId, tip, uncertaintyScale);
+            pose.hasReferenceTip = false;
+            pose.tipUncertaintyMM = 0.f;
+            if (pose.hasTip) {
+                pose.tipMM = posemath::transformPoint(transform, tip);
+                pose.tipUncertaintyMM = uncertaintyScale * marker.registrationErrorMM;
+                if (referenceSeen) {
+                    pose.tipInReferenceMM = posemath::transformPoint(referenceInverse, pose.tipMM);
+                    pose.hasReferenceTip = true;
+                }
+            }
+        }
+    }
+
+    // Tools listed before the reference marker get their reference tip now.
+    if (referenceSeen) {
+        for (uint32_t i = 0; i < currentFrame.poseCount; ++i) {
+            AtracsysPose& pose = currentFrame.poses[i];
+            if (pose.hasTip && !pose.hasReferenceTip) {
+                pose.tipInReferenceMM = posemath::transformPoint(referenceInverse, pose.tipMM);
+                pose.hasReferenceTip = true;
+            }
+        }
+    }
+    publishFrame();
+    return report(AtracsysStatus());
+}
+
+uint32_t AtracsysWrapperImpl::matchOnHost() {
+    // Within the capacity reserved by startTracking(), so no allocation.
+    hostFiducials.resize(std::min<size_t>(frame->threeDFiducialsCount, hostFiducials.capacity()));
+    for (size_t i = 0; i < hostFiducials.size(); ++i) {
+        const ftk3DPoint& position = frame->threeDFiducials[i].positionMM;
+        hostFiducials[i] = { { position.x, position.y, position.z } };
+    }
+
+    const size_t found = markerMatcher.match(hostFiducials.data(), hostFiducials.size(), hostMatches.data(),
+                                             hostMatches.size());
+    for (size_t i = 0; i < found; ++i) {
+        const MarkerMatcher::Match& match = hostMatches[i];
+        ftkMarker& marker = hostMarkers[i];
+        marker = ftkMarker();
+        marker.id = uint32(i);
+        marker.geometryId = match.geometryId;
+        marker.geometryPresenceMask = match.presenceMask;
+        for (size_t k = 0; k < FTK_MAX_FIDUCIALS; ++k) {
+            marker.fiducialCorresp[k] = k < match.fiducials.size() ? match.fiducials[k] : MarkerMatcher::NO_FIDUCIAL;
+        }
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                marker.rotation[row][column] = match.transform[row][column];
+            }
+            marker.translationMM[row] = match.transform[row][3];
+        }
+        marker.registrationErrorMM = match.registrationErrorMM;
     }
+    return uint32_t(found);
 }
 
 const std::map<size_t, AtracsysMarker>& AtracsysWrapperImpl::getMarkers() const
 {
 	return markers;
 }
+
+AtracsysStatus AtracsysWrapperImpl::getLastStatus() const {
+    return errors.getLast();
+}
+
+uint64_t AtracsysWrapperImpl::getErrorCount(AtracsysStatusCode code) const {
+    return errors.getCount(code);
+}
+
+uint64_t AtracsysWrapperImpl::getFtkErrorCount(int32_t ftkError) const {
+    return errors.getFtkCount(ftkError);
+}
+
+std::string AtracsysWrapperImpl::getLastErrorString() const {
+    if (library == nullptr) {
+        return "Uninitialised library handle";
+    }
+
+    char message[ 1024u ];
+    if (ftkGetLastErrorString(library, sizeof(message), message) != FTK_OK) {
+        return "Cannot retrieve the last error string";
+    }
+    return message;
+}
+
+std::string AtracsysWrapperImpl::getMetricsText() const {
+    return metrics.toPrometheus(errors);
+}
+
+bool AtracsysWrapperImpl::startMetricsServer(uint16_t port) {
+    stopMetricsServer();
+    metricsServer = std::make_unique<MetricsServer>([this]() { return getMetricsText(); });
+    if (!metricsServer->start(port)) {
+        metricsServer.reset();
+        return false;
+    }
+    return true;
+}
+
+void AtracsysWrapperImpl::stopMetricsServer() {
+    if (metricsServer != nullptr) {
+        metricsServer->stop();
+        metricsServer.reset();
+    }
+}
+
+void AtracsysWrapperImpl::setRealtimeOptions(const AtracsysRealtimeOptions& options) {
+    realtimeOptions = options;
+}
+
+AtracsysStatus AtracsysWrapperImpl::startAcquisition() {
+    if (frame == nullptr) {
+        return report(AtracsysStatus(AtracsysStatusCode::NotTracking));
+    }
+    if (isAcquiring()) {
+        return AtracsysStatus();
+    }
+
+    ThreadSchedule schedule;
+    switch (realtimeOptions.policy) {
+        case AtracsysRealtimeOptions::Policy::Fifo:
+            schedule.policy = ThreadSchedule::POLICY_FIFO;
+            break;
+        case AtracsysRealtimeOptions::Policy::RoundRobin:
+            schedule.policy = ThreadSchedule::POLICY_ROUND_ROBIN;
+            break;
+        case AtracsysRealtimeOptions::Policy::Inherit:
+            break;
+    }
+    schedule.priority = realtimeOptions.priority;
+    schedule.cpus = realtimeOptions.cpus;
+
+    acquisitionThread.reset(createThread(&AtracsysWrapperImpl::acquisitionLoop));
+    acquisitionThread->setSchedule(schedule);
+    acquiring.store(true, std::memory_order_release);
+    if (!acquisitionThread->start(this)) {
+        acquiring.store(false, std::memory_order_release);
+        acquisitionThread.reset();
+        return report(AtracsysStatus(AtracsysStatusCode::ThreadStartFailed));
+    }
+    return report(AtracsysStatus());
+}
+
+void AtracsysWrapperImpl::stopAcquisition() {
+    if (acquisitionThread == nullptr) {
+        return;
+    }
+    acquiring.store(false, std::memory_order_release);
+    acquisitionThread->stop();
+    acquisitionThread.reset();
+}
+
+bool AtracsysWrapperImpl::isAcquiring() const {
+    return acquiring.load(std::memory_order_acquire);
+}
+
+AtracsysJitterStats AtracsysWrapperImpl::getJitterStats() const {
+    return metrics.getJitter();
+}
+
+bool AtracsysWrapperImpl::acquisitionLoop(const Thread& /*owner*/, void* userData) {
+    AtracsysWrapperImpl* wrapper = static_cast<AtracsysWrapperImpl*>(userData);
+    if (wrapper->realtimeOptions.lockMemory) {
+        prefaultStack(wrapper->realtimeOptions.prefaultStackBytes);
+    }
+    while (wrapper->acquiring.load(std::memory_order_acquire)) {
+        // Blocks in ftkGetLastFrame() for at most 100 ms, which bounds stop latency.
+        wrapper->getMarkerPositions();
+    }
+    return true;
+}
+
+AtracsysStatus AtracsysWrapperImpl::startPivotCalibration(uint32_t geometryId, float rejectionFactor) {
+    if (markers.find(geometryId) == markers.end()) {
+        return report(AtracsysStatus(AtracsysStatusCode::UnknownGeometry));
+    }
+    pivotCalibration.start(geometryId, rejectionFactor);
+    return report(AtracsysStatus());
+}
+
+void AtracsysWrapperImpl::stopPivotCalibration() {
+    pivotCalibration.stop();
+}
+
+bool AtracsysWrapperImpl::getPivotCalibration(AtracsysPivotCalibration& calibration) const {
+    return pivotCalibration.getResult(calibration);
+}
+
+AtracsysStatus AtracsysWrapperImpl::applyPivotCalibration() {
+    AtracsysPivotCalibration calibration;
+    if (!pivotCalibration.getResult(calibration) || !calibration.solved) {
+        return report(AtracsysStatus(AtracsysStatusCode::CalibrationNotSolved));
+    }
+    tipOffsets.setTip(calibration.geometryId, calibration.tipMM);
+
+    auto file = geometryFiles.find(calibration.geometryId);
+    if (file == geometryFiles.end()) {
+        return report(AtracsysStatus(AtracsysStatusCode::GeometrySaveFailed));
+    }
+    const ftk3DPoint tip = { calibration.tipMM[0], calibration.tipMM[1], calibration.tipMM[2] };
+    if (!savePivot(file->second, tip)) {
+        return report(AtracsysStatus(AtracsysStatusCode::GeometrySaveFailed));
+    }
+    return report(AtracsysStatus());
+}
+
+AtracsysStatus AtracsysWrapperImpl::setTipOffset(uint32_t geometryId, const std::array<float, 3>& tipMM) {
+    if (!tipOffsets.setTip(geometryId, tipMM)) {
+        return report(AtracsysStatus(AtracsysStatusCode::UnknownGeometry));
+    }
+    return report(AtracsysStatus());
+}
+
+AtracsysStatus AtracsysWrapperImpl::clearTipOffset(uint32_t geometryId) {
+    if (!tipOffsets.clearTip(geometryId)) {
+        return report(AtracsysStatus(AtracsysStatusCode::UnknownGeometry));
+    }
+    return report(AtracsysStatus());
+}
+
+bool AtracsysWrapperImpl::getTipOffset(uint32_t geometryId, std::array<float, 3>& tipMM) const {
+    float uncertaintyScale;
+    return tipOffsets.getTip(geometryId, tipMM, uncertaintyScale);
+}
+
+void AtracsysWrapperImpl::setReferenceGeometry(uint32_t geometryId) {
+    referenceGeometry.store(geometryId, std::memory_order_relaxed);
+}
+
+AtracsysStatus AtracsysWrapperImpl::startDigitizing(uint32_t geometryId, const AtracsysDigitizerOptions& options) {
+    if (markers.find(geometryId) == markers.end()) {
+        return report(AtracsysStatus(AtracsysStatusCode::UnknownGeometry));
+    }
+    if (!digitizer.start(geometryId, options)) {
+        return report(AtracsysStatus(AtracsysStatusCode::TooManyPointers));
+    }
+    return report(AtracsysStatus());
+}
+
+void AtracsysWrapperImpl::stopDigitizing(uint32_t geometryId) {
+    digitizer.stop(geometryId);
+}
+
+bool AtracsysWrapperImpl::pollDigitizedPoint(AtracsysDigitizedPoint& point) {
+    return digitizer.poll(point);
+}
+
+AtracsysStatus AtracsysWrapperImpl::startSurfaceAcquisition(uint32_t geometryId, const AtracsysSurfaceOptions& options) {
+    if (markers.find(geometryId) == markers.end()) {
+        return report(AtracsysStatus(AtracsysStatusCode::UnknownGeometry));
+    }
+    surface.start(geometryId, options);
+    return report(AtracsysStatus());
+}
+
+void AtracsysWrapperImpl::stopSurfaceAcquisition() {
+    surface.stop();
+}
+
+void AtracsysWrapperImpl::clearSurface() {
+    surface.clear();
+}
+
+size_t AtracsysWrapperImpl::getSurfacePoints(std::vector<std::array<float, 3>>& points) {
+    return surface.getPoints(points);
+}
+
+AtracsysSurfaceStats AtracsysWrapperImpl::getSurfaceStats() {
+    return surface.getStats();
+}
+
+void AtracsysWrapperImpl::setPoseHistoryCapacity(uint32_t samples) {
+    poseHistoryCapacity = samples;
+}
+
+bool AtracsysWrapperImpl::poseAt(uint32_t geometryId, uint64_t timestampUS, AtracsysPose& pose) const {
+    const int64_t offset = timeOffsetUS.load(std::memory_order_relaxed);
+    return poseHistory.poseAt(geometryId, timestampUS + uint64_t(offset), pose);
+}
+
+bool AtracsysWrapperImpl::getPoseHistoryRange(uint32_t geometryId, uint64_t& oldestUS, uint64_t& newestUS) const {
+    if (!poseHistory.getRange(geometryId, oldestUS, newestUS)) {
+        return false;
+    }
+    const int64_t offset = timeOffsetUS.load(std::memory_order_relaxed);
+    oldestUS -= uint64_t(offset);
+    newestUS -= uint64_t(offset);
+    return true;
+}
+
+void AtracsysWrapperImpl::setTimeOffset(int64_t offsetUS) {
+    timeOffsetUS.store(offsetUS, std::memory_order_relaxed);
+}
+
+int64_t AtracsysWrapperImpl::getTimeOffset() const {
+    return timeOffsetUS.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<AtracsysFrameConsumer> AtracsysWrapperImpl::createConsumer(AtracsysWaitStrategy strategy,
+                                                                           uint32_t spinIterations) {
+    return std::make_unique<FrameConsumer>(frameChannel, strategy, spinIterations);
+}
+
+std::unique_ptr<AtracsysFrameConsumer> AtracsysWrapperImpl::createRateConsumer(double rateHz, AtracsysRateMode mode,
+                                                                               AtracsysWaitStrategy strategy,
+                                                                               uint32_t spinIterations) {
+    return rateFanout->createConsumer(rateHz, mode, strategy, spinIterations);
+}
+
+bool AtracsysWrapperImpl::startSharedMemoryPublisher(const std::string& name, uint32_t capacity) {
+    if (isAcquiring()) {
+        return false;
+    }
+    stopSharedMemoryPublisher();
+    auto publisher = std::make_unique<SharedPosePublisher>();
+    if (!publisher->open(name, capacity)) {
+        return false;
+    }
+    sharedPosePublisher = std::move(publisher);
+    addFrameListener(sharedPosePublisher.get());
+    return true;
+}
+
+void AtracsysWrapperImpl::stopSharedMemoryPublisher() {
+    if (sharedPosePublisher != nullptr && !isAcquiring()) {
+        removeFrameListener(sharedPosePublisher.get());
+        sharedPosePublisher.reset();
+    }
+}
+
+bool AtracsysWrapperImpl::startPoseMulticast(const std::string& group, uint16_t port, uint8_t ttl) {
+    if (isAcquiring()) {
+        return false;
+    }
+    stopPoseMulticast();
+    auto publisher = std::make_unique<MulticastPosePublisher>();
+    if (!publisher->open(group, port, ttl)) {
+        return false;
+    }
+    multicastPosePublisher = std::move(publisher);
+    addFrameListener(multicastPosePublisher.get());
+    return true;
+}
+
+void AtracsysWrapperImpl::stopPoseMulticast() {
+    if (multicastPosePublisher != nullptr && !isAcquiring()) {
+        removeFrameListener(multicastPosePublisher.get());
+        multicastPosePublisher.reset();
+    }
+}
+
+void AtracsysWrapperImpl::addFrameListener(FrameListener* listener) {
+    frameListeners.push_back(listener);
+}
+
+void AtracsysWrapperImpl::removeFrameListener(FrameListener* listener) {
+    frameListeners.erase(std::remove(frameListeners.begin(), frameListeners.end(), listener),
+                         frameListeners.end());
+}
+
+void AtracsysWrapperImpl::publishFrame() {
+    // First, so that a consumer woken below finds the raw data and images of its frame. The pool hands the
+    // filled buffer to raw readers and gives back an empty one; nothing reads `frame` after this.
+    const std::shared_ptr<RawFramePool> pool = std::atomic_load(&rawFrames);
+    if (pool != nullptr) {
+        pool->publish(frame, currentFrame.index, currentFrame.timestampUS);
+    }
+    for (FrameListener* listener : frameListeners) {
+        listener->onFrame(currentFrame);
+    }
+}
+
+void AtracsysWrapperImpl::startImageThread(std::shared_ptr<AtracsysImagePipeline> pipeline,
+                                           std::shared_ptr<RawFramePool> pool) {
+    imageThreadRunning = true;
+    imageThread = std::thread([this, pipeline, pool]() { feedImages(*pipeline, *pool); });
+}
+
+void AtracsysWrapperImpl::stopImageThread() {
+    imageThreadRunning = false;
+    if (imageThread.joinable()) {
+        imageThread.join();
+    }
+}
+
+void AtracsysWrapperImpl::feedImages(AtracsysImagePipeline& pipeline, RawFramePool& pool) {
+    FrameConsumer consumer(frameChannel, AtracsysWaitStrategy::Block, 0);
+    AtracsysFrame poses;
+    AtracsysRawFrame raw;
+    uint64_t nextIndex = 0;
+    bool started = false;
+    while (imageThreadRunning && !frameChannel->isClosed()) {
+        if (!consumer.waitNext(poses, IMAGE_WAIT_MS)) {
+            continue;
+        }
+        // Older than the woken frame when every other buffer was pinned and the pool kept the previous one.
+        if (!pool.acquire(raw) || (started && raw.getIndex() < nextIndex)) {
+            continue;
+        }
+        if (started) {
+            imagesSkipped.fetch_add(raw.getIndex() - nextIndex, std::memory_order_relaxed);
+        }
+        started = true;
+        nextIndex = raw.getIndex() + 1;
+        pushImages(pipeline, raw);
+        raw.release();
+    }
+}
+
+void AtracsysWrapperImpl::pushImages(AtracsysImagePipeline& pipeline, const AtracsysRawFrame& raw) {
+    const ftkFrameQuery* query = raw.getQuery();
+    const ftkImageHeader* header = query->imageHeader;
+    if (header == nullptr) {
+        return;
+    }
+    const uint8_t bytesPerPixel = header->format == GRAY16 ? 2 : 1;
+    if (query->imageLeftStat == QS_OK) {
+        pipeline.push(AtracsysCamera::Left, raw.getIndex(), raw.getTimestampUS(), query->imageLeftPixels,
+                      header->width, header->height, header->imageStrideInBytes, bytesPerPixel);
+    }
+    if (query->imageRightStat == QS_OK) {
+        pipeline.push(AtracsysCamera::Right, raw.getIndex(), raw.getTimestampUS(), query->imageRightPixels,
+                      header->width, header->height, header->imageStrideInBytes, bytesPerPixel);
+    }
+}
+
+AtracsysStatus AtracsysWrapperImpl::report(AtracsysStatus status) {
+    errors.record(status);
+    return status;
+}
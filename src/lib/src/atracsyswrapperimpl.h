@@ -7,10 +7,32 @@
 #include <memory>
 #include <string>
 #include <ftkInterface.h>
+#include <array>
+#include <atomic>
+#include <future>
 #include <map>
+#include <thread>
+#include <vector>
 #include <atracsyswrapper/atracsyswrapper.h>
 #include "atracsysdevice.h"
 #include "atracsyswrapper/atracsysmarker.h"
+#include "errorcounters.h"
+#include "acquisitionmetrics.h"
+#include "metricsserver.h"
+#include "framelistener.h"
+#include "framechannel.h"
+#include "ratefanout.h"
+#include "posehistory.h"
+#include "pivotcalibration.h"
+#include "tipoffsets.h"
+#include "digitizer.h"
+#include "surfaceaccumulator.h"
+#include "markermatcher.h"
+#include "rawframepool.h"
+#include "sharedposepublisher.h"
+#include "multicastposepublisher.h"
+
+class Thread;
 
 class AtracsysWrapperImpl : public AtracsysWrapper {
 public:
@@ -18,22 +40,162 @@ public:
 
     ~AtracsysWrapperImpl() override;
 
-    bool init() override;
+    AtracsysStatus init() override;
+    std::future<AtracsysStartupReport> initAsync(const AtracsysStartupOptions& options) override;
+
+    AtracsysStatus addGeometry(const std::string &filename, const std::string& geometryId) override;
+
+    void setMatchingOptions(const AtracsysMatchingOptions& options) override;
+
+    void setRawDataOptions(const AtracsysRawDataOptions& options) override;
+    bool getRawFrame(AtracsysRawFrame& frame) override;
+
+    void setImageOptions(const AtracsysImageOptions& options) override;
+    bool pollImage(AtracsysImage& image) override;
+    bool waitImage(AtracsysImage& image, uint32_t timeoutMs) override;
+    AtracsysImageStats getImageStats() const override;
+
+    AtracsysStatus startTracking() override;
+    AtracsysStatus stopTrackking() override;
+
+    AtracsysStatus getMarkerPositions() override;
+
+	const std::map<size_t, AtracsysMarker>& getMarkers() const override;
+
+    AtracsysStatus getLastStatus() const override;
+    uint64_t getErrorCount(AtracsysStatusCode code) const override;
+    uint64_t getFtkErrorCount(int32_t ftkError) const override;
+    std::string getLastErrorString() const override;
+
+    std::string getMetricsText() const override;
+    bool startMetricsServer(uint16_t port) override;
+    void stopMetricsServer() override;
 
-    bool addGeometry(const std::string &filename, const std::string& geometryId) override;
+    void setRealtimeOptions(const AtracsysRealtimeOptions& options) override;
+    AtracsysStatus startAcquisition() override;
+    void stopAcquisition() override;
+    bool isAcquiring() const override;
+    AtracsysJitterStats getJitterStats() const override;
 
-    bool startTracking() override;
-    bool stopTrackking() override;
+    AtracsysStatus startPivotCalibration(uint32_t geometryId, float rejectionFactor) override;
+    void stopPivotCalibration() override;
+    bool getPivotCalibration(AtracsysPivotCalibration& calibration) const override;
+    AtracsysStatus applyPivotCalibration() override;
 
-    void getMarkerPositions() override;
+    AtracsysStatus setTipOffset(uint32_t geometryId, const std::array<float, 3>& tipMM) override;
+    AtracsysStatus clearTipOffset(uint32_t geometryId) override;
+    bool getTipOffset(uint32_t geometryId, std::array<float, 3>& tipMM) const override;
+    void setReferenceGeometry(uint32_t geometryId) override;
 
-	const std::map<size_t, AtracsysMarker>& getMarkers() const;
+    AtracsysStatus startDigitizing(uint32_t geometryId, const AtracsysDigitizerOptions& options) override;
+    void stopDigitizing(uint32_t geometryId) override;
+    bool pollDigitizedPoint(AtracsysDigitizedPoint& point) override;
+
+    AtracsysStatus startSurfaceAcquisition(uint32_t geometryId, const AtracsysSurfaceOptions& options) override;
+    void stopSurfaceAcquisition() override;
+    void clearSurface() override;
+    size_t getSurfacePoints(std::vector<std::array<float, 3>>& points) override;
+    AtracsysSurfaceStats getSurfaceStats() override;
+
+    void setPoseHistoryCapacity(uint32_t samples) override;
+    bool poseAt(uint32_t geometryId, uint64_t timestampUS, AtracsysPose& pose) const override;
+    bool getPoseHistoryRange(uint32_t geometryId, uint64_t& oldestUS, uint64_t& newestUS) const override;
+    void setTimeOffset(int64_t offsetUS) override;
+    int64_t getTimeOffset() const override;
+
+    std::unique_ptr<AtracsysFrameConsumer> createConsumer(AtracsysWaitStrategy strategy,
+                                                          uint32_t spinIterations) override;
+    std::unique_ptr<AtracsysFrameConsumer> createRateConsumer(double rateHz, AtracsysRateMode mode,
+                                                              AtracsysWaitStrategy strategy,
+                                                              uint32_t spinIterations) override;
+
+    bool startSharedMemoryPublisher(const std::string& name, uint32_t capacity) override;
+    void stopSharedMemoryPublisher() override;
+
+    bool startPoseMulticast(const std::string& group, uint16_t port, uint8_t ttl) override;
+    void stopPoseMulticast() override;
 private:
+    struct FrameLayout {
+        bool pixels = false;
+        uint32 blobs = 0;
+        uint32 fiducials = 0;
+        uint32 markers = 0;
+        uint32 matchedFiducials = 0;
+
+        bool operator==(const FrameLayout& other) const {
+            return pixels == other.pixels && blobs == other.blobs && fiducials == other.fiducials &&
+                   markers == other.markers && matchedFiducials == other.matchedFiducials;
+        }
+    };
+
+    AtracsysStatus report(AtracsysStatus status);
+    AtracsysStartupReport startup(const AtracsysStartupOptions& options);
+    AtracsysStatus initLibrary();
+    AtracsysStatus initDevice();
+    AtracsysStatus applyDeviceOptions();
+    AtracsysStatus loadGeometryFile(const std::string& filename, const std::string& geometryId);
+    // `filename` is empty for geometries from the installation directory.
+    AtracsysStatus registerGeometry(ftkGeometry& geometry, const std::array<float, 3>* tipMM,
+                                    const std::string& filename, const std::string& geometryId);
+    FrameLayout getFrameLayout() const;
+    AtracsysStatus allocateFrame(const FrameLayout& layout);
+    void addFrameListener(FrameListener* listener);
+    void removeFrameListener(FrameListener* listener);
+    void publishFrame();
+    uint32_t matchOnHost();
+    void startImageThread(std::shared_ptr<AtracsysImagePipeline> pipeline, std::shared_ptr<RawFramePool> pool);
+    void stopImageThread();
+    void feedImages(AtracsysImagePipeline& pipeline, RawFramePool& pool);
+    static void pushImages(AtracsysImagePipeline& pipeline, const AtracsysRawFrame& raw);
+    static bool acquisitionLoop(const Thread& owner, void* userData);
+
     ftkLibrary library;
     std::unique_ptr<AtracsysDevice> device;
     std::map<std::string, ftkGeometry> geometries;
+    std::map<uint32_t, std::string> geometryFiles;
     std::map<size_t, AtracsysMarker> markers;
     ftkFrameQuery* frame;
+    FrameLayout frameLayout;
+    bool frameSized = false;
+    AtracsysMatchingOptions matchingOptions;
+    bool hostMatching = false;
+    MarkerMatcher markerMatcher;
+    std::vector<MarkerMatcher::Point> hostFiducials;
+    std::array<MarkerMatcher::Match, MarkerMatcher::MAX_GEOMETRIES> hostMatches;
+    std::array<ftkMarker, MarkerMatcher::MAX_GEOMETRIES> hostMarkers;
+    AtracsysRawDataOptions rawDataOptions;
+    // Swapped atomically: raw readers may load it from any thread. Also created for the image thread alone.
+    std::shared_ptr<RawFramePool> rawFrames;
+    std::atomic<bool> rawFramesPublic{false};
+    AtracsysImageOptions imageOptions;
+    // Swapped atomically like rawFrames.
+    std::shared_ptr<AtracsysImagePipeline> images;
+    std::thread imageThread;
+    std::atomic<bool> imageThreadRunning{false};
+    std::atomic<uint64_t> imagesSkipped{0};
+    ErrorCounters errors;
+    AcquisitionMetrics metrics;
+    std::unique_ptr<MetricsServer> metricsServer;
+
+    AtracsysFrame currentFrame;
+    uint64_t frameIndex = 0;
+    std::vector<FrameListener*> frameListeners;
+    std::shared_ptr<FrameChannel> frameChannel;
+    std::shared_ptr<RateFanout> rateFanout;
+    PoseHistory poseHistory;
+    std::atomic<int64_t> timeOffsetUS{0};
+    uint32_t poseHistoryCapacity = 1024;
+    PivotCalibration pivotCalibration;
+    TipOffsets tipOffsets;
+    Digitizer digitizer;
+    SurfaceAccumulator surface;
+    std::atomic<uint32_t> referenceGeometry{UINT32_MAX};
+    std::unique_ptr<SharedPosePublisher> sharedPosePublisher;
+    std::unique_ptr<MulticastPosePublisher> multicastPosePublisher;
+
+    AtracsysRealtimeOptions realtimeOptions;
+    std::unique_ptr<Thread> acquisitionThread;
+    std::atomic<bool> acquiring{false};
 };
 
 
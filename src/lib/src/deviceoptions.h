@@ -0,0 +1,34 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <ftkTypes.h>
+
+/** \brief Device options written by the wrapper and the test application.
+ *
+ * Identifiers are those of the Atracsys SDK option list; every option is
+ * read and written with ftkSetInt32 / ftkGetInt32.
+ */
+enum class DeviceOption : uint8 {
+    OnboardProcessing,
+    SendingImages,
+    Count
+};
+
+struct DeviceOptionInfo {
+    uint32 id;
+    const char* name;
+    int32 minimum;
+    int32 maximum;
+};
+
+inline const DeviceOptionInfo& getDeviceOptionInfo(DeviceOption option) {
+    static const DeviceOptionInfo options[size_t(DeviceOption::Count)] = {
+            {6000u, "Enable embedded processing", 0, 1},
+            {6003u, "Enable images sending", 0, 1}
+    };
+    return options[size_t(option)];
+}
@@ -0,0 +1,342 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "digitizer.h"
+#include "posemath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+// Keeps a window of near-identical samples from rejecting everything but the mean.
+const float MIN_REJECTION_MM = 0.02f;
+
+}
+
+Digitizer::Digitizer() {
+    requested.fill(UINT32_MAX);
+}
+
+bool Digitizer::start(uint32_t geometryId, const AtracsysDigitizerOptions& options) {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    auto slot = std::find(requested.begin(), requested.end(), geometryId);
+    if (slot == requested.end()) {
+        slot = std::find(requested.begin(), requested.end(), UINT32_MAX);
+        if (slot == requested.end()) {
+            return false;
+        }
+        *slot = geometryId;
+    }
+    commands.push_back({ geometryId, true, options });
+    commandsPending.store(true, std::memory_order_release);
+    return true;
+}
+
+void Digitizer::stop(uint32_t geometryId) {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    auto slot = std::find(requested.begin(), requested.end(), geometryId);
+    if (slot == requested.end()) {
+        return;
+    }
+    *slot = UINT32_MAX;
+    commands.push_back({ geometryId, false, AtracsysDigitizerOptions() });
+    commandsPending.store(true, std::memory_order_release);
+}
+
+bool Digitizer::poll(AtracsysDigitizedPoint& point) {
+    const uint64_t head = queueHead.load(std::memory_order_relaxed);
+    if (head == queueTail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    point = queue[head % QUEUE_CAPACITY];
+    queueHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void Digitizer::onFrame(const AtracsysFrame& frame) {
+    if (commandsPending.load(std::memory_order_acquire)) {
+        applyCommands();
+    }
+
+    for (Pointer& pointer : pointers) {
+        if (pointer.geometryId == UINT32_MAX) {
+            continue;
+        }
+        const AtracsysPose* pose = frame.findPose(pointer.geometryId);
+        if (pose == nullptr) {
+            // Stillness has to be observed without interruption.
+            reset(pointer);
+            continue;
+        }
+        push(pointer, *pose);
+        if (pointer.armed && isStill(pointer)) {
+            emit(pointer, frame.timestampUS);
+        }
+    }
+}
+
+void Digitizer::applyCommands() {
+    std::unique_lock<std::mutex> lock(commandMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    for (const Command& command : commands) {
+        Pointer* target = nullptr;
+        for (Pointer& pointer : pointers) {
+            if (pointer.geometryId == command.geometryId) {
+                target = &pointer;
+                break;
+            }
+        }
+        if (!command.start) {
+            if (target != nullptr) {
+                target->geometryId = UINT32_MAX;
+            }
+            continue;
+        }
+        if (target == nullptr) {
+            for (Pointer& pointer : pointers) {
+                if (pointer.geometryId == UINT32_MAX) {
+                    target = &pointer;
+                    break;
+                }
+            }
+        }
+        if (target == nullptr) {
+            continue;
+        }
+        target->geometryId = command.geometryId;
+        target->options = command.options;
+        target->options.windowSamples = std::max<uint32_t>(2, std::min(command.options.windowSamples, uint32_t(MAX_WINDOW)));
+        target->armed = true;
+        target->hasLast = false;
+        reset(*target);
+    }
+    commands.clear();
+    commandsPending.store(false, std::memory_order_relaxed);
+}
+
+void Digitizer::reset(Pointer& pointer) {
+    pointer.count = 0;
+    pointer.head = 0;
+    pointer.withReference = 0;
+    pointer.squares = 0.0;
+    pointer.updatesSinceRefresh = 0;
+    for (int k = 0; k < 3; ++k) {
+        pointer.sum[k] = 0.0;
+    }
+    for (int k = 0; k < 4; ++k) {
+        pointer.quaternionSum[k] = 0.0;
+    }
+}
+
+void Digitizer::push(Pointer& pointer, const AtracsysPose& pose) {
+    const std::array<float, 3> tip = pose.hasTip ? pose.tipMM : posemath::translation(pose.transform);
+    const posemath::Quaternion rotation = posemath::fromRotation(pose.transform);
+    std::array<float, 4> q = { { rotation.w, rotation.x, rotation.y, rotation.z } };
+
+    if (pointer.hasLast && !pointer.armed) {
+        const float dx = tip[0] - pointer.last[0];
+        const float dy = tip[1] - pointer.last[1];
+        const float dz = tip[2] - pointer.last[2];
+        pointer.armed = dx * dx + dy * dy + dz * dz > pointer.options.rearmDistanceMM * pointer.options.rearmDistanceMM;
+    }
+
+    if (pointer.count == 0) {
+        pointer.anchor = { { tip[0], tip[1], tip[2] } };
+        pointer.quaternionAnchor = q;
+    }
+    if (pointer.count == pointer.options.windowSamples) {
+        pop(pointer);
+    }
+
+    // q and -q are the same rotation; keep the window on one hemisphere.
+    const std::array<float, 4>& anchor = pointer.quaternionAnchor;
+    if (q[0] * anchor[0] + q[1] * anchor[1] + q[2] * anchor[2] + q[3] * anchor[3] < 0.f) {
+        for (float& component : q) {
+            component = -component;
+        }
+    }
+
+    const uint32_t index = (pointer.head + pointer.count) % MAX_WINDOW;
+    pointer.x[index] = float(tip[0] - pointer.anchor[0]);
+    pointer.y[index] = float(tip[1] - pointer.anchor[1]);
+    pointer.z[index] = float(tip[2] - pointer.anchor[2]);
+    pointer.referenced[index] = pose.hasReferenceTip ? 1 : 0;
+    pointer.rx[index] = pose.tipInReferenceMM[0];
+    pointer.ry[index] = pose.tipInReferenceMM[1];
+    pointer.rz[index] = pose.tipInReferenceMM[2];
+    pointer.quaternions[index] = q;
+    ++pointer.count;
+
+    pointer.sum[0] += pointer.x[index];
+    pointer.sum[1] += pointer.y[index];
+    pointer.sum[2] += pointer.z[index];
+    pointer.squares += double(pointer.x[index]) * pointer.x[index] + double(pointer.y[index]) * pointer.y[index] +
+                       double(pointer.z[index]) * pointer.z[index];
+    for (int k = 0; k < 4; ++k) {
+        pointer.quaternionSum[k] += q[k];
+    }
+    pointer.withReference += pointer.referenced[index];
+
+    // Add/subtract rounding accumulates; rebuild the sums every MAX_WINDOW updates.
+    if (++pointer.updatesSinceRefresh >= MAX_WINDOW) {
+        refresh(pointer);
+    }
+}
+
+void Digitizer::pop(Pointer& pointer) {
+    const uint32_t index = pointer.head;
+    pointer.sum[0] -= pointer.x[index];
+    pointer.sum[1] -= pointer.y[index];
+    pointer.sum[2] -= pointer.z[index];
+    pointer.squares -= double(pointer.x[index]) * pointer.x[index] + double(pointer.y[index]) * pointer.y[index] +
+                       double(pointer.z[index]) * pointer.z[index];
+    for (int k = 0; k < 4; ++k) {
+        pointer.quaternionSum[k] -= pointer.quaternions[index][k];
+    }
+    pointer.withReference -= pointer.referenced[index];
+    pointer.head = (pointer.head + 1) % MAX_WINDOW;
+    --pointer.count;
+}
+
+void Digitizer::refresh(Pointer& pointer) {
+    pointer.updatesSinceRefresh = 0;
+    if (pointer.count == 0) {
+        return;
+    }
+
+    // Re-anchor on the window mean and the newest rotation, so a pointer that
+    // wandered off keeps small relative values and one quaternion hemisphere.
+    const double n = double(pointer.count);
+    const double shift[3] = { pointer.sum[0] / n, pointer.sum[1] / n, pointer.sum[2] / n };
+    const uint32_t newest = (pointer.head + pointer.count - 1) % MAX_WINDOW;
+    pointer.quaternionAnchor = pointer.quaternions[newest];
+    for (int k = 0; k < 3; ++k) {
+        pointer.anchor[k] += shift[k];
+        pointer.sum[k] = 0.0;
+    }
+    pointer.squares = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        pointer.quaternionSum[k] = 0.0;
+    }
+
+    const std::array<float, 4>& anchor = pointer.quaternionAnchor;
+    for (uint32_t i = 0; i < pointer.count; ++i) {
+        const uint32_t index = (pointer.head + i) % MAX_WINDOW;
+        pointer.x[index] = float(pointer.x[index] - shift[0]);
+        pointer.y[index] = float(pointer.y[index] - shift[1]);
+        pointer.z[index] = float(pointer.z[index] - shift[2]);
+        pointer.sum[0] += pointer.x[index];
+        pointer.sum[1] += pointer.y[index];
+        pointer.sum[2] += pointer.z[index];
+        pointer.squares += double(pointer.x[index]) * pointer.x[index] + double(pointer.y[index]) * pointer.y[index] +
+                           double(pointer.z[index]) * pointer.z[index];
+
+        std::array<float, 4>& q = pointer.quaternions[index];
+        if (q[0] * anchor[0] + q[1] * anchor[1] + q[2] * anchor[2] + q[3] * anchor[3] < 0.f) {
+            for (float& component : q) {
+                component = -component;
+            }
+        }
+        for (int k = 0; k < 4; ++k) {
+            pointer.quaternionSum[k] += q[k];
+        }
+    }
+}
+
+bool Digitizer::isStill(const Pointer& pointer) const {
+    if (pointer.count < pointer.options.windowSamples) {
+        return false;
+    }
+    const double n = double(pointer.count);
+    const double mean[3] = { pointer.sum[0] / n, pointer.sum[1] / n, pointer.sum[2] / n };
+    const double variance = pointer.squares / n - (mean[0] * mean[0] + mean[1] * mean[1] + mean[2] * mean[2]);
+    const double maxTranslation = pointer.options.maxTranslationStdMM;
+    if (variance > maxTranslation * maxTranslation) {
+        return false;
+    }
+
+    double meanNorm = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        meanNorm += (pointer.quaternionSum[k] / n) * (pointer.quaternionSum[k] / n);
+    }
+    const double rotationSpread = 2.0 * std::sqrt(std::max(0.0, 1.0 - meanNorm));
+    return rotationSpread <= pointer.options.maxRotationStdDeg * PI / 180.0;
+}
+
+void Digitizer::emit(Pointer& pointer, uint64_t timestampUS) {
+    const double n = double(pointer.count);
+    const float mean[3] = { float(pointer.sum[0] / n), float(pointer.sum[1] / n), float(pointer.sum[2] / n) };
+    const double variance = std::max(0.0, pointer.squares / n - double(mean[0]) * mean[0] -
+                                          double(mean[1]) * mean[1] - double(mean[2]) * mean[2]);
+    const float limit = std::max(pointer.options.rejectionFactor * float(std::sqrt(variance)), MIN_REJECTION_MM);
+    const float limitSquared = limit * limit;
+
+    // The ring occupies at most two contiguous runs; straight loops over them vectorise.
+    float sum[3] = { 0.f, 0.f, 0.f };
+    float referenceSum[3] = { 0.f, 0.f, 0.f };
+    float squares = 0.f;
+    uint32_t used = 0;
+    uint32_t referenced = 0;
+    auto accumulate = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const float dx = pointer.x[i] - mean[0];
+            const float dy = pointer.y[i] - mean[1];
+            const float dz = pointer.z[i] - mean[2];
+            const float distance = dx * dx + dy * dy + dz * dz;
+            const float keep = distance <= limitSquared ? 1.f : 0.f;
+            const float withReference = keep * pointer.referenced[i];
+            sum[0] += keep * dx;
+            sum[1] += keep * dy;
+            sum[2] += keep * dz;
+            squares += keep * distance;
+            referenceSum[0] += withReference * pointer.rx[i];
+            referenceSum[1] += withReference * pointer.ry[i];
+            referenceSum[2] += withReference * pointer.rz[i];
+            used += uint32_t(keep);
+            referenced += pointer.referenced[i] & uint32_t(keep);
+        }
+    };
+    const uint32_t end = pointer.head + pointer.count;
+    accumulate(pointer.head, std::min(end, uint32_t(MAX_WINDOW)));
+    if (end > MAX_WINDOW) {
+        accumulate(0, end - MAX_WINDOW);
+    }
+    if (used == 0) {
+        return;
+    }
+
+    AtracsysDigitizedPoint point;
+    point.geometryId = pointer.geometryId;
+    point.timestampUS = timestampUS;
+    const float offset[3] = { sum[0] / float(used), sum[1] / float(used), sum[2] / float(used) };
+    for (int k = 0; k < 3; ++k) {
+        point.positionMM[k] = float(pointer.anchor[k] + mean[k] + offset[k]);
+    }
+    point.hasReference = referenced == used;
+    if (point.hasReference) {
+        for (int k = 0; k < 3; ++k) {
+            point.positionInReferenceMM[k] = referenceSum[k] / float(used);
+        }
+    }
+    point.samples = used;
+    point.rejected = pointer.count - used;
+    const float spread = squares / float(used) - (offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+    point.spreadMM = std::sqrt(std::max(spread, 0.f));
+
+    pointer.armed = false;
+    pointer.hasLast = true;
+    pointer.last = point.positionMM;
+
+    const uint64_t tail = queueTail.load(std::memory_order_relaxed);
+    if (tail - queueHead.load(std::memory_order_acquire) >= QUEUE_CAPACITY) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue[tail % QUEUE_CAPACITY] = point;
+    queueTail.store(tail + 1, std::memory_order_release);
+}
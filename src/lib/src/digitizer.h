@@ -0,0 +1,101 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <atracsyswrapper/atracsysdigitizer.h>
+#include "framelistener.h"
+
+/** \brief Takes landmarks automatically whenever a pointer is held still.
+ *
+ * Each active pointer keeps a ring of its last poses and running sums of
+ * tip position, squared position and aligned rotation quaternion, so the
+ * window spreads update in O(1) per frame: translation variance is
+ * E|p|^2 - |E p|^2, rotation spread 2 * sqrt(1 - |E q|^2). Positions are
+ * stored relative to an anchor to keep the sums well conditioned. Once
+ * still, the window is averaged with outlier rejection over contiguous
+ * per-axis arrays.
+ *
+ * onFrame() runs on the acquisition thread and only try-locks the command
+ * list; points are handed out through a single-consumer ring.
+ */
+class Digitizer : public FrameListener {
+public:
+    static const size_t MAX_POINTERS = 8;
+    static const uint32_t MAX_WINDOW = 512;
+    static const size_t QUEUE_CAPACITY = 64;
+
+    Digitizer();
+
+    bool start(uint32_t geometryId, const AtracsysDigitizerOptions& options);
+    void stop(uint32_t geometryId);
+
+    // Single consumer.
+    bool poll(AtracsysDigitizedPoint& point);
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+private:
+    struct Command {
+        uint32_t geometryId;
+        bool start;
+        AtracsysDigitizerOptions options;
+    };
+
+    struct Pointer {
+        uint32_t geometryId = UINT32_MAX;
+        AtracsysDigitizerOptions options;
+        uint32_t count = 0;
+        uint32_t head = 0;
+        bool armed = true;
+        bool hasLast = false;
+        std::array<float, 3> last = { { 0.f, 0.f, 0.f } };
+        uint32_t withReference = 0;
+
+        // Window in structure-of-arrays form, positions relative to `anchor`.
+        std::array<double, 3> anchor = { { 0.0, 0.0, 0.0 } };
+        std::array<float, 4> quaternionAnchor = { { 1.f, 0.f, 0.f, 0.f } };
+        std::array<float, MAX_WINDOW> x;
+        std::array<float, MAX_WINDOW> y;
+        std::array<float, MAX_WINDOW> z;
+        std::array<float, MAX_WINDOW> rx;
+        std::array<float, MAX_WINDOW> ry;
+        std::array<float, MAX_WINDOW> rz;
+        std::array<uint8_t, MAX_WINDOW> referenced;
+        std::array<std::array<float, 4>, MAX_WINDOW> quaternions;
+
+        double sum[3] = {};
+        double squares = 0.0;
+        double quaternionSum[4] = {};
+        uint32_t updatesSinceRefresh = 0;
+    };
+
+    void applyCommands();
+    void reset(Pointer& pointer);
+    void push(Pointer& pointer, const AtracsysPose& pose);
+    void pop(Pointer& pointer);
+    void refresh(Pointer& pointer);
+    bool isStill(const Pointer& pointer) const;
+    void emit(Pointer& pointer, uint64_t timestampUS);
+
+    std::mutex commandMutex;
+    std::array<uint32_t, MAX_POINTERS> requested;
+    std::vector<Command> commands;
+    std::atomic<bool> commandsPending{false};
+
+    // Acquisition thread state.
+    std::array<Pointer, MAX_POINTERS> pointers;
+
+    // Single-producer, single-consumer point queue.
+    std::array<AtracsysDigitizedPoint, QUEUE_CAPACITY> queue;
+    std::atomic<uint64_t> queueHead{0};
+    std::atomic<uint64_t> queueTail{0};
+    std::atomic<uint64_t> dropped{0};
+};
@@ -0,0 +1,70 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <atracsyswrapper/atracsysstatus.h>
+
+/** \brief Per-code error counters.
+ *
+ * Fixed arrays of relaxed atomics, one slot per wrapper status code and one
+ * per ftkError value in [FTK_CODE_MIN, FTK_CODE_MAX]. Codes outside that range
+ * share the last slot. Recording never allocates and never blocks.
+ */
+class ErrorCounters {
+public:
+    static const int32_t FTK_CODE_MIN = -128;
+    static const int32_t FTK_CODE_MAX = 127;
+
+    ErrorCounters() {
+        reset();
+    }
+
+    void record(const AtracsysStatus& status) {
+        statusCounts[static_cast<size_t>(status.getCode())].fetch_add(1, std::memory_order_relaxed);
+        if (status.getFtkError() != 0) {
+            ftkCounts[ftkSlot(status.getFtkError())].fetch_add(1, std::memory_order_relaxed);
+        }
+        last.store(status, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount(AtracsysStatusCode code) const {
+        return statusCounts[static_cast<size_t>(code)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t getFtkCount(int32_t ftkError) const {
+        return ftkCounts[ftkSlot(ftkError)].load(std::memory_order_relaxed);
+    }
+
+    AtracsysStatus getLast() const {
+        return last.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (auto& count : statusCounts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : ftkCounts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        last.store(AtracsysStatus(), std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t FTK_SLOTS = FTK_CODE_MAX - FTK_CODE_MIN + 2;
+
+    static size_t ftkSlot(int32_t ftkError) {
+        if (ftkError < FTK_CODE_MIN || ftkError > FTK_CODE_MAX) {
+            return FTK_SLOTS - 1;
+        }
+        return static_cast<size_t>(ftkError - FTK_CODE_MIN);
+    }
+
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(AtracsysStatusCode::Count)> statusCounts;
+    std::array<std::atomic<uint64_t>, FTK_SLOTS> ftkCounts;
+    std::atomic<AtracsysStatus> last;
+};
@@ -0,0 +1,159 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "framechannel.h"
+#include "waitprimitives.h"
+
+#include <chrono>
+
+namespace {
+
+const int MAX_READ_ATTEMPTS = 64;
+
+uint64_t steadyMicroseconds() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+}
+
+void FrameChannel::onFrame(const AtracsysFrame& frame) {
+    const uint32_t before = sequence.load(std::memory_order_relaxed);
+    sequence.store(before + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const uint64_t next = published.load(std::memory_order_relaxed) + 1;
+    publication = next;
+    this->frame.copyFrom(frame);
+    sequence.store(before + 2, std::memory_order_release);
+
+    // seq_cst pairs with the waiter registering itself before re-checking `published`.
+    published.store(next, std::memory_order_seq_cst);
+    wakeWord.fetch_add(1, std::memory_order_seq_cst);
+    if (parkedWaiters.load(std::memory_order_seq_cst) != 0) {
+        futexWakeAll(wakeWord);
+    }
+    if (blockedWaiters.load(std::memory_order_seq_cst) != 0) {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_all();
+    }
+}
+
+void FrameChannel::close() {
+    closed.store(true, std::memory_order_seq_cst);
+    wakeWord.fetch_add(1, std::memory_order_seq_cst);
+    futexWakeAll(wakeWord);
+    { std::lock_guard<std::mutex> lock(mutex); }
+    condition.notify_all();
+}
+
+bool FrameChannel::read(AtracsysFrame& frame, uint64_t& publication) const {
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            cpuRelax();
+            continue;
+        }
+        publication = this->publication;
+        frame.copyFrom(this->frame);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FrameConsumer::FrameConsumer(std::shared_ptr<FrameChannel> channel, AtracsysWaitStrategy strategy,
+                             uint32_t spinIterations)
+        : channel(std::move(channel)),
+          strategy(strategy),
+          spinIterations(spinIterations) {
+    consumed = this->channel->getPublished();
+}
+
+bool FrameConsumer::tryNext(AtracsysFrame& frame) {
+    const uint64_t available = channel->getPublished();
+    if (available == consumed) {
+        return false;
+    }
+
+    uint64_t publication = 0;
+    if (!channel->read(frame, publication) || publication <= consumed) {
+        return false;
+    }
+    missed += publication - consumed - 1;
+    consumed = publication;
+    return true;
+}
+
+bool FrameConsumer::waitNext(AtracsysFrame& frame, uint32_t timeoutMs) {
+    const uint64_t deadlineUS = steadyMicroseconds() + uint64_t(timeoutMs) * 1000;
+    while (!channel->isClosed()) {
+        if (tryNext(frame)) {
+            return true;
+        }
+
+        bool woken = false;
+        switch (strategy) {
+            case AtracsysWaitStrategy::BusySpin:
+                woken = spin(UINT32_MAX, deadlineUS);
+                break;
+            case AtracsysWaitStrategy::SpinThenPark:
+                woken = spin(spinIterations, deadlineUS) || park(deadlineUS);
+                break;
+            case AtracsysWaitStrategy::Block:
+                woken = block(deadlineUS);
+                break;
+        }
+        if (!woken && steadyMicroseconds() >= deadlineUS) {
+            return tryNext(frame);
+        }
+    }
+    return false;
+}
+
+bool FrameConsumer::spin(uint32_t iterations, uint64_t deadlineUS) {
+    for (uint32_t i = 0; i < iterations; ++i) {
+        if (channel->published.load(std::memory_order_acquire) != consumed || channel->isClosed()) {
+            return true;
+        }
+        cpuRelax();
+        // Reading the clock costs more than a pause, do it every few hundred iterations.
+        if ((i & 0xffu) == 0xffu && steadyMicroseconds() >= deadlineUS) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool FrameConsumer::park(uint64_t deadlineUS) {
+    const uint32_t expected = channel->wakeWord.load(std::memory_order_seq_cst);
+    channel->parkedWaiters.fetch_add(1, std::memory_order_seq_cst);
+    if (channel->published.load(std::memory_order_seq_cst) == consumed && !channel->isClosed()) {
+        const uint64_t now = steadyMicroseconds();
+        if (now < deadlineUS) {
+            futexWait(channel->wakeWord, expected, deadlineUS - now);
+        }
+    }
+    channel->parkedWaiters.fetch_sub(1, std::memory_order_seq_cst);
+    return channel->published.load(std::memory_order_acquire) != consumed;
+}
+
+bool FrameConsumer::block(uint64_t deadlineUS) {
+    const uint64_t now = steadyMicroseconds();
+    if (now >= deadlineUS) {
+        return false;
+    }
+
+    channel->blockedWaiters.fetch_add(1, std::memory_order_seq_cst);
+    bool woken;
+    {
+        std::unique_lock<std::mutex> lock(channel->mutex);
+        woken = channel->condition.wait_for(lock, std::chrono::microseconds(deadlineUS - now), [this]() {
+            return channel->published.load(std::memory_order_seq_cst) != consumed || channel->isClosed();
+        });
+    }
+    channel->blockedWaiters.fetch_sub(1, std::memory_order_seq_cst);
+    return woken;
+}
@@ -0,0 +1,71 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <atracsyswrapper/atracsysframeconsumer.h>
+#include "framelistener.h"
+
+/** \brief Latest-frame mailbox shared by all in-process consumers.
+ *
+ * The acquisition thread writes the frame under a seqlock and bumps
+ * `published`; it only makes a wake-up system call or takes the mutex when a
+ * consumer is actually parked or blocked, so spinning consumers cost the
+ * writer nothing.
+ */
+class FrameChannel : public FrameListener {
+public:
+    void onFrame(const AtracsysFrame& frame) override;
+
+    // Wakes every waiter; waits return false from then on.
+    void close();
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+    uint64_t getPublished() const { return published.load(std::memory_order_acquire); }
+
+    // Copies the latest frame; false if it was overwritten during the copy.
+    bool read(AtracsysFrame& frame, uint64_t& publication) const;
+
+private:
+    friend class FrameConsumer;
+
+    alignas(64) std::atomic<uint64_t> published{0};
+    std::atomic<uint32_t> wakeWord{0};
+    alignas(64) std::atomic<uint32_t> sequence{0};
+    uint64_t publication = 0;
+    AtracsysFrame frame;
+
+    alignas(64) std::atomic<uint32_t> parkedWaiters{0};
+    std::atomic<uint32_t> blockedWaiters{0};
+    std::atomic<bool> closed{false};
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+class FrameConsumer : public AtracsysFrameConsumer {
+public:
+    FrameConsumer(std::shared_ptr<FrameChannel> channel, AtracsysWaitStrategy strategy, uint32_t spinIterations);
+
+    bool waitNext(AtracsysFrame& frame, uint32_t timeoutMs) override;
+    bool tryNext(AtracsysFrame& frame) override;
+
+    AtracsysWaitStrategy getStrategy() const override { return strategy; }
+    uint64_t getMissedCount() const override { return missed; }
+
+private:
+    bool spin(uint32_t iterations, uint64_t deadlineUS);
+    bool park(uint64_t deadlineUS);
+    bool block(uint64_t deadlineUS);
+
+    std::shared_ptr<FrameChannel> channel;
+    AtracsysWaitStrategy strategy;
+    uint32_t spinIterations;
+    uint64_t consumed = 0;
+    uint64_t missed = 0;
+};
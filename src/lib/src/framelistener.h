@@ -0,0 +1,19 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atracsyswrapper/atracsysframe.h>
+
+/** \brief Internal sink for frames built by the acquisition path.
+ *
+ * onFrame() runs on the acquisition thread: implementations must not block
+ * and should not allocate.
+ */
+class FrameListener {
+public:
+    virtual ~FrameListener() = default;
+
+    virtual void onFrame(const AtracsysFrame& frame) = 0;
+};
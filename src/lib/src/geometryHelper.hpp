@@ -20,32 +20,47 @@
 #include <string.h>
 
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <new>
 #include <string>
+#include <system_error>
+#include <vector>
 
-bool loadFile( std::ifstream& is, ftkGeometry& geometry );
+/** \brief Optional tool tip stored in the \c [pivot] section, in marker
+ * coordinates.
+ */
+struct GeometryPivot
+{
+    bool present;
+    ftk3DPoint position;
+};
+
+bool loadFile( std::ifstream& is, ftkGeometry& geometry,
+               GeometryPivot* pivot = 0 );
 
 /** \brief Helper function loading a geometry.
  *
  * \param[in] fileName name of the file to load (file name only, \e no
  * directory information!).
  * \param[out] geometry instance of ftkGeometry holding the parameters.
+ * \param[out] pivot if not null, receives the \c [pivot] section.
  *
  * \retval 0 if everything went fine, \retval 1 if the data were loaded from
  * the system directory (windows only), \retval 2 if the data could not be
  * loaded.
  */
 int loadGeometry( ftkLibrary lib, const uint64& sn,
-                  const std::string& fileName, ftkGeometry& geometry )
+                  const std::string& fileName, ftkGeometry& geometry,
+                  GeometryPivot* pivot = 0 )
 {
     std::ifstream input;
 
     input.open( fileName.c_str() );
 
-    if ( ! input.fail() && loadFile( input, geometry ) )
+    if ( ! input.fail() && loadFile( input, geometry, pivot ) )
     {
         return 0;
     }
@@ -64,7 +79,7 @@ int loadGeometry( ftkLibrary lib, const uint64& sn,
 
         input.open( fullFile.c_str() );
 
-        if ( ! input.fail() && loadFile( input, geometry ) )
+        if ( ! input.fail() && loadFile( input, geometry, pivot ) )
         {
             return 1;
         }
@@ -329,7 +344,8 @@ bool assignFloatXX( IniFile& p, const std::string& section,
 
 // ----------------------------------------------------------------------------
 
-bool loadFile( std::ifstream& is, ftkGeometry& geometry )
+bool loadFile( std::ifstream& is, ftkGeometry& geometry,
+               GeometryPivot* pivot )
 {
     std::string line, fileContent( "" );
 
@@ -398,9 +414,165 @@ bool loadFile( std::ifstream& is, ftkGeometry& geometry )
                   << geometry.positions[ i ].z << ")" << std::endl;
     }
 
+    if ( pivot != 0 )
+    {
+        // The section is optional, do not complain when it is missing.
+        pivot->present =
+                parser.sections.find( "pivot" ) != parser.sections.end() &&
+                assignFloatXX( parser, "pivot", "x", &pivot->position.x ) &&
+                assignFloatXX( parser, "pivot", "y", &pivot->position.y ) &&
+                assignFloatXX( parser, "pivot", "z", &pivot->position.z );
+    }
+
     return true;
 }
 
+// ----------------------------------------------------------------------------
+
+/** \brief Helper function writing the \c [pivot] section of a geometry file.
+ *
+ * Only the \c x, \c y and \c z lines of the section are replaced (the
+ * section is appended when missing), so comments and the order of the other
+ * sections are kept. The result is written to a temporary file next to the
+ * original, which then replaces it, so that a crash or a failed write never
+ * leaves a truncated geometry behind.
+ *
+ * \param[in] fileName geometry file to update.
+ * \param[in] position tool tip in marker coordinates.
+ *
+ * \retval true if the file could be read and written back.
+ */
+bool savePivot( const std::string& fileName, const ftk3DPoint& position )
+{
+    std::ifstream input( fileName.c_str(), std::ios::binary );
+    if ( input.fail() )
+    {
+        return false;
+    }
+
+    std::vector< std::string > lines;
+    std::string line, fileContent( "" );
+    while ( getline( input, line ) )
+    {
+        lines.push_back( line );
+        fileContent += line + "\n";
+    }
+    if ( input.bad() )
+    {
+        return false;
+    }
+    input.close();
+
+    // Refuse to touch a file the loader would reject.
+    IniFile parser;
+    if ( ! parser.parse( const_cast< char* >( fileContent.c_str() ),
+                         fileContent.size() ) )
+    {
+        return false;
+    }
+
+    // Enough for any float in %.9g, which reads back exactly.
+    char values[ 3u ][ 32u ];
+    snprintf( values[ 0u ], sizeof( values[ 0u ] ), "%.9g", position.x );
+    snprintf( values[ 1u ], sizeof( values[ 1u ] ), "%.9g", position.y );
+    snprintf( values[ 2u ], sizeof( values[ 2u ] ), "%.9g", position.z );
+    const char* keys[ 3u ] = { "x", "y", "z" };
+    bool written[ 3u ] = { false, false, false };
+
+    // Same section detection as IniFile::parseLine(). Missing keys go after
+    // the last non-blank line of the section.
+    bool inPivot( false );
+    size_t sectionEnd( lines.size() );
+    for ( size_t i( 0u ); i < lines.size(); ++i )
+    {
+        const size_t firstBracket = lines[ i ].find_first_of( "[" ),
+                lastBracket = lines[ i ].find_last_of( "]" ),
+                equal = lines[ i ].find_first_of( "=" );
+        if ( firstBracket != std::string::npos &&
+             lastBracket != std::string::npos )
+        {
+            inPivot = lines[ i ].substr( firstBracket + 1u,
+                                         lastBracket - firstBracket - 1u ) ==
+                      "pivot";
+            if ( inPivot )
+            {
+                sectionEnd = i + 1u;
+            }
+            continue;
+        }
+        if ( ! inPivot )
+        {
+            continue;
+        }
+        if ( lines[ i ].find_first_not_of( " \t\r" ) != std::string::npos )
+        {
+            sectionEnd = i + 1u;
+        }
+        if ( equal == std::string::npos )
+        {
+            continue;
+        }
+
+        std::string key( lines[ i ].substr( 0u, equal ) );
+        key.erase( remove_if( key.begin(), key.end(), isspace ), key.end() );
+        for ( size_t k( 0u ); k < 3u; ++k )
+        {
+            if ( key == keys[ k ] )
+            {
+                lines[ i ] = std::string( keys[ k ] ) + "=" + values[ k ];
+                written[ k ] = true;
+            }
+        }
+    }
+
+    if ( parser.sections.find( "pivot" ) == parser.sections.end() )
+    {
+        if ( ! lines.empty() && ! lines.back().empty() )
+        {
+            lines.push_back( "" );
+        }
+        lines.push_back( "[pivot]" );
+        sectionEnd = lines.size();
+    }
+    for ( size_t k( 0u ); k < 3u; ++k )
+    {
+        if ( ! written[ k ] )
+        {
+            lines.insert( lines.begin() + sectionEnd++,
+                          std::string( keys[ k ] ) + "=" + values[ k ] );
+        }
+    }
+
+    std::string output;
+    for ( size_t i( 0u ); i < lines.size(); ++i )
+    {
+        output += lines[ i ] + "\n";
+    }
+
+    const std::string temporary( fileName + ".tmp" );
+    FILE* file = fopen( temporary.c_str(), "wb" );
+    if ( ! file )
+    {
+        return false;
+    }
+    bool ok = fwrite( output.data(), 1u, output.size(), file ) ==
+              output.size();
+    ok = fflush( file ) == 0 && ok;
+    ok = fclose( file ) == 0 && ok;
+    // Unlike rename(), this also replaces an existing file on Windows.
+    std::error_code error;
+    if ( ok )
+    {
+        std::filesystem::rename( temporary, fileName, error );
+        ok = ! error;
+    }
+    if ( ! ok )
+    {
+        remove( temporary.c_str() );
+    }
+    return ok;
+}
+
 #undef CHECK_SECTION
 
 #endif // GEOMETRYHELPER_HPP
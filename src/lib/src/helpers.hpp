@@ -13,7 +13,9 @@
 
 #include <ftkInterface.h>
 
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -208,6 +210,32 @@ inline void checkError( ftkLibrary lib, bool dontWaitForKeyboard = false,  bool
     }
 }
 
+/** \brief Function enumerating the devices and keeping the last one, without
+* printing or exiting.
+*
+* This is the variant of retrieveLastDevice() used by the wrapper library:
+* failures are reported through the return value only.
+*
+* \param[in] lib initialised library handle.
+* \param[out] device last discovered device, SerialNumber is 0 if none was
+* found.
+* \param[in] allowSimulator setting to \c false requires to discover only real
+* devices.
+*
+* \return the ftkEnumerateDevices error code.
+*/
+inline ftkError enumerateLastDevice( ftkLibrary lib, DeviceData& device,
+                                     bool allowSimulator = true )
+{
+    device.SerialNumber = 0uLL;
+    device.Type = DEV_UNKNOWN_DEVICE;
+    if ( allowSimulator )
+    {
+        return ftkEnumerateDevices( lib, deviceEnumerator, &device );
+    }
+    return ftkEnumerateDevices( lib, fusionTrackEnumerator, &device );
+}
+
 /** \brief Function enumerating the devices and keeping the last one.
 *
 * This function uses the ftkEnumerateDevices library function and the
@@ -389,55 +417,50 @@ inline bool ErrorReader::parseErrorString( const std::string& str )
         return false;
     }
 
-    size_t locBegin, locEnd;
-
-    std::vector< std::string > what;
-    what.push_back( "errors" );
-    what.push_back( "warnings" );
-    what.push_back( "messages" );
-
-    std::string* pseudoRef( 0 );
-
-    for ( std::vector< std::string >::const_iterator tagIt( what.begin() );
-          tagIt != what.end(); ++tagIt )
+    // Tags are spelled out once so that parsing does not build strings.
+    struct Tag
     {
-        if ( *tagIt == "errors" )
-        {
-            pseudoRef = &_ErrorString;
-        }
-        else if ( *tagIt == "warnings" )
-        {
-            pseudoRef = &_WarningString;
-        }
-        else if ( *tagIt == "messages" )
-        {
-            pseudoRef = &_StackMessage;
-        }
-        if ( str.find( "<" + *tagIt + " />" ) == std::string::npos )
+        const char* Empty;
+        const char* Open;
+        const char* Close;
+        std::string ErrorReader::* Target;
+    };
+    static const Tag tags[] = {
+        { "<errors />", "<errors>", "</errors>", &ErrorReader::_ErrorString },
+        { "<warnings />", "<warnings>", "</warnings>",
+          &ErrorReader::_WarningString },
+        { "<messages />", "<messages>", "</messages>",
+          &ErrorReader::_StackMessage }
+    };
+    static const char noErrors[] = "No errors";
+
+    for ( const Tag& tag : tags )
+    {
+        std::string& target( this->*tag.Target );
+        target.clear();
+
+        if ( str.find( tag.Empty ) != std::string::npos )
         {
-            locBegin = str.find( "<" + *tagIt + ">" );
-            locEnd = str.find( "</" + *tagIt + ">" );
-            if ( locBegin != std::string::npos &&
-                 locEnd != std::string::npos )
-            {
-                *pseudoRef = str.substr( locBegin + std::string( "<" + *tagIt + ">" ).size(),
-                                         locEnd - locBegin - std::string( "<" + *tagIt +  ">" ).size() );
-            }
-            else
-            {
-                std::cerr << "Cannot interpret <" << *tagIt << ">" << std::endl;
-                return false;
-            }
+            continue;
         }
-        else
+
+        const size_t openSize( strlen( tag.Open ) );
+        size_t locBegin( str.find( tag.Open ) );
+        size_t locEnd( locBegin == std::string::npos ? std::string::npos :
+                       str.find( tag.Close, locBegin + openSize ) );
+        if ( locBegin == std::string::npos || locEnd == std::string::npos )
         {
-            *pseudoRef = "";
+            std::cerr << "Cannot interpret " << tag.Open << std::endl;
+            return false;
         }
 
-        locBegin = pseudoRef->find( "No errors" );
-        if ( locBegin != std::string::npos )
+        locBegin += openSize;
+        target.assign( str, locBegin, locEnd - locBegin );
+
+        size_t locNoErrors( target.find( noErrors ) );
+        if ( locNoErrors != std::string::npos )
         {
-            *pseudoRef = pseudoRef->replace( locBegin, locBegin + strlen( "No errors" ), "" );
+            target.erase( locNoErrors, sizeof( noErrors ) - 1u );
         }
     }
 
@@ -455,10 +478,10 @@ inline bool ErrorReader::hasError( ftkError err ) const
         return false;
     }
 
-    std::stringstream convert;
-    convert << int32( err ) << ":";
+    char code[ 16u ];
+    snprintf( code, sizeof( code ), "%d:", int32( err ) );
 
-    return ( _ErrorString.find( convert.str() ) != std::string::npos );
+    return ( _ErrorString.find( code ) != std::string::npos );
 }
 
 inline bool ErrorReader::hasWarning( ftkError war ) const
@@ -467,15 +490,15 @@ inline bool ErrorReader::hasWarning( ftkError war ) const
     {
         return false;
     }
-    else if ( _ErrorString.empty() )
+    else if ( _WarningString.empty() )
     {
         return false;
     }
 
-    std::stringstream convert;
-    convert << int32( war ) << ":";
+    char code[ 16u ];
+    snprintf( code, sizeof( code ), "%d:", int32( war ) );
 
-    return ( _ErrorString.find( convert.str() ) != std::string::npos );
+    return ( _WarningString.find( code ) != std::string::npos );
 }
 
 inline bool ErrorReader::isOk() const
@@ -582,6 +605,33 @@ inline Locker::~Locker()
 class Thread;
 typedef bool ( * OnProcess ) ( const Thread& owner, void* userData );
 
+/** \brief Scheduling parameters applied when a thread is started.
+*
+* With POLICY_INHERIT the thread keeps the scheduling of its creator. An
+* empty \c cpus list leaves the CPU affinity untouched; a CPU index the
+* platform cannot represent makes Thread::start fail.
+*/
+struct ThreadSchedule
+{
+    enum Policy
+    {
+        POLICY_INHERIT,
+        POLICY_FIFO,
+        POLICY_ROUND_ROBIN
+    };
+
+    ThreadSchedule();
+
+    Policy policy;
+    int priority;
+    std::vector< int > cpus;
+};
+
+inline ThreadSchedule::ThreadSchedule()
+        : policy( POLICY_INHERIT )
+        , priority( 0 )
+{}
+
 /** \brief Thread management interface.
 *
 * This class provides the interface for the thread managing OS-specific
@@ -640,18 +690,31 @@ public:
     * \retval false in all other cases (still running, not started).
     */
     virtual bool isTerminated() = 0;
+    /** \brief Method setting the scheduling used by the next start().
+    *
+    * \param[in] schedule policy, priority and CPU set of the thread.
+    */
+    void setSchedule( const ThreadSchedule& schedule );
 protected:
     /** \brief Callback function.
     *
     * This function is executed in the separate thread.
     */
     OnProcess mOnProcess;
+    /** \brief Scheduling applied when the thread is created.
+    */
+    ThreadSchedule mSchedule;
 };
 
 inline Thread::Thread( OnProcess onProcess )
         : mOnProcess( onProcess )
 {}
 
+inline void Thread::setSchedule( const ThreadSchedule& schedule )
+{
+    mSchedule = schedule;
+}
+
 inline Thread::~Thread()
 {}
 
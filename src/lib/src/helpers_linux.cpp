@@ -180,14 +180,6 @@ bool LinThread::start( void* userData )
     }
     _UserData = userData;
 
-    // Suggestion to use _beginthreadex...
-    _Handle = new pthread_t();
-
-    if ( _Handle == 0 )
-    {
-        return false;
-    }
-
     pthread_attr_t threadAttr;
 
     // init thread attributes structure
@@ -201,22 +193,82 @@ bool LinThread::start( void* userData )
                                           PTHREAD_CREATE_JOINABLE );
     if ( retval != 0 )
     {
+        pthread_attr_destroy( &threadAttr );
         return false;
     }
 
-    retval = pthread_attr_setinheritsched( &threadAttr,
-                                           PTHREAD_INHERIT_SCHED );
-    if ( retval != 0 )
+    if ( mSchedule.policy == ThreadSchedule::POLICY_INHERIT )
     {
-        return false;
+        retval = pthread_attr_setinheritsched( &threadAttr,
+                                               PTHREAD_INHERIT_SCHED );
+        if ( retval != 0 )
+        {
+            pthread_attr_destroy( &threadAttr );
+            return false;
+        }
+    }
+    else
+    {
+        int policy( mSchedule.policy == ThreadSchedule::POLICY_FIFO ?
+                    SCHED_FIFO : SCHED_RR );
+        sched_param param;
+        memset( &param, 0, sizeof( param ) );
+        param.sched_priority = mSchedule.priority;
+
+        retval = pthread_attr_setinheritsched( &threadAttr,
+                                               PTHREAD_EXPLICIT_SCHED );
+        if ( retval == 0 )
+        {
+            retval = pthread_attr_setschedpolicy( &threadAttr, policy );
+        }
+        if ( retval == 0 )
+        {
+            retval = pthread_attr_setschedparam( &threadAttr, &param );
+        }
+        if ( retval != 0 )
+        {
+            pthread_attr_destroy( &threadAttr );
+            return false;
+        }
     }
 
+    if ( ! mSchedule.cpus.empty() )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        for ( size_t i( 0u ); i < mSchedule.cpus.size(); ++i )
+        {
+            // CPU_SET does not check its index.
+            if ( mSchedule.cpus[ i ] < 0 || mSchedule.cpus[ i ] >= CPU_SETSIZE )
+            {
+                pthread_attr_destroy( &threadAttr );
+                return false;
+            }
+            CPU_SET( mSchedule.cpus[ i ], &cpus );
+        }
+        retval = pthread_attr_setaffinity_np( &threadAttr, sizeof( cpus ),
+                                              &cpus );
+        if ( retval != 0 )
+        {
+            pthread_attr_destroy( &threadAttr );
+            return false;
+        }
+    }
+
+    // Only allocated once nothing but pthread_create can fail, so that a
+    // failed start never leaves a handle for stop() to join.
+    _Handle = new pthread_t();
+
     // create thread
     retval = pthread_create( _Handle, &threadAttr,
                              LinThread::threadProc,
                              reinterpret_cast< void* >( this ) );
     if ( retval != 0 )
     {
+        // EPERM here means the real-time policy was refused.
+        pthread_attr_destroy( &threadAttr );
+        delete _Handle;
+        _Handle = 0;
         return false;
     }
 
@@ -246,17 +298,17 @@ bool LinThread::stop()
     {
         return true;
     }
-    if ( _Status == THREAD_CREATED || _Status == THREAD_TERMINATED )
-    {
-        return true;
-    }
-
+    // Always join: the thread may not have updated its status yet.
     int retval( pthread_join( *_Handle, 0 ) );
     if ( retval != 0 )
     {
         return false;
     }
 
+    delete _Handle;
+    _Handle = 0;
+    _Status = THREAD_CREATED;
+
     return true;
 }
 
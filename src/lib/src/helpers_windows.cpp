@@ -255,8 +255,45 @@ bool WinThread::start( void* userData )
 
     // Suggestion to use _beginthreadex...
     mHandle = CreateThread( 0, 0, threadProc,
-                            reinterpret_cast< void* >( this ), 0, 0 );
-    return mHandle != 0 ? true : false;
+                            reinterpret_cast< void* >( this ),
+                            CREATE_SUSPENDED, 0 );
+    if ( mHandle == 0 )
+    {
+        return false;
+    }
+
+    // Windows has no SCHED_FIFO, time critical is the closest class.
+    bool applied( true );
+    if ( mSchedule.policy != ThreadSchedule::POLICY_INHERIT )
+    {
+        applied = SetThreadPriority( mHandle,
+                                     THREAD_PRIORITY_TIME_CRITICAL ) != 0;
+    }
+    if ( applied && ! mSchedule.cpus.empty() )
+    {
+        DWORD_PTR mask( 0u );
+        for ( size_t i( 0u ); applied && i < mSchedule.cpus.size(); ++i )
+        {
+            // Shifting past the mask width is undefined.
+            applied = mSchedule.cpus[ i ] >= 0 &&
+                      mSchedule.cpus[ i ] < int( sizeof( DWORD_PTR ) * 8u );
+            if ( applied )
+            {
+                mask |= DWORD_PTR( 1u ) << mSchedule.cpus[ i ];
+            }
+        }
+        applied = applied && SetThreadAffinityMask( mHandle, mask ) != 0;
+    }
+    if ( ! applied )
+    {
+        TerminateThread( mHandle, 0L );
+        CloseHandle( mHandle );
+        mHandle = 0;
+        return false;
+    }
+
+    ResumeThread( mHandle );
+    return true;
 }
 
 bool WinThread::isStarted() const
@@ -275,7 +312,11 @@ bool WinThread::stop()
     {
         return true; // Silent error
     }
-    // DWORD exitCode;
+    // Give the process function a chance to return before killing it.
+    if ( WaitForSingleObject( mHandle, 5000u ) == WAIT_OBJECT_0 )
+    {
+        mStatus = THREAD_TERMINATED;
+    }
     if ( ! isTerminated() )
     {
         if ( ! TerminateThread( mHandle, 0L ) )
@@ -285,6 +326,7 @@ bool WinThread::stop()
     }
 
     CloseHandle( mHandle );
+    mHandle = 0;
 
     return true;
 }
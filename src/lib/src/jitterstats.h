@@ -0,0 +1,90 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <atracsyswrapper/atracsysrealtime.h>
+
+/** \brief Frame interval jitter, single writer.
+ *
+ * Deviations are binned in power-of-two microsecond buckets so the
+ * percentile can be read without storing samples.
+ */
+class JitterStats {
+public:
+    static const size_t BUCKETS = 32;
+
+    void frameArrived(uint64_t nowUS) {
+        const uint64_t previous = lastUS;
+        lastUS = nowUS;
+        if (previous == 0 || nowUS <= previous) {
+            return;
+        }
+
+        const double interval = double(nowUS - previous);
+        double period = periodUS.load(std::memory_order_relaxed);
+        if (period == 0.0) {
+            periodUS.store(interval, std::memory_order_relaxed);
+            return;
+        }
+        const double deviation = std::fabs(interval - period);
+        period += (interval - period) / 64.0;
+        periodUS.store(period, std::memory_order_relaxed);
+
+        increment(samples);
+        sumUS.store(sumUS.load(std::memory_order_relaxed) + deviation, std::memory_order_relaxed);
+        if (deviation > maxUS.load(std::memory_order_relaxed)) {
+            maxUS.store(deviation, std::memory_order_relaxed);
+        }
+        size_t bucket = 0;
+        for (uint64_t value = uint64_t(deviation); value != 0 && bucket + 1 < BUCKETS; value >>= 1) {
+            ++bucket;
+        }
+        increment(histogram[bucket]);
+    }
+
+    // The next interval spans a missed frame, do not count it.
+    void frameMissed() {
+        lastUS = 0;
+    }
+
+    AtracsysJitterStats snapshot() const {
+        AtracsysJitterStats stats;
+        stats.samples = samples.load(std::memory_order_relaxed);
+        stats.periodUS = periodUS.load(std::memory_order_relaxed);
+        stats.maxUS = maxUS.load(std::memory_order_relaxed);
+        if (stats.samples == 0) {
+            return stats;
+        }
+        stats.meanUS = sumUS.load(std::memory_order_relaxed) / double(stats.samples);
+
+        // Upper bound of the bucket holding the 99th percentile.
+        const uint64_t rank = stats.samples - stats.samples / 100;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += histogram[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                stats.p99US = std::fmin(double(uint64_t(1) << bucket), stats.maxUS);
+                break;
+            }
+        }
+        return stats;
+    }
+
+private:
+    static void increment(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t lastUS = 0;
+    std::atomic<uint64_t> samples{0};
+    std::atomic<double> periodUS{0.0};
+    std::atomic<double> sumUS{0.0};
+    std::atomic<double> maxUS{0.0};
+    std::array<std::atomic<uint64_t>, BUCKETS> histogram{};
+};
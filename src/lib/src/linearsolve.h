@@ -0,0 +1,41 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+// Solves the N x N system in place by Gaussian elimination with partial pivoting.
+template<int N>
+inline bool solveLinear(double m[N][N], double b[N], double x[N]) {
+    for (int column = 0; column < N; ++column) {
+        int pivot = column;
+        for (int row = column + 1; row < N; ++row) {
+            if (std::fabs(m[row][column]) > std::fabs(m[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(m[pivot][column]) < 1e-12) {
+            return false;
+        }
+        std::swap(m[pivot], m[column]);
+        std::swap(b[pivot], b[column]);
+        for (int row = column + 1; row < N; ++row) {
+            const double factor = m[row][column] / m[column][column];
+            for (int k = column; k < N; ++k) {
+                m[row][k] -= factor * m[column][k];
+            }
+            b[row] -= factor * b[column];
+        }
+    }
+    for (int row = N - 1; row >= 0; --row) {
+        double value = b[row];
+        for (int k = row + 1; k < N; ++k) {
+            value -= m[row][k] * x[k];
+        }
+        x[row] = value / m[row][row];
+    }
+    return true;
+}
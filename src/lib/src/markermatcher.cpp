@@ -0,0 +1,274 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "markermatcher.h"
+#include "posemath.h"
+#include "rigidfit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Keeps the bucket count bounded for a zero tolerance.
+const float MIN_BUCKET_WIDTH_MM = 0.01f;
+
+float distance(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+    const float dx = a[0] - b[0];
+    const float dy = a[1] - b[1];
+    const float dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+}
+
+void MarkerMatcher::setOptions(const AtracsysMatchingOptions& newOptions) {
+    options = newOptions;
+    rebuildIndex();
+}
+
+bool MarkerMatcher::addGeometry(uint32_t geometryId, const Point* fiducials, size_t count) {
+    if (count < 3 || count > MAX_GEOMETRY_FIDUCIALS) {
+        return false;
+    }
+    auto existing = std::find_if(geometries.begin(), geometries.end(),
+                                 [geometryId](const Geometry& geometry) { return geometry.id == geometryId; });
+    if (existing == geometries.end()) {
+        if (geometries.size() == MAX_GEOMETRIES) {
+            return false;
+        }
+        existing = geometries.insert(geometries.end(), Geometry());
+    }
+
+    Geometry& geometry = *existing;
+    geometry.id = geometryId;
+    geometry.count = uint32_t(count);
+    for (size_t a = 0; a < count; ++a) {
+        geometry.fiducials[a] = fiducials[a];
+        for (size_t b = 0; b < count; ++b) {
+            geometry.distances[a][b] = distance(fiducials[a], fiducials[b]);
+        }
+    }
+    rebuildIndex();
+    return true;
+}
+
+void MarkerMatcher::rebuildIndex() {
+    const float width = std::max(options.distanceToleranceMM, MIN_BUCKET_WIDTH_MM);
+    float longest = 0.f;
+    for (const Geometry& geometry : geometries) {
+        for (uint32_t a = 0; a < geometry.count; ++a) {
+            for (uint32_t b = a + 1; b < geometry.count; ++b) {
+                longest = std::max(longest, geometry.distances[a][b]);
+            }
+        }
+    }
+    const size_t buckets = size_t(longest / width) + 2;
+
+    bucketStart.assign(buckets + 1, 0);
+    for (const Geometry& geometry : geometries) {
+        for (uint32_t a = 0; a < geometry.count; ++a) {
+            for (uint32_t b = a + 1; b < geometry.count; ++b) {
+                ++bucketStart[size_t(geometry.distances[a][b] / width) + 1];
+            }
+        }
+    }
+    for (size_t k = 1; k <= buckets; ++k) {
+        bucketStart[k] += bucketStart[k - 1];
+    }
+
+    edges.resize(bucketStart[buckets]);
+    std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t g = 0; g < geometries.size(); ++g) {
+        const Geometry& geometry = geometries[g];
+        for (uint32_t a = 0; a < geometry.count; ++a) {
+            for (uint32_t b = a + 1; b < geometry.count; ++b) {
+                const float length = geometry.distances[a][b];
+                edges[fill[size_t(length / width)]++] = { length, uint16_t(g), uint8_t(a), uint8_t(b) };
+            }
+        }
+    }
+}
+
+size_t MarkerMatcher::match(const Point* cloud, size_t count, Match* matches, size_t capacity) {
+    const size_t n = std::min(count, size_t(MAX_FIDUCIALS));
+    const float width = std::max(options.distanceToleranceMM, MIN_BUCKET_WIDTH_MM);
+    const size_t buckets = bucketStart.size() - 1;
+
+    distances.resize(n * n);
+    for (size_t i = 0; i < n; ++i) {
+        distances[i * n + i] = 0.f;
+        for (size_t j = i + 1; j < n; ++j) {
+            distances[i * n + j] = distances[j * n + i] = distance(cloud[i], cloud[j]);
+        }
+    }
+
+    best.resize(geometries.size());
+    for (Hypothesis& hypothesis : best) {
+        hypothesis.valid = false;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = i + 1; j < n; ++j) {
+            const float length = distances[i * n + j];
+            const size_t bucket = size_t(length / width);
+            if (bucket > buckets) {
+                continue;
+            }
+            // Edges within the tolerance lie in this bucket or a neighbouring one.
+            const size_t first = bucketStart[bucket > 0 ? bucket - 1 : 0];
+            const size_t last = bucketStart[std::min(bucket + 2, buckets)];
+            for (size_t e = first; e < last; ++e) {
+                const Edge& edge = edges[e];
+                if (std::fabs(edge.length - length) > options.distanceToleranceMM) {
+                    continue;
+                }
+                const Hypothesis& current = best[edge.geometry];
+                if (current.valid && current.found == geometries[edge.geometry].count) {
+                    continue;
+                }
+                grow(cloud, n, edge.geometry, i, j, edge.a, edge.b);
+                grow(cloud, n, edge.geometry, j, i, edge.a, edge.b);
+            }
+        }
+    }
+
+    order.clear();
+    for (uint32_t g = 0; g < best.size(); ++g) {
+        if (best[g].valid) {
+            order.push_back(g);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return best[a].found != best[b].found ? best[a].found > best[b].found : best[a].errorMM < best[b].errorMM;
+    });
+
+    used.assign(n, 0);
+    size_t result = 0;
+    for (uint32_t g : order) {
+        if (result == capacity) {
+            break;
+        }
+        const Geometry& geometry = geometries[g];
+        const Hypothesis& hypothesis = best[g];
+        bool free = true;
+        for (uint32_t c = 0; c < geometry.count && free; ++c) {
+            free = hypothesis.fiducials[c] == NO_FIDUCIAL || used[hypothesis.fiducials[c]] == 0;
+        }
+        if (!free) {
+            continue;
+        }
+
+        Match& match = matches[result++];
+        match.geometryId = geometry.id;
+        match.presenceMask = 0;
+        match.fiducials.fill(uint32_t(NO_FIDUCIAL));
+        for (uint32_t c = 0; c < geometry.count; ++c) {
+            match.fiducials[c] = hypothesis.fiducials[c];
+            if (hypothesis.fiducials[c] != NO_FIDUCIAL) {
+                match.presenceMask |= 1u << c;
+                used[hypothesis.fiducials[c]] = 1;
+            }
+        }
+        match.transform = hypothesis.transform;
+        match.registrationErrorMM = hypothesis.errorMM;
+    }
+    return result;
+}
+
+void MarkerMatcher::grow(const Point* cloud, size_t count, uint32_t g, uint32_t first, uint32_t second,
+                         uint32_t a, uint32_t b) {
+    const Geometry& geometry = geometries[g];
+    const float tolerance = options.distanceToleranceMM;
+    const uint32_t needed = std::max<uint32_t>(options.minFiducials, 3);
+    Hypothesis& current = best[g];
+
+    std::array<uint32_t, MAX_GEOMETRY_FIDUCIALS> assigned;
+    assigned.fill(uint32_t(NO_FIDUCIAL));
+    assigned[a] = first;
+    assigned[b] = second;
+    uint32_t found = 2;
+    uint32_t remaining = geometry.count - 2;
+
+    const float* fromFirst = &distances[first * count];
+    const float* fromSecond = &distances[second * count];
+    for (uint32_t c = 0; c < geometry.count; ++c) {
+        if (c == a || c == b) {
+            continue;
+        }
+        // Stop once this seed cannot reach the minimum or beat the current hypothesis.
+        if (found + remaining < needed || (current.valid && found + remaining < current.found)) {
+            return;
+        }
+        --remaining;
+
+        uint32_t bestFiducial = NO_FIDUCIAL;
+        float bestError = std::numeric_limits<float>::max();
+        for (uint32_t k = 0; k < count; ++k) {
+            float error = std::fabs(fromFirst[k] - geometry.distances[a][c]);
+            if (error > tolerance) {
+                continue;
+            }
+            const float secondError = std::fabs(fromSecond[k] - geometry.distances[b][c]);
+            if (secondError > tolerance || k == first || k == second) {
+                continue;
+            }
+            error += secondError;
+            // Also consistent with the fiducials assigned so far.
+            const float* fromK = &distances[k * count];
+            bool consistent = true;
+            for (uint32_t other = 0; other < geometry.count && consistent; ++other) {
+                if (other == a || other == b || assigned[other] == NO_FIDUCIAL) {
+                    continue;
+                }
+                const float otherError = std::fabs(fromK[assigned[other]] - geometry.distances[c][other]);
+                consistent = assigned[other] != k && otherError <= tolerance;
+                error += otherError;
+            }
+            if (consistent && error < bestError) {
+                bestError = error;
+                bestFiducial = k;
+            }
+        }
+        if (bestFiducial != NO_FIDUCIAL) {
+            assigned[c] = bestFiducial;
+            ++found;
+        }
+    }
+    if (found < needed || (current.valid && found < current.found)) {
+        return;
+    }
+
+    std::array<Point, MAX_GEOMETRY_FIDUCIALS> source;
+    std::array<Point, MAX_GEOMETRY_FIDUCIALS> target;
+    size_t pairs = 0;
+    for (uint32_t c = 0; c < geometry.count; ++c) {
+        if (assigned[c] != NO_FIDUCIAL) {
+            source[pairs] = geometry.fiducials[c];
+            target[pairs] = cloud[assigned[c]];
+            ++pairs;
+        }
+    }
+    AtracsysMarker::Transform transform;
+    if (!fitRigid(source.data(), target.data(), nullptr, pairs, transform)) {
+        return;
+    }
+    double sum = 0.0;
+    for (size_t p = 0; p < pairs; ++p) {
+        const float residual = distance(posemath::transformPoint(transform, source[p]), target[p]);
+        sum += double(residual) * residual;
+    }
+    const float errorMM = float(std::sqrt(sum / double(pairs)));
+    if (errorMM > options.maxRegistrationErrorMM) {
+        return;
+    }
+    if (!current.valid || found > current.found || errorMM < current.errorMM) {
+        current.valid = true;
+        current.found = found;
+        current.errorMM = errorMM;
+        current.fiducials = assigned;
+        current.transform = transform;
+    }
+}
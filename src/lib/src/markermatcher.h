@@ -0,0 +1,88 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atracsyswrapper/atracsysmarker.h>
+#include <atracsyswrapper/atracsysmatching.h>
+
+/** \brief Identifies geometries in a cloud of 3D fiducials.
+ *
+ * Every pairwise fiducial distance of every geometry is indexed by its
+ * length quantised to the distance tolerance, so a frame pair only meets the
+ * geometry edges of about its own length. Each such pair seeds a hypothesis
+ * that is grown with the fiducials at the right distance from both seeds and
+ * checked with a closed-form rigid fit; overlapping hypotheses are then
+ * resolved greedily, most fiducials and lowest residual first.
+ *
+ * Geometries and options must not change while match() runs; match() keeps
+ * its scratch buffers and does not allocate once they have grown.
+ */
+class MarkerMatcher {
+public:
+    static const size_t MAX_GEOMETRIES = 64;
+    static const size_t MAX_GEOMETRY_FIDUCIALS = 16;
+    static const size_t MAX_FIDUCIALS = 512;
+    static const uint32_t NO_FIDUCIAL = UINT32_MAX;
+
+    typedef std::array<float, 3> Point;
+
+    struct Match {
+        uint32_t geometryId;
+        uint32_t presenceMask;
+        // Index into the matched cloud per geometry fiducial, or NO_FIDUCIAL.
+        std::array<uint32_t, MAX_GEOMETRY_FIDUCIALS> fiducials;
+        AtracsysMarker::Transform transform;
+        float registrationErrorMM;
+    };
+
+    void setOptions(const AtracsysMatchingOptions& options);
+    bool addGeometry(uint32_t geometryId, const Point* fiducials, size_t count);
+    size_t getGeometryCount() const { return geometries.size(); }
+
+    // Writes at most `capacity` matches, one per geometry found.
+    size_t match(const Point* fiducials, size_t count, Match* matches, size_t capacity);
+
+private:
+    struct Geometry {
+        uint32_t id;
+        uint32_t count;
+        std::array<Point, MAX_GEOMETRY_FIDUCIALS> fiducials;
+        std::array<std::array<float, MAX_GEOMETRY_FIDUCIALS>, MAX_GEOMETRY_FIDUCIALS> distances;
+    };
+
+    struct Edge {
+        float length;
+        uint16_t geometry;
+        uint8_t a;
+        uint8_t b;
+    };
+
+    struct Hypothesis {
+        bool valid;
+        uint32_t found;
+        float errorMM;
+        std::array<uint32_t, MAX_GEOMETRY_FIDUCIALS> fiducials;
+        AtracsysMarker::Transform transform;
+    };
+
+    void rebuildIndex();
+    void grow(const Point* cloud, size_t count, uint32_t geometry, uint32_t first, uint32_t second,
+              uint32_t a, uint32_t b);
+
+    AtracsysMatchingOptions options;
+    std::vector<Geometry> geometries;
+    // Edges grouped by length bucket; bucket k spans bucketStart[k] .. bucketStart[k + 1].
+    std::vector<Edge> edges;
+    std::vector<uint32_t> bucketStart;
+
+    std::vector<float> distances;
+    std::vector<Hypothesis> best;
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> used;
+};
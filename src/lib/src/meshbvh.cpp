@@ -0,0 +1,269 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "meshbvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int MAX_DEPTH = 64;
+
+float boxDistanceSquared(const float min[3], const float max[3], const float p[3]) {
+    float result = 0.f;
+    for (int k = 0; k < 3; ++k) {
+        const float below = min[k] - p[k];
+        const float above = p[k] - max[k];
+        const float d = below > 0.f ? below : (above > 0.f ? above : 0.f);
+        result += d * d;
+    }
+    return result;
+}
+
+float dot(const float a[3], const float b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+}
+
+bool MeshBvh::build(const AtracsysMesh& mesh) {
+    nodes.clear();
+    triangles.clear();
+    for (const std::array<uint32_t, 3>& triangle : mesh.triangles) {
+        for (uint32_t index : triangle) {
+            if (index >= mesh.vertices.size()) {
+                return false;
+            }
+        }
+    }
+    if (mesh.triangles.empty() || mesh.triangles.size() >= NO_TRIANGLE) {
+        return false;
+    }
+
+    const uint32_t count = uint32_t(mesh.triangles.size());
+    std::vector<uint32_t> order(count);
+    std::vector<std::array<float, 3>> centroids(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        order[i] = i;
+        for (int k = 0; k < 3; ++k) {
+            centroids[i][k] = (mesh.vertices[mesh.triangles[i][0]][k] + mesh.vertices[mesh.triangles[i][1]][k] +
+                               mesh.vertices[mesh.triangles[i][2]][k]) / 3.f;
+        }
+    }
+
+    nodes.reserve(2 * (count / LEAF_SIZE + 1));
+    triangles.resize(count);
+    buildNode(order, centroids, 0, count, mesh);
+    return true;
+}
+
+uint32_t MeshBvh::buildNode(std::vector<uint32_t>& order, std::vector<std::array<float, 3>>& centroids,
+                            uint32_t first, uint32_t count, const AtracsysMesh& mesh) {
+    const uint32_t index = uint32_t(nodes.size());
+    nodes.push_back(Node());
+
+    Node node;
+    float centroidMin[3];
+    float centroidMax[3];
+    for (int k = 0; k < 3; ++k) {
+        node.min[k] = centroidMin[k] = std::numeric_limits<float>::max();
+        node.max[k] = centroidMax[k] = -std::numeric_limits<float>::max();
+    }
+    for (uint32_t i = first; i < first + count; ++i) {
+        for (uint32_t corner : mesh.triangles[order[i]]) {
+            for (int k = 0; k < 3; ++k) {
+                node.min[k] = std::min(node.min[k], mesh.vertices[corner][k]);
+                node.max[k] = std::max(node.max[k], mesh.vertices[corner][k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            centroidMin[k] = std::min(centroidMin[k], centroids[order[i]][k]);
+            centroidMax[k] = std::max(centroidMax[k], centroids[order[i]][k]);
+        }
+    }
+
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (centroidMax[k] - centroidMin[k] > centroidMax[axis] - centroidMin[axis]) {
+            axis = k;
+        }
+    }
+
+    if (count <= LEAF_SIZE || centroidMax[axis] <= centroidMin[axis]) {
+        node.offset = first;
+        node.count = count;
+        for (uint32_t i = first; i < first + count; ++i) {
+            const std::array<uint32_t, 3>& source = mesh.triangles[order[i]];
+            Triangle& triangle = triangles[i];
+            for (int k = 0; k < 3; ++k) {
+                triangle.a[k] = mesh.vertices[source[0]][k];
+                triangle.b[k] = mesh.vertices[source[1]][k];
+                triangle.c[k] = mesh.vertices[source[2]][k];
+            }
+            const float ab[3] = { triangle.b[0] - triangle.a[0], triangle.b[1] - triangle.a[1], triangle.b[2] - triangle.a[2] };
+            const float ac[3] = { triangle.c[0] - triangle.a[0], triangle.c[1] - triangle.a[1], triangle.c[2] - triangle.a[2] };
+            float n[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+            const float length = std::sqrt(dot(n, n));
+            for (int k = 0; k < 3; ++k) {
+                triangle.normal[k] = length > 0.f ? n[k] / length : 0.f;
+            }
+        }
+        nodes[index] = node;
+        return index;
+    }
+
+    const uint32_t half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                     [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    node.count = 0;
+    buildNode(order, centroids, first, half, mesh);
+    node.offset = buildNode(order, centroids, first + half, count - half, mesh);
+    nodes[index] = node;
+    return index;
+}
+
+// Ericson, Real-Time Collision Detection, 5.1.5: Voronoi regions of the triangle.
+void MeshBvh::closestOnTriangle(const Triangle& t, const float p[3], float result[3]) const {
+    const float ab[3] = { t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2] };
+    const float ac[3] = { t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2] };
+    const float ap[3] = { p[0] - t.a[0], p[1] - t.a[1], p[2] - t.a[2] };
+    const float d1 = dot(ab, ap);
+    const float d2 = dot(ac, ap);
+    if (d1 <= 0.f && d2 <= 0.f) {
+        std::copy(t.a, t.a + 3, result);
+        return;
+    }
+
+    const float bp[3] = { p[0] - t.b[0], p[1] - t.b[1], p[2] - t.b[2] };
+    const float d3 = dot(ab, bp);
+    const float d4 = dot(ac, bp);
+    if (d3 >= 0.f && d4 <= d3) {
+        std::copy(t.b, t.b + 3, result);
+        return;
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+        const float v = d1 / (d1 - d3);
+        for (int k = 0; k < 3; ++k) {
+            result[k] = t.a[k] + v * ab[k];
+        }
+        return;
+    }
+
+    const float cp[3] = { p[0] - t.c[0], p[1] - t.c[1], p[2] - t.c[2] };
+    const float d5 = dot(ab, cp);
+    const float d6 = dot(ac, cp);
+    if (d6 >= 0.f && d5 <= d6) {
+        std::copy(t.c, t.c + 3, result);
+        return;
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+        const float w = d2 / (d2 - d6);
+        for (int k = 0; k < 3; ++k) {
+            result[k] = t.a[k] + w * ac[k];
+        }
+        return;
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f) {
+        const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        for (int k = 0; k < 3; ++k) {
+            result[k] = t.b[k] + w * (t.c[k] - t.b[k]);
+        }
+        return;
+    }
+
+    const float denominator = 1.f / (va + vb + vc);
+    const float v = vb * denominator;
+    const float w = vc * denominator;
+    for (int k = 0; k < 3; ++k) {
+        result[k] = t.a[k] + ab[k] * v + ac[k] * w;
+    }
+}
+
+bool MeshBvh::closest(const std::array<float, 3>& query, uint32_t hint, Hit& hit) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    const float* p = query.data();
+
+    float best = std::numeric_limits<float>::max();
+    uint32_t bestTriangle = NO_TRIANGLE;
+    float bestPoint[3] = { 0.f, 0.f, 0.f };
+    auto test = [&](uint32_t index) {
+        const Triangle& triangle = triangles[index];
+        // The distance to the supporting plane bounds the distance to the triangle.
+        const float ap[3] = { p[0] - triangle.a[0], p[1] - triangle.a[1], p[2] - triangle.a[2] };
+        const float plane = dot(triangle.normal, ap);
+        if (plane * plane >= best) {
+            return;
+        }
+        float candidate[3];
+        closestOnTriangle(triangle, p, candidate);
+        const float d[3] = { candidate[0] - p[0], candidate[1] - p[1], candidate[2] - p[2] };
+        const float distance = dot(d, d);
+        if (distance < best) {
+            best = distance;
+            bestTriangle = index;
+            std::copy(candidate, candidate + 3, bestPoint);
+        }
+    };
+    if (hint < triangles.size()) {
+        test(hint);
+    }
+
+    // Box distances are computed once, when a node is pushed, and rechecked against the shrinking best on pop.
+    struct Entry {
+        uint32_t node;
+        float distanceSquared;
+    };
+    Entry stack[MAX_DEPTH];
+    int top = 0;
+    stack[top++] = { 0, boxDistanceSquared(nodes[0].min, nodes[0].max, p) };
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        if (entry.distanceSquared >= best) {
+            continue;
+        }
+        const Node& node = nodes[entry.node];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+                test(i);
+            }
+            continue;
+        }
+
+        // Visit the nearer child first: push it last.
+        const uint32_t left = entry.node + 1;
+        const uint32_t right = node.offset;
+        const float leftDistance = boxDistanceSquared(nodes[left].min, nodes[left].max, p);
+        const float rightDistance = boxDistanceSquared(nodes[right].min, nodes[right].max, p);
+        const bool leftFirst = leftDistance <= rightDistance;
+        const Entry nearChild = { leftFirst ? left : right, leftFirst ? leftDistance : rightDistance };
+        const Entry farChild = { leftFirst ? right : left, leftFirst ? rightDistance : leftDistance };
+        if (farChild.distanceSquared < best && top < MAX_DEPTH) {
+            stack[top++] = farChild;
+        }
+        if (nearChild.distanceSquared < best && top < MAX_DEPTH) {
+            stack[top++] = nearChild;
+        }
+    }
+
+    // Nothing wins for a non-finite query.
+    if (bestTriangle == NO_TRIANGLE) {
+        return false;
+    }
+    hit.triangle = bestTriangle;
+    hit.distanceSquared = best;
+    std::copy(bestPoint, bestPoint + 3, hit.point.begin());
+    std::copy(triangles[bestTriangle].normal, triangles[bestTriangle].normal + 3, hit.normal.begin());
+    return true;
+}
@@ -0,0 +1,63 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atracsyswrapper/atracsysmesh.h>
+
+/** \brief Immutable bounding volume hierarchy for closest-point queries on a mesh.
+ *
+ * Built once by median splits along the longest axis of the triangle
+ * centroids, stored depth first (left child follows its parent) with the
+ * triangles reordered to match the leaves. Queries only read, so any
+ * number of threads may run them concurrently. A query may pass the
+ * triangle found for the same point last time: its distance bounds the
+ * search from the start, which prunes most of the tree when the point
+ * moved little, as between ICP iterations.
+ */
+class MeshBvh {
+public:
+    static const uint32_t NO_TRIANGLE = UINT32_MAX;
+
+    struct Hit {
+        std::array<float, 3> point;
+        std::array<float, 3> normal;
+        uint32_t triangle;
+        float distanceSquared;
+    };
+
+    bool build(const AtracsysMesh& mesh);
+    size_t getTriangleCount() const { return triangles.size(); }
+
+    bool closest(const std::array<float, 3>& query, uint32_t hint, Hit& hit) const;
+
+private:
+    static const uint32_t LEAF_SIZE = 4;
+
+    struct Node {
+        float min[3];
+        float max[3];
+        // Leaf: first triangle; inner node: index of the right child.
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct Triangle {
+        float a[3];
+        float b[3];
+        float c[3];
+        float normal[3];
+    };
+
+    uint32_t buildNode(std::vector<uint32_t>& order, std::vector<std::array<float, 3>>& centroids,
+                       uint32_t first, uint32_t count, const AtracsysMesh& mesh);
+    void closestOnTriangle(const Triangle& triangle, const float p[3], float result[3]) const;
+
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+};
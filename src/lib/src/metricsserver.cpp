@@ -0,0 +1,164 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "metricsserver.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// A scrape is answered at once; a client that stalls longer would hold up stop().
+const uint32_t CLIENT_TIMEOUT_MS = 1000;
+
+// A scraper that hangs up early must not raise SIGPIPE in the host process.
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+void setClientTimeouts(SocketHandle client) {
+#ifdef _WIN32
+    DWORD timeout = CLIENT_TIMEOUT_MS;
+#else
+    timeval timeout{CLIENT_TIMEOUT_MS / 1000, (CLIENT_TIMEOUT_MS % 1000) * 1000};
+#endif
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    int enabled = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+}
+
+void lowerCurrentThreadPriority() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#else
+#ifdef SCHED_IDLE
+    sched_param param{};
+    if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) == 0) {
+        return;
+    }
+#endif
+    // Linux applies the nice value to the calling thread only.
+    setpriority(PRIO_PROCESS, 0, 19);
+#endif
+}
+
+void sendAll(SocketHandle client, const char* data, size_t size) {
+    while (size > 0) {
+        int sent = ::send(client, data, static_cast<int>(size), SEND_FLAGS);
+        if (sent <= 0) {
+            return;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+}
+
+}
+
+MetricsServer::MetricsServer(Renderer renderer)
+        : renderer(std::move(renderer)) {
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(uint16_t port) {
+    if (run) {
+        return false;
+    }
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 4) != 0) {
+        closeSocket(listener);
+        listener = INVALID_SOCKET_HANDLE;
+        return false;
+    }
+
+    run = true;
+    thread = std::thread(&MetricsServer::serve, this);
+    return true;
+}
+
+void MetricsServer::stop() {
+    run = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (listener != INVALID_SOCKET_HANDLE) {
+        closeSocket(listener);
+        listener = INVALID_SOCKET_HANDLE;
+    }
+}
+
+bool MetricsServer::isRunning() const {
+    return run;
+}
+
+void MetricsServer::serve() {
+    lowerCurrentThreadPriority();
+
+    while (run) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(listener, &readable);
+        timeval timeout{0, 200000};
+
+        // Wake up regularly so that stop() does not wait for a scrape.
+        if (select(static_cast<int>(listener) + 1, &readable, nullptr, nullptr, &timeout) <= 0) {
+            continue;
+        }
+
+        SocketHandle client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET_HANDLE) {
+            continue;
+        }
+        setClientTimeouts(client);
+        answer(client);
+        closeSocket(client);
+    }
+}
+
+void MetricsServer::answer(SocketHandle client) {
+    // Any request is answered with the metrics, the request line is not parsed.
+    char request[1024];
+    recv(client, request, sizeof(request), 0);
+
+    const std::string body = renderer();
+    char header[160];
+    int headerSize = snprintf(header, sizeof(header),
+                              "HTTP/1.0 200 OK\r\n"
+                              "Content-Type: text/plain; version=0.0.4\r\n"
+                              "Content-Length: %zu\r\n"
+                              "Connection: close\r\n\r\n",
+                              body.size());
+    sendAll(client, header, static_cast<size_t>(headerSize));
+    sendAll(client, body.data(), body.size());
+}
@@ -0,0 +1,42 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "socketcompat.h"
+
+/** \brief Minimal HTTP endpoint serving Prometheus text on the loopback
+ * interface.
+ *
+ * Runs on its own thread at the lowest scheduling priority and renders the
+ * metrics only when a scrape arrives, so the acquisition path never pays for
+ * formatting.
+ */
+class MetricsServer {
+public:
+    typedef std::function<std::string()> Renderer;
+
+    explicit MetricsServer(Renderer renderer);
+    virtual ~MetricsServer();
+
+    bool start(uint16_t port);
+    void stop();
+
+    bool isRunning() const;
+
+private:
+    void serve();
+    void answer(SocketHandle client);
+
+    Renderer renderer;
+    SocketLibrary socketLibrary;
+    SocketHandle listener = INVALID_SOCKET_HANDLE;
+    std::atomic<bool> run{false};
+    std::thread thread;
+};
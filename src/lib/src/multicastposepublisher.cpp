@@ -0,0 +1,60 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "multicastposepublisher.h"
+
+#include <random>
+
+MulticastPosePublisher::MulticastPosePublisher() = default;
+
+MulticastPosePublisher::~MulticastPosePublisher() {
+    close();
+}
+
+bool MulticastPosePublisher::open(const std::string& group, uint16_t port, uint8_t ttl) {
+    close();
+
+    destination = sockaddr_in{};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    if (inet_pton(AF_INET, group.c_str(), &destination.sin_addr) != 1) {
+        return false;
+    }
+
+    socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    if (IN_MULTICAST(ntohl(destination.sin_addr.s_addr))) {
+        int timeToLive = ttl;
+        int loop = 1;
+        setsockopt(socket, IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char*>(&timeToLive), sizeof(timeToLive));
+        setsockopt(socket, IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<const char*>(&loop), sizeof(loop));
+    }
+
+    // Lets receivers tell a restart from late datagrams of the previous stream.
+    session = uint16_t(session + 1 + std::random_device()() % 0xFFFFu);
+    sequence = 0;
+    return true;
+}
+
+void MulticastPosePublisher::close() {
+    if (socket != INVALID_SOCKET_HANDLE) {
+        closeSocket(socket);
+        socket = INVALID_SOCKET_HANDLE;
+    }
+}
+
+void MulticastPosePublisher::onFrame(const AtracsysFrame& frame) {
+    if (socket == INVALID_SOCKET_HANDLE) {
+        return;
+    }
+
+    const size_t size = AtracsysPoseDatagram::encode(frame, session, sequence++, buffer.data(), buffer.size());
+    if (sendto(socket, reinterpret_cast<const char*>(buffer.data()), static_cast<int>(size), 0,
+               reinterpret_cast<const sockaddr*>(&destination), sizeof(destination)) < 0) {
+        ++sendErrors;
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <atracsyswrapper/atracsysposedatagram.h>
+#include "framelistener.h"
+#include "socketcompat.h"
+
+/** \brief Sends one AtracsysPoseDatagram per frame to a UDP group.
+ *
+ * The datagram is encoded into a member buffer, so publishing does not
+ * allocate. Multicast uses the given TTL and keeps loopback enabled so that
+ * local receivers see the stream too.
+ */
+class MulticastPosePublisher : public FrameListener {
+public:
+    MulticastPosePublisher();
+    ~MulticastPosePublisher() override;
+
+    bool open(const std::string& group, uint16_t port, uint8_t ttl);
+    void close();
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+    uint64_t getSendErrors() const { return sendErrors; }
+
+private:
+    SocketLibrary socketLibrary;
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    sockaddr_in destination{};
+    uint16_t session = 0;
+    uint32_t sequence = 0;
+    uint64_t sendErrors = 0;
+    std::array<uint8_t, AtracsysPoseDatagram::MAX_SIZE> buffer{};
+};
@@ -0,0 +1,192 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "pivotcalibration.h"
+
+#include <cmath>
+#include <utility>
+
+namespace {
+
+const uint64_t MIN_SAMPLES_FOR_REJECTION = 200;
+// Below this the RMS is too small to judge outliers by ratio alone.
+const float MIN_REJECTION_MM = 0.25f;
+// Smallest elimination pivot per sample; about 8 degrees of tilt around the pivot.
+const double MIN_PIVOT_PER_SAMPLE = 0.01;
+const int MAX_READ_ATTEMPTS = 64;
+
+}
+
+void PivotCalibration::start(uint32_t geometryId, float rejectionFactor) {
+    requestedGeometry.store(geometryId, std::memory_order_relaxed);
+    requestedRejection.store(rejectionFactor, std::memory_order_relaxed);
+    requestedSession.fetch_add(1, std::memory_order_release);
+}
+
+void PivotCalibration::stop() {
+    start(NO_GEOMETRY, 0.f);
+}
+
+bool PivotCalibration::getResult(AtracsysPivotCalibration& result) const {
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            continue;
+        }
+        AtracsysPivotCalibration copy = published;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            result = copy;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PivotCalibration::onFrame(const AtracsysFrame& frame) {
+    const uint32_t requested = requestedSession.load(std::memory_order_acquire);
+    if (requested != session) {
+        session = requested;
+        const uint32_t geometry = requestedGeometry.load(std::memory_order_relaxed);
+        rejectionFactor = requestedRejection.load(std::memory_order_relaxed);
+        // Stopping keeps the last result readable.
+        if (geometry != NO_GEOMETRY) {
+            reset(geometry);
+            publish();
+        }
+        geometryId = geometry;
+    }
+    if (geometryId == NO_GEOMETRY) {
+        return;
+    }
+
+    const AtracsysPose* pose = frame.findPose(geometryId);
+    if (pose == nullptr) {
+        return;
+    }
+
+    if (current.solved && current.samples >= MIN_SAMPLES_FOR_REJECTION) {
+        const float limit = std::fmax(rejectionFactor * current.rmsMM, MIN_REJECTION_MM);
+        if (residual(pose->transform) > limit) {
+            ++current.rejected;
+            publish();
+            return;
+        }
+    }
+
+    accumulate(pose->transform);
+    ++current.samples;
+    current.solved = solve();
+    publish();
+}
+
+void PivotCalibration::reset(uint32_t geometryId) {
+    for (int row = 0; row < 6; ++row) {
+        for (int column = 0; column < 6; ++column) {
+            normal[row][column] = 0.0;
+        }
+        rightSide[row] = 0.0;
+        solution[row] = 0.0;
+    }
+    translationSquares = 0.0;
+    current = AtracsysPivotCalibration();
+    current.geometryId = geometryId;
+}
+
+void PivotCalibration::accumulate(const AtracsysMarker::Transform& transform) {
+    // A = [R | -I], b = -t:  A^T A = [I, -R^T; -R, I],  A^T b = [-R^T t; t].
+    const double t[3] = { transform[0][3], transform[1][3], transform[2][3] };
+    for (int i = 0; i < 3; ++i) {
+        normal[i][i] += 1.0;
+        normal[3 + i][3 + i] += 1.0;
+        double rotatedT = 0.0;
+        for (int j = 0; j < 3; ++j) {
+            normal[i][3 + j] -= transform[j][i];
+            normal[3 + j][i] -= transform[j][i];
+            rotatedT += transform[j][i] * t[j];
+        }
+        rightSide[i] -= rotatedT;
+        rightSide[3 + i] += t[i];
+        translationSquares += t[i] * t[i];
+    }
+}
+
+bool PivotCalibration::solve() {
+    double a[6][7];
+    for (int row = 0; row < 6; ++row) {
+        for (int column = 0; column < 6; ++column) {
+            a[row][column] = normal[row][column];
+        }
+        a[row][6] = rightSide[row];
+    }
+
+    // Gaussian elimination with partial pivoting; the smallest pivot tells whether rotations were diverse enough.
+    const double minPivot = MIN_PIVOT_PER_SAMPLE * double(current.samples);
+    for (int k = 0; k < 6; ++k) {
+        int best = k;
+        for (int row = k + 1; row < 6; ++row) {
+            if (std::fabs(a[row][k]) > std::fabs(a[best][k])) {
+                best = row;
+            }
+        }
+        if (std::fabs(a[best][k]) < minPivot) {
+            return false;
+        }
+        if (best != k) {
+            for (int column = k; column < 7; ++column) {
+                std::swap(a[k][column], a[best][column]);
+            }
+        }
+        for (int row = k + 1; row < 6; ++row) {
+            const double factor = a[row][k] / a[k][k];
+            for (int column = k; column < 7; ++column) {
+                a[row][column] -= factor * a[k][column];
+            }
+        }
+    }
+    for (int row = 5; row >= 0; --row) {
+        double value = a[row][6];
+        for (int column = row + 1; column < 6; ++column) {
+            value -= a[row][column] * solution[column];
+        }
+        solution[row] = value / a[row][row];
+    }
+
+    // sum |A x - b|^2 = x^T (A^T A) x - 2 x^T (A^T b) + b^T b
+    double squares = translationSquares;
+    for (int row = 0; row < 6; ++row) {
+        double product = 0.0;
+        for (int column = 0; column < 6; ++column) {
+            product += normal[row][column] * solution[column];
+        }
+        squares += solution[row] * (product - 2.0 * rightSide[row]);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        current.tipMM[i] = float(solution[i]);
+        current.pivotMM[i] = float(solution[3 + i]);
+    }
+    current.rmsMM = float(std::sqrt(std::fmax(squares, 0.0) / double(current.samples)));
+    return true;
+}
+
+float PivotCalibration::residual(const AtracsysMarker::Transform& transform) const {
+    double squares = 0.0;
+    for (int row = 0; row < 3; ++row) {
+        double value = transform[row][3] - solution[3 + row];
+        for (int k = 0; k < 3; ++k) {
+            value += transform[row][k] * solution[k];
+        }
+        squares += value * value;
+    }
+    return float(std::sqrt(squares));
+}
+
+void PivotCalibration::publish() {
+    const uint32_t before = sequence.load(std::memory_order_relaxed);
+    sequence.store(before + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    published = current;
+    sequence.store(before + 2, std::memory_order_release);
+}
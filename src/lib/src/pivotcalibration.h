@@ -0,0 +1,59 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <atracsyswrapper/atracsyspivot.h>
+#include "framelistener.h"
+
+/** \brief Streaming least-squares pivot calibration.
+ *
+ * Every pose (R, t) of the calibrated geometry adds one block of
+ * R * tip - pivot = -t to the 6x6 normal equations, so memory stays constant
+ * and the residual RMS follows in closed form from the same sums. The system
+ * is re-solved on every frame (a few hundred flops); once enough samples are
+ * in, poses whose residual exceeds `rejectionFactor` times the RMS are
+ * dropped as outliers.
+ *
+ * Runs on the acquisition thread; start(), stop() and getResult() may be
+ * called from any thread.
+ */
+class PivotCalibration : public FrameListener {
+public:
+    static const uint32_t NO_GEOMETRY = UINT32_MAX;
+
+    void start(uint32_t geometryId, float rejectionFactor);
+    void stop();
+    bool getResult(AtracsysPivotCalibration& result) const;
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+private:
+    void reset(uint32_t geometryId);
+    void accumulate(const AtracsysMarker::Transform& transform);
+    bool solve();
+    float residual(const AtracsysMarker::Transform& transform) const;
+    void publish();
+
+    // Control, written by the caller.
+    std::atomic<uint32_t> requestedGeometry{NO_GEOMETRY};
+    std::atomic<float> requestedRejection{3.f};
+    std::atomic<uint32_t> requestedSession{0};
+
+    // Acquisition thread state.
+    uint32_t session = 0;
+    uint32_t geometryId = NO_GEOMETRY;
+    float rejectionFactor = 3.f;
+    double normal[6][6] = {};
+    double rightSide[6] = {};
+    double translationSquares = 0.0;
+    double solution[6] = {};
+    AtracsysPivotCalibration current;
+
+    // Published snapshot.
+    std::atomic<uint32_t> sequence{0};
+    AtracsysPivotCalibration published;
+};
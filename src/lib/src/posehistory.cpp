@@ -0,0 +1,199 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "posehistory.h"
+#include "posemath.h"
+
+#include <algorithm>
+
+namespace {
+const int MAX_QUERY_ATTEMPTS = 8;
+}
+
+PoseHistory::Track::Track(uint32_t geometryId, uint32_t capacity)
+        : geometryId(geometryId),
+          capacity(capacity),
+          samples(new Sample[capacity]) {
+}
+
+bool PoseHistory::addTrack(uint32_t geometryId, uint32_t capacity) {
+    if (capacity < 2) {
+        return false;
+    }
+    if (findTrack(geometryId) != nullptr) {
+        return true;
+    }
+
+    for (std::atomic<Track*>& slot : tracks) {
+        if (slot.load(std::memory_order_acquire) == nullptr) {
+            storage.push_back(std::make_unique<Track>(geometryId, capacity));
+            slot.store(storage.back().get(), std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+PoseHistory::Track* PoseHistory::findTrack(uint32_t geometryId) const {
+    for (const std::atomic<Track*>& slot : tracks) {
+        Track* track = slot.load(std::memory_order_acquire);
+        if (track == nullptr) {
+            break;
+        }
+        if (track->geometryId == geometryId) {
+            return track;
+        }
+    }
+    return nullptr;
+}
+
+void PoseHistory::onFrame(const AtracsysFrame& frame) {
+    for (uint32_t i = 0; i < frame.poseCount; ++i) {
+        Track* track = findTrack(frame.poses[i].geometryId);
+        if (track != nullptr) {
+            write(*track, frame.timestampUS, frame.poses[i]);
+        }
+    }
+}
+
+void PoseHistory::write(Track& track, uint64_t timestampUS, const AtracsysPose& pose) {
+    const uint64_t publication = track.published.load(std::memory_order_relaxed);
+    Sample& sample = track.samples[publication % track.capacity];
+    const uint32_t sequence = sample.sequence.load(std::memory_order_relaxed);
+
+    sample.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    sample.publication = publication;
+    sample.timestampUS = timestampUS;
+    sample.pose = pose;
+    sample.sequence.store(sequence + 2, std::memory_order_release);
+
+    track.published.store(publication + 1, std::memory_order_release);
+}
+
+PoseHistory::ReadResult PoseHistory::read(const Track& track, uint64_t publication, uint64_t& timestampUS,
+                                          AtracsysPose* pose) {
+    const Sample& sample = track.samples[publication % track.capacity];
+    const uint32_t before = sample.sequence.load(std::memory_order_acquire);
+    if ((before & 1u) != 0) {
+        return READ_TORN;
+    }
+
+    const uint64_t stored = sample.publication;
+    timestampUS = sample.timestampUS;
+    if (pose != nullptr) {
+        *pose = sample.pose;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sample.sequence.load(std::memory_order_relaxed) != before) {
+        return READ_TORN;
+    }
+    return stored == publication ? READ_OK : READ_GONE;
+}
+
+PoseHistory::ReadResult PoseHistory::query(const Track& track, uint64_t timestampUS, AtracsysPose& pose) {
+    const uint64_t published = track.published.load(std::memory_order_acquire);
+    if (published == 0) {
+        return READ_GONE;
+    }
+
+    // Keep one slot of margin: the oldest slot is the next one the writer reuses.
+    uint64_t low = published - std::min<uint64_t>(published, track.capacity - 1);
+    uint64_t high = published - 1;
+
+    uint64_t lowUS = 0;
+    uint64_t highUS = 0;
+    ReadResult result = read(track, low, lowUS, nullptr);
+    if (result == READ_OK) {
+        result = read(track, high, highUS, nullptr);
+    }
+    if (result != READ_OK) {
+        return result;
+    }
+    if (timestampUS < lowUS || timestampUS > highUS) {
+        return READ_GONE;
+    }
+    if (timestampUS == highUS || low == high) {
+        return read(track, high, highUS, &pose);
+    }
+
+    // Invariant: timestamp(low) <= timestampUS < timestamp(high).
+    while (high - low > 1) {
+        const uint64_t middle = low + (high - low) / 2;
+        uint64_t middleUS = 0;
+        result = read(track, middle, middleUS, nullptr);
+        if (result != READ_OK) {
+            return result;
+        }
+        if (middleUS > timestampUS) {
+            high = middle;
+        }
+        else {
+            low = middle;
+        }
+    }
+
+    AtracsysPose before;
+    AtracsysPose after;
+    result = read(track, low, lowUS, &before);
+    if (result == READ_OK) {
+        result = read(track, high, highUS, &after);
+    }
+    if (result != READ_OK) {
+        return result;
+    }
+    if (highUS - lowUS > posemath::MAX_INTERPOLATION_GAP_US) {
+        return READ_GONE;
+    }
+
+    const float alpha = highUS > lowUS ? float(double(timestampUS - lowUS) / double(highUS - lowUS)) : 0.f;
+    pose = posemath::interpolate(before, after, alpha);
+    return READ_OK;
+}
+
+bool PoseHistory::poseAt(uint32_t geometryId, uint64_t timestampUS, AtracsysPose& pose) const {
+    const Track* track = findTrack(geometryId);
+    if (track == nullptr) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < MAX_QUERY_ATTEMPTS; ++attempt) {
+        AtracsysPose result;
+        switch (query(*track, timestampUS, result)) {
+            case READ_OK:
+                pose = result;
+                return true;
+            case READ_TORN:
+                continue;
+            case READ_GONE:
+                // Either outside the history or the writer lapped us; only the latter is worth a retry.
+                if (attempt > 0) {
+                    return false;
+                }
+                continue;
+        }
+    }
+    return false;
+}
+
+bool PoseHistory::getRange(uint32_t geometryId, uint64_t& oldestUS, uint64_t& newestUS) const {
+    const Track* track = findTrack(geometryId);
+    if (track == nullptr) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < MAX_QUERY_ATTEMPTS; ++attempt) {
+        const uint64_t published = track->published.load(std::memory_order_acquire);
+        if (published == 0) {
+            return false;
+        }
+        const uint64_t oldest = published - std::min<uint64_t>(published, track->capacity - 1);
+        if (read(*track, oldest, oldestUS, nullptr) == READ_OK &&
+            read(*track, published - 1, newestUS, nullptr) == READ_OK) {
+            return true;
+        }
+    }
+    return false;
+}
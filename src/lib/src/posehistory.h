@@ -0,0 +1,69 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <atracsyswrapper/atracsysframe.h>
+#include "framelistener.h"
+#include "markermatcher.h"
+
+/** \brief Time-indexed ring of past poses, one per geometry.
+ *
+ * Each track holds a fixed number of samples in publication order, every
+ * sample guarded by its own seqlock like the shared-memory ring. Queries
+ * binary-search the timestamps and interpolate between the two neighbours;
+ * they never block the acquisition thread and retry when a sample they
+ * touched was overwritten meanwhile.
+ */
+class PoseHistory : public FrameListener {
+public:
+    static const size_t MAX_TRACKS = MarkerMatcher::MAX_GEOMETRIES;
+
+    // Tracks are never removed; adding one while frames flow is safe.
+    bool addTrack(uint32_t geometryId, uint32_t capacity);
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+    // False if `timestampUS` is outside the history or falls in a tracking gap.
+    bool poseAt(uint32_t geometryId, uint64_t timestampUS, AtracsysPose& pose) const;
+
+    // Oldest and newest timestamps currently stored.
+    bool getRange(uint32_t geometryId, uint64_t& oldestUS, uint64_t& newestUS) const;
+
+private:
+    struct alignas(64) Sample {
+        std::atomic<uint32_t> sequence{0};
+        uint64_t publication = 0;
+        uint64_t timestampUS = 0;
+        AtracsysPose pose;
+    };
+
+    struct Track {
+        Track(uint32_t geometryId, uint32_t capacity);
+
+        uint32_t geometryId;
+        uint32_t capacity;
+        std::unique_ptr<Sample[]> samples;
+        alignas(64) std::atomic<uint64_t> published{0};
+    };
+
+    enum ReadResult {
+        READ_OK,
+        READ_TORN,
+        READ_GONE
+    };
+
+    Track* findTrack(uint32_t geometryId) const;
+    static void write(Track& track, uint64_t timestampUS, const AtracsysPose& pose);
+    static ReadResult read(const Track& track, uint64_t publication, uint64_t& timestampUS, AtracsysPose* pose);
+    static ReadResult query(const Track& track, uint64_t timestampUS, AtracsysPose& pose);
+
+    std::array<std::atomic<Track*>, MAX_TRACKS> tracks{};
+    std::vector<std::unique_ptr<Track>> storage;
+};
@@ -0,0 +1,185 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <atracsyswrapper/atracsysframe.h>
+#include <atracsyswrapper/atracsysmarker.h>
+
+/** \brief Small rigid-transform helpers shared by the pose consumers.
+ *
+ * Transforms are the row-major 4x4 AtracsysMarker::Transform with the
+ * rotation in the upper-left 3x3 block and the translation in column 3.
+ */
+namespace posemath {
+
+typedef AtracsysMarker::Transform Transform;
+typedef std::array<float, 3> Vector3;
+
+// Poses further apart than this are a tracking dropout, not something to interpolate across.
+const uint64_t MAX_INTERPOLATION_GAP_US = 100000;
+
+struct Quaternion {
+    float w = 1.f;
+    float x = 0.f;
+    float y = 0.f;
+    float z = 0.f;
+};
+
+inline Transform identity() {
+    return { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+}
+
+inline Quaternion normalized(const Quaternion& q) {
+    const float norm = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (norm <= 0.f) {
+        return Quaternion();
+    }
+    return { q.w / norm, q.x / norm, q.y / norm, q.z / norm };
+}
+
+// Shepperd's method, returns a unit quaternion with w >= 0.
+inline Quaternion fromRotation(const Transform& t) {
+    Quaternion q;
+    const float trace = t[0][0] + t[1][1] + t[2][2];
+    if (trace > 0.f) {
+        const float s = std::sqrt(trace + 1.f) * 2.f;
+        q.w = 0.25f * s;
+        q.x = (t[2][1] - t[1][2]) / s;
+        q.y = (t[0][2] - t[2][0]) / s;
+        q.z = (t[1][0] - t[0][1]) / s;
+    }
+    else if (t[0][0] > t[1][1] && t[0][0] > t[2][2]) {
+        const float s = std::sqrt(1.f + t[0][0] - t[1][1] - t[2][2]) * 2.f;
+        q.w = (t[2][1] - t[1][2]) / s;
+        q.x = 0.25f * s;
+        q.y = (t[0][1] + t[1][0]) / s;
+        q.z = (t[0][2] + t[2][0]) / s;
+    }
+    else if (t[1][1] > t[2][2]) {
+        const float s = std::sqrt(1.f + t[1][1] - t[0][0] - t[2][2]) * 2.f;
+        q.w = (t[0][2] - t[2][0]) / s;
+        q.x = (t[0][1] + t[1][0]) / s;
+        q.y = 0.25f * s;
+        q.z = (t[1][2] + t[2][1]) / s;
+    }
+    else {
+        const float s = std::sqrt(1.f + t[2][2] - t[0][0] - t[1][1]) * 2.f;
+        q.w = (t[1][0] - t[0][1]) / s;
+        q.x = (t[0][2] + t[2][0]) / s;
+        q.y = (t[1][2] + t[2][1]) / s;
+        q.z = 0.25f * s;
+    }
+    if (q.w < 0.f) {
+        q = { -q.w, -q.x, -q.y, -q.z };
+    }
+    return normalized(q);
+}
+
+// Writes the rotation block of `t`, leaves the translation untouched.
+inline void setRotation(const Quaternion& q, Transform& t) {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    t[0][0] = 1.f - 2.f * (yy + zz);
+    t[0][1] = 2.f * (xy - wz);
+    t[0][2] = 2.f * (xz + wy);
+    t[1][0] = 2.f * (xy + wz);
+    t[1][1] = 1.f - 2.f * (xx + zz);
+    t[1][2] = 2.f * (yz - wx);
+    t[2][0] = 2.f * (xz - wy);
+    t[2][1] = 2.f * (yz + wx);
+    t[2][2] = 1.f - 2.f * (xx + yy);
+}
+
+inline Vector3 translation(const Transform& t) {
+    return { t[0][3], t[1][3], t[2][3] };
+}
+
+inline void setTranslation(const Vector3& v, Transform& t) {
+    t[0][3] = v[0];
+    t[1][3] = v[1];
+    t[2][3] = v[2];
+}
+
+inline Vector3 transformPoint(const Transform& t, const Vector3& p) {
+    return { t[0][0] * p[0] + t[0][1] * p[1] + t[0][2] * p[2] + t[0][3],
+             t[1][0] * p[0] + t[1][1] * p[1] + t[1][2] * p[2] + t[1][3],
+             t[2][0] * p[0] + t[2][1] * p[1] + t[2][2] * p[2] + t[2][3] };
+}
+
+inline Transform multiply(const Transform& a, const Transform& b) {
+    Transform result = identity();
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            float value = column == 3 ? a[row][3] : 0.f;
+            for (int k = 0; k < 3; ++k) {
+                value += a[row][k] * b[k][column];
+            }
+            result[row][column] = value;
+        }
+    }
+    return result;
+}
+
+// Rigid inverse: transposed rotation, rotated and negated translation.
+inline Transform inverse(const Transform& t) {
+    Transform result = identity();
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            result[row][column] = t[column][row];
+        }
+        result[row][3] = -(t[0][row] * t[0][3] + t[1][row] * t[1][3] + t[2][row] * t[2][3]);
+    }
+    return result;
+}
+
+// Shortest-arc spherical interpolation, `alpha` in [0, 1].
+inline Quaternion slerp(const Quaternion& a, Quaternion b, float alpha) {
+    float cosine = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    if (cosine < 0.f) {
+        b = { -b.w, -b.x, -b.y, -b.z };
+        cosine = -cosine;
+    }
+
+    float wa = 1.f - alpha;
+    float wb = alpha;
+    // Nearly parallel: sin(angle) vanishes, a normalised lerp is exact enough.
+    if (cosine < 0.9995f) {
+        const float angle = std::acos(cosine);
+        const float sine = std::sin(angle);
+        wa = std::sin(wa * angle) / sine;
+        wb = std::sin(wb * angle) / sine;
+    }
+    return normalized({ wa * a.w + wb * b.w, wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z });
+}
+
+// Slerp on the rotation, lerp on the translation.
+inline Transform interpolate(const Transform& a, const Transform& b, float alpha) {
+    Transform result = identity();
+    setRotation(slerp(fromRotation(a), fromRotation(b), alpha), result);
+    for (int k = 0; k < 3; ++k) {
+        result[k][3] = a[k][3] + (b[k][3] - a[k][3]) * alpha;
+    }
+    return result;
+}
+
+inline AtracsysPose interpolate(const AtracsysPose& a, const AtracsysPose& b, float alpha) {
+    AtracsysPose result = alpha < 0.5f ? a : b;
+    result.transform = interpolate(a.transform, b.transform, alpha);
+    result.registrationErrorMM = a.registrationErrorMM + (b.registrationErrorMM - a.registrationErrorMM) * alpha;
+    result.tipUncertaintyMM = a.tipUncertaintyMM + (b.tipUncertaintyMM - a.tipUncertaintyMM) * alpha;
+    result.hasTip = a.hasTip && b.hasTip;
+    result.hasReferenceTip = a.hasReferenceTip && b.hasReferenceTip;
+    for (int k = 0; k < 3; ++k) {
+        result.tipMM[k] = a.tipMM[k] + (b.tipMM[k] - a.tipMM[k]) * alpha;
+        result.tipInReferenceMM[k] = a.tipInReferenceMM[k] + (b.tipInReferenceMM[k] - a.tipInReferenceMM[k]) * alpha;
+    }
+    return result;
+}
+
+}
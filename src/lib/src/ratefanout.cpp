@@ -0,0 +1,157 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "ratefanout.h"
+#include "posemath.h"
+#include "waitprimitives.h"
+
+#include <cmath>
+
+namespace {
+
+uint64_t instantUS(uint64_t instant, double periodUS) {
+    return uint64_t(std::llround(double(instant) * periodUS));
+}
+
+// Index of the first output instant at or after `timestampUS`.
+uint64_t firstInstantAfter(uint64_t timestampUS, double periodUS) {
+    return uint64_t(std::ceil(double(timestampUS) / periodUS - 1e-9));
+}
+
+void interpolateFrame(const AtracsysFrame& before, const AtracsysFrame& after, uint64_t timestampUS,
+                      AtracsysFrame& output) {
+    const float alpha = float(double(timestampUS - before.timestampUS) /
+                              double(after.timestampUS - before.timestampUS));
+    const AtracsysFrame& nearest = alpha < 0.5f ? before : after;
+
+    output.index = after.index;
+    output.timestampUS = timestampUS;
+    output.poseCount = 0;
+
+    // Poses seen in both frames are interpolated, the others come from the nearest frame.
+    for (uint32_t i = 0; i < nearest.poseCount; ++i) {
+        const AtracsysPose& pose = nearest.poses[i];
+        const AtracsysPose* a = before.findPose(pose.geometryId);
+        const AtracsysPose* b = after.findPose(pose.geometryId);
+
+        AtracsysPose& result = output.poses[output.poseCount++];
+        result = a != nullptr && b != nullptr ? posemath::interpolate(*a, *b, alpha) : pose;
+    }
+}
+
+}
+
+class RateFanout::Consumer : public AtracsysFrameConsumer {
+public:
+    Consumer(std::shared_ptr<RateFanout> fanout, Slot& slot, AtracsysWaitStrategy strategy, uint32_t spinIterations)
+            : fanout(std::move(fanout)), slot(slot), consumer(slot.channel, strategy, spinIterations) {
+    }
+
+    ~Consumer() override {
+        fanout->release(slot);
+    }
+
+    bool waitNext(AtracsysFrame& frame, uint32_t timeoutMs) override {
+        return consumer.waitNext(frame, timeoutMs);
+    }
+
+    bool tryNext(AtracsysFrame& frame) override {
+        return consumer.tryNext(frame);
+    }
+
+    AtracsysWaitStrategy getStrategy() const override { return consumer.getStrategy(); }
+    uint64_t getMissedCount() const override { return consumer.getMissedCount(); }
+
+private:
+    std::shared_ptr<RateFanout> fanout;
+    Slot& slot;
+    FrameConsumer consumer;
+};
+
+std::unique_ptr<AtracsysFrameConsumer> RateFanout::createConsumer(double rateHz, AtracsysRateMode mode,
+                                                                  AtracsysWaitStrategy strategy,
+                                                                  uint32_t spinIterations) {
+    if (!(rateHz > 0.0)) {
+        return nullptr;
+    }
+
+    for (Slot& slot : slots) {
+        uint32_t expected = FREE;
+        if (!slot.state.compare_exchange_strong(expected, CLAIMED, std::memory_order_acquire)) {
+            continue;
+        }
+        slot.mode = mode;
+        slot.periodUS = 1e6 / rateHz;
+        slot.channel = std::make_shared<FrameChannel>();
+        slot.nextInstant = 0;
+        slot.hasPrevious = false;
+
+        std::unique_ptr<AtracsysFrameConsumer> consumer(new Consumer(shared_from_this(), slot, strategy, spinIterations));
+        slot.state.store(ACTIVE, std::memory_order_seq_cst);
+        return consumer;
+    }
+    return nullptr;
+}
+
+void RateFanout::release(Slot& slot) {
+    slot.state.store(CLAIMED, std::memory_order_seq_cst);
+    // The acquisition thread may still be inside deliver() for this slot.
+    while (slot.busy.load(std::memory_order_seq_cst)) {
+        cpuRelax();
+    }
+    slot.channel.reset();
+    slot.state.store(FREE, std::memory_order_release);
+}
+
+void RateFanout::close() {
+    for (Slot& slot : slots) {
+        slot.busy.store(true, std::memory_order_seq_cst);
+        if (slot.state.load(std::memory_order_seq_cst) == ACTIVE) {
+            slot.channel->close();
+        }
+        slot.busy.store(false, std::memory_order_seq_cst);
+    }
+}
+
+void RateFanout::onFrame(const AtracsysFrame& frame) {
+    for (Slot& slot : slots) {
+        slot.busy.store(true, std::memory_order_seq_cst);
+        if (slot.state.load(std::memory_order_seq_cst) == ACTIVE) {
+            deliver(slot, frame);
+        }
+        slot.busy.store(false, std::memory_order_release);
+    }
+}
+
+void RateFanout::deliver(Slot& slot, const AtracsysFrame& frame) {
+    if (slot.mode == AtracsysRateMode::Decimate) {
+        if (slot.nextInstant == 0 || frame.timestampUS >= instantUS(slot.nextInstant, slot.periodUS)) {
+            slot.channel->onFrame(frame);
+            // Instants that passed without a frame are skipped, not made up.
+            slot.nextInstant = firstInstantAfter(frame.timestampUS + 1, slot.periodUS);
+        }
+        return;
+    }
+
+    if (!slot.hasPrevious || frame.timestampUS <= slot.previous.timestampUS ||
+        frame.timestampUS - slot.previous.timestampUS > posemath::MAX_INTERPOLATION_GAP_US) {
+        slot.previous.copyFrom(frame);
+        slot.hasPrevious = true;
+        slot.nextInstant = firstInstantAfter(frame.timestampUS, slot.periodUS);
+        return;
+    }
+
+    // Every instant in (previous, frame] is produced; the mailbox keeps the latest.
+    uint64_t instant = instantUS(slot.nextInstant, slot.periodUS);
+    if (instant < slot.previous.timestampUS) {
+        slot.nextInstant = firstInstantAfter(slot.previous.timestampUS, slot.periodUS);
+        instant = instantUS(slot.nextInstant, slot.periodUS);
+    }
+    while (instant <= frame.timestampUS) {
+        interpolateFrame(slot.previous, frame, instant, slot.output);
+        slot.channel->onFrame(slot.output);
+        instant = instantUS(++slot.nextInstant, slot.periodUS);
+    }
+    slot.previous.copyFrom(frame);
+}
@@ -0,0 +1,65 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <atracsyswrapper/atracsysframeconsumer.h>
+#include "framechannel.h"
+#include "framelistener.h"
+
+/** \brief Delivers frames to consumers registered with a target rate.
+ *
+ * Every consumer gets its own mailbox, filled by the acquisition thread only
+ * at the consumer's output instants, so a slow consumer never wakes up just to
+ * drop a frame. Slots are preallocated; registering and releasing a consumer
+ * is lock-free with respect to the acquisition thread. Consumers keep the
+ * fanout alive, so it must be owned by a std::shared_ptr.
+ */
+class RateFanout : public FrameListener, public std::enable_shared_from_this<RateFanout> {
+public:
+    static const size_t MAX_CONSUMERS = 16;
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+    // Returns nullptr when the rate is not positive or every slot is taken.
+    std::unique_ptr<AtracsysFrameConsumer> createConsumer(double rateHz, AtracsysRateMode mode,
+                                                          AtracsysWaitStrategy strategy, uint32_t spinIterations);
+
+    // Wakes the waiting consumers, used on shutdown.
+    void close();
+
+private:
+    enum SlotState : uint32_t {
+        FREE,
+        CLAIMED,
+        ACTIVE
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> state{FREE};
+        std::atomic<bool> busy{false};
+
+        // Set while CLAIMED, read-only once ACTIVE.
+        AtracsysRateMode mode = AtracsysRateMode::Decimate;
+        double periodUS = 0.0;
+        std::shared_ptr<FrameChannel> channel;
+
+        // Acquisition thread state.
+        uint64_t nextInstant = 0;
+        bool hasPrevious = false;
+        AtracsysFrame previous;
+        AtracsysFrame output;
+    };
+
+    class Consumer;
+
+    void deliver(Slot& slot, const AtracsysFrame& frame);
+    void release(Slot& slot);
+
+    std::array<Slot, MAX_CONSUMERS> slots;
+};
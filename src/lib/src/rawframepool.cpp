@@ -0,0 +1,122 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "rawframepool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const int MAX_ACQUIRE_ATTEMPTS = 64;
+
+}
+
+AtracsysRawFrame::~AtracsysRawFrame() {
+    release();
+}
+
+AtracsysRawFrame::AtracsysRawFrame(AtracsysRawFrame&& other) noexcept
+        : pool(std::move(other.pool)),
+          slot(other.slot),
+          query(other.query),
+          index(other.index),
+          timestampUS(other.timestampUS) {
+    other.query = nullptr;
+}
+
+AtracsysRawFrame& AtracsysRawFrame::operator=(AtracsysRawFrame&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool = std::move(other.pool);
+        slot = other.slot;
+        query = other.query;
+        index = other.index;
+        timestampUS = other.timestampUS;
+        other.query = nullptr;
+    }
+    return *this;
+}
+
+void AtracsysRawFrame::release() {
+    if (query != nullptr) {
+        pool->release(slot);
+        query = nullptr;
+        pool.reset();
+    }
+}
+
+RawFramePool::~RawFramePool() {
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        if (slots[i].query != nullptr) {
+            ftkDeleteFrame(slots[i].query);
+        }
+    }
+}
+
+AtracsysStatus RawFramePool::create(uint32_t buffers, bool pixels, uint32 blobs, uint32 fiducials, uint32 markers) {
+    slotCount = std::max<uint32_t>(buffers, 2);
+    slots.reset(new Slot[slotCount]);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        slots[i].query = ftkCreateFrame();
+        if (slots[i].query == nullptr) {
+            return AtracsysStatus(AtracsysStatusCode::FrameAllocationFailed);
+        }
+        ftkError err( ftkSetFrameOptions( pixels, false, blobs, blobs, fiducials, markers, slots[i].query ) );
+        if (err != FTK_OK) {
+            return AtracsysStatus(AtracsysStatusCode::FrameOptionsFailed, err);
+        }
+    }
+    return AtracsysStatus();
+}
+
+void RawFramePool::publish(ftkFrameQuery*& frame, uint64_t index, uint64_t timestampUS) {
+    const uint32_t current = latest.load(std::memory_order_relaxed);
+    for (uint32_t i = 1; i <= slotCount; ++i) {
+        // Round robin from the latest buffer, so readers of older frames keep theirs longest.
+        const uint32_t candidate = current == NO_SLOT ? i - 1 : (current + i) % slotCount;
+        if (candidate == current) {
+            continue;
+        }
+        Slot& slot = slots[candidate];
+        uint32_t expected = 0;
+        if (!slot.pins.compare_exchange_strong(expected, WRITING, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+            continue;
+        }
+        std::swap(frame, slot.query);
+        slot.index = index;
+        slot.timestampUS = timestampUS;
+        slot.pins.fetch_sub(WRITING, std::memory_order_release);
+        latest.store(candidate, std::memory_order_release);
+        return;
+    }
+}
+
+bool RawFramePool::acquire(AtracsysRawFrame& frame) {
+    frame.release();
+    for (int attempt = 0; attempt < MAX_ACQUIRE_ATTEMPTS; ++attempt) {
+        const uint32_t candidate = latest.load(std::memory_order_acquire);
+        if (candidate == NO_SLOT) {
+            return false;
+        }
+        Slot& slot = slots[candidate];
+        if ((slot.pins.fetch_add(1, std::memory_order_acquire) & WRITING) != 0) {
+            // Being reused for a newer frame; the next attempt finds that one.
+            slot.pins.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        frame.pool = shared_from_this();
+        frame.slot = candidate;
+        frame.query = slot.query;
+        frame.index = slot.index;
+        frame.timestampUS = slot.timestampUS;
+        return true;
+    }
+    return false;
+}
+
+void RawFramePool::release(uint32_t slot) {
+    slots[slot].pins.fetch_sub(1, std::memory_order_release);
+}
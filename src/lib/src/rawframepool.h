@@ -0,0 +1,51 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ftkInterface.h>
+#include <atracsyswrapper/atracsysrawframe.h>
+#include <atracsyswrapper/atracsysstatus.h>
+
+/** \brief SDK frame buffers handed to raw-data readers without copying.
+ *
+ * The acquisition thread keeps filling its own buffer; publish() trades it
+ * for a pool buffer that is neither pinned nor the latest one, so the filled
+ * buffer becomes the latest without a copy. Readers pin the latest buffer by
+ * incrementing its pin count; the writer claims a buffer by swapping a zero
+ * pin count for WRITING, so a reader that raced it backs off and retries.
+ * Every buffer is owned by exactly one side at any time.
+ */
+class RawFramePool : public std::enable_shared_from_this<RawFramePool> {
+public:
+    ~RawFramePool();
+
+    // Allocates `buffers` frames sized like the acquisition frame.
+    AtracsysStatus create(uint32_t buffers, bool pixels, uint32 blobs, uint32 fiducials, uint32 markers);
+
+    // Acquisition thread only; keeps `frame` when every other buffer is pinned.
+    void publish(ftkFrameQuery*& frame, uint64_t index, uint64_t timestampUS);
+
+    // Any thread; false until a frame has been published.
+    bool acquire(AtracsysRawFrame& frame);
+    void release(uint32_t slot);
+
+private:
+    static const uint32_t NO_SLOT = UINT32_MAX;
+    static const uint32_t WRITING = 0x80000000u;
+
+    struct alignas(64) Slot {
+        ftkFrameQuery* query = nullptr;
+        std::atomic<uint32_t> pins{0};
+        uint64_t index = 0;
+        uint64_t timestampUS = 0;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    uint32_t slotCount = 0;
+    std::atomic<uint32_t> latest{NO_SLOT};
+};
@@ -0,0 +1,39 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "realtime.h"
+
+
+#ifdef _WIN32
+#include <malloc.h>
+#define stackAlloc _alloca
+#else
+#include <alloca.h>
+#include <sys/mman.h>
+#define stackAlloc alloca
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+bool lockProcessMemory() {
+#ifdef _WIN32
+    return false;
+#else
+#ifdef __GLIBC__
+    // Never hand freed memory back to the kernel, it would fault again on reuse.
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+}
+
+void prefaultStack(size_t bytes) {
+    volatile unsigned char* stack = static_cast<volatile unsigned char*>(stackAlloc(bytes));
+    for (size_t offset = 0; offset < bytes; offset += 4096) {
+        stack[offset] = 0;
+    }
+}
@@ -0,0 +1,17 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+
+/** \brief Locks current and future pages in RAM and keeps freed heap mapped.
+ *
+ * Only implemented on Linux; returns false elsewhere or when the memlock
+ * limit is too low.
+ */
+bool lockProcessMemory();
+
+// Touches `bytes` of the calling thread's stack so later calls do not fault.
+void prefaultStack(size_t bytes);
@@ -0,0 +1,85 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "rigidfit.h"
+#include "posemath.h"
+#include "symmetriceigen.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Second over largest spread of the source points below which they count as collinear.
+const double MIN_SPREAD_RATIO = 1e-6;
+
+}
+
+bool fitRigid(const std::array<float, 3>* source, const std::array<float, 3>* target,
+              const uint32_t* indices, size_t count, AtracsysMarker::Transform& result) {
+    auto pair = [&](size_t i) { return indices != nullptr ? indices[i] : i; };
+
+    double sourceCentroid[3] = { 0.0, 0.0, 0.0 };
+    double targetCentroid[3] = { 0.0, 0.0, 0.0 };
+    for (size_t i = 0; i < count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            sourceCentroid[k] += source[pair(i)][k];
+            targetCentroid[k] += target[pair(i)][k];
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        sourceCentroid[k] /= double(count);
+        targetCentroid[k] /= double(count);
+    }
+
+    double s[3][3] = {};
+    double spread[3][3] = {};
+    for (size_t i = 0; i < count; ++i) {
+        double a[3];
+        double b[3];
+        for (int k = 0; k < 3; ++k) {
+            a[k] = source[pair(i)][k] - sourceCentroid[k];
+            b[k] = target[pair(i)][k] - targetCentroid[k];
+        }
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                s[row][column] += a[row] * b[column];
+                spread[row][column] += a[row] * a[column];
+            }
+        }
+    }
+
+    double spreadValues[3];
+    double spreadAxes[3][3];
+    symmetricEigen<3>(spread, spreadValues, spreadAxes);
+    std::sort(spreadValues, spreadValues + 3);
+    if (spreadValues[2] <= 0.0 || spreadValues[1] < MIN_SPREAD_RATIO * spreadValues[2]) {
+        return false;
+    }
+
+    double n[4][4] = {
+        { s[0][0] + s[1][1] + s[2][2], s[1][2] - s[2][1], s[2][0] - s[0][2], s[0][1] - s[1][0] },
+        { s[1][2] - s[2][1], s[0][0] - s[1][1] - s[2][2], s[0][1] + s[1][0], s[2][0] + s[0][2] },
+        { s[2][0] - s[0][2], s[0][1] + s[1][0], -s[0][0] + s[1][1] - s[2][2], s[1][2] + s[2][1] },
+        { s[0][1] - s[1][0], s[2][0] + s[0][2], s[1][2] + s[2][1], -s[0][0] - s[1][1] + s[2][2] },
+    };
+    double values[4];
+    double vectors[4][4];
+    symmetricEigen<4>(n, values, vectors);
+    const int best = int(std::max_element(values, values + 4) - values);
+
+    posemath::Quaternion q;
+    q.w = float(vectors[0][best]);
+    q.x = float(vectors[1][best]);
+    q.y = float(vectors[2][best]);
+    q.z = float(vectors[3][best]);
+
+    result = posemath::identity();
+    posemath::setRotation(posemath::normalized(q), result);
+    for (int row = 0; row < 3; ++row) {
+        result[row][3] = float(targetCentroid[row] - result[row][0] * sourceCentroid[0] -
+                               result[row][1] * sourceCentroid[1] - result[row][2] * sourceCentroid[2]);
+    }
+    return true;
+}
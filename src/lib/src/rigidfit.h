@@ -0,0 +1,21 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <atracsyswrapper/atracsysmarker.h>
+
+/** \brief Least-squares rigid fit of paired points, Horn's unit quaternion method.
+ *
+ * Fits target = R * source + t over the pairs listed in `indices`, or over
+ * the first `count` pairs if it is null. The rotation is the dominant
+ * eigenvector of the 4x4 matrix built from the cross-covariance of the
+ * centred sets, so a reflection is never returned. Fails when the source
+ * points are (nearly) collinear.
+ */
+bool fitRigid(const std::array<float, 3>* source, const std::array<float, 3>* target,
+              const uint32_t* indices, size_t count, AtracsysMarker::Transform& result);
@@ -0,0 +1,160 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "sharedposepublisher.h"
+
+#include <new>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace AtracsysSharedPoses;
+
+namespace {
+// Owner and group may read the poses.
+const mode_t SEGMENT_MODE = 0640;
+}
+
+SharedPosePublisher::SharedPosePublisher() = default;
+
+SharedPosePublisher::~SharedPosePublisher() {
+    close();
+}
+
+bool SharedPosePublisher::open(const std::string& name, uint32_t capacity) {
+    close();
+#ifdef _WIN32
+    return false;
+#else
+    if (capacity < 2) {
+        return false;
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, SEGMENT_MODE);
+    if (fd < 0 && errno == EEXIST && retireStaleSegment(name)) {
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, SEGMENT_MODE);
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    const size_t size = segmentSize(capacity);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // Readers check the magic last, so fill in everything else first.
+    header = new (address) Header();
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = VERSION;
+    header->capacity = capacity;
+    header->slotSize = sizeof(Slot);
+    header->writerPid = static_cast<int32_t>(getpid());
+    header->published.store(0, std::memory_order_relaxed);
+
+    slots = reinterpret_cast<Slot*>(static_cast<char*>(address) + sizeof(Header));
+    for (uint32_t i = 0; i < capacity; ++i) {
+        Slot* slot = new (&slots[i]) Slot();
+        slot->sequence.store(0, std::memory_order_relaxed);
+        slot->publication = ~0ull;
+    }
+
+    // Touch every page now so that publishing never faults.
+    mlock(address, size);
+
+    header->magic.store(MAGIC, std::memory_order_release);
+
+    this->name = name;
+    mappedSize = size;
+    published = 0;
+    return true;
+#endif
+}
+
+bool SharedPosePublisher::retireStaleSegment(const std::string& name) {
+#ifdef _WIN32
+    return false;
+#else
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        // Unlinked in the meantime, try creating it again.
+        return errno == ENOENT;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // A segment too small for a header was never initialised and holds no readers.
+    if (static_cast<size_t>(info.st_size) >= sizeof(Header)) {
+        void* address = mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        Header* stale = static_cast<Header*>(address);
+        const bool live = stale->magic.load(std::memory_order_acquire) == MAGIC && stale->version == VERSION &&
+                          stale->writerPid > 0 && (kill(stale->writerPid, 0) == 0 || errno == EPERM);
+        if (!live) {
+            // Readers still mapping it see the writer gone instead of a frozen ring.
+            stale->magic.store(0, std::memory_order_release);
+        }
+        munmap(address, sizeof(Header));
+        if (live) {
+            ::close(fd);
+            return false;
+        }
+    }
+    ::close(fd);
+    return shm_unlink(name.c_str()) == 0 || errno == ENOENT;
+#endif
+}
+
+void SharedPosePublisher::close() {
+#ifndef _WIN32
+    if (header != nullptr) {
+        header->magic.store(0, std::memory_order_release);
+        munlock(header, mappedSize);
+        munmap(header, mappedSize);
+        shm_unlink(name.c_str());
+    }
+#endif
+    header = nullptr;
+    slots = nullptr;
+    mappedSize = 0;
+}
+
+void SharedPosePublisher::onFrame(const AtracsysFrame& frame) {
+    if (header == nullptr) {
+        return;
+    }
+
+    Slot& slot = slots[published % header->capacity];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.publication = published;
+    slot.frame.copyFrom(frame);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    header->published.store(++published, std::memory_order_release);
+}
@@ -0,0 +1,39 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <atracsyswrapper/atracsyssharedposes.h>
+#include "framelistener.h"
+
+/** \brief Publishes every frame into a POSIX shared-memory ring.
+ *
+ * See AtracsysSharedPoses for the layout and AtracsysSharedPoseReader for the
+ * read side. Publishing is a seqlock-protected memcpy into the next slot and
+ * never waits for readers.
+ *
+ * open() always creates a fresh segment. A segment left behind by a writer
+ * that is no longer running is marked closed and unlinked first; one held
+ * by a running writer makes open() fail.
+ */
+class SharedPosePublisher : public FrameListener {
+public:
+    SharedPosePublisher();
+    ~SharedPosePublisher() override;
+
+    bool open(const std::string& name, uint32_t capacity);
+    void close();
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+private:
+    static bool retireStaleSegment(const std::string& name);
+
+    std::string name;
+    AtracsysSharedPoses::Header* header = nullptr;
+    AtracsysSharedPoses::Slot* slots = nullptr;
+    size_t mappedSize = 0;
+    uint64_t published = 0;
+};
@@ -0,0 +1,45 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+typedef SOCKET SocketHandle;
+static const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+
+inline void closeSocket(SocketHandle socket) {
+    closesocket(socket);
+}
+
+// Winsock needs a matching WSAStartup/WSACleanup pair per user.
+class SocketLibrary {
+public:
+    SocketLibrary() {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    }
+    ~SocketLibrary() {
+        WSACleanup();
+    }
+};
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+typedef int SocketHandle;
+static const SocketHandle INVALID_SOCKET_HANDLE = -1;
+
+inline void closeSocket(SocketHandle socket) {
+    close(socket);
+}
+
+class SocketLibrary {
+};
+#endif
@@ -0,0 +1,172 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "surfaceaccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Voxel coordinates are biased into 21 unsigned bits per axis.
+const int64_t COORDINATE_BIAS = int64_t(1) << 20;
+const uint64_t COORDINATE_MASK = (uint64_t(1) << 21) - 1;
+
+uint64_t mix(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    return key ^ (key >> 31);
+}
+
+}
+
+void SurfaceAccumulator::start(uint32_t geometry, const AtracsysSurfaceOptions& requested) {
+    // Allocate outside the lock so the acquisition thread is held up only by the swap.
+    size_t capacity = 16;
+    while (capacity < 2 * std::max<size_t>(requested.maxVoxels, 1)) {
+        capacity <<= 1;
+    }
+    std::vector<Entry> freshTable(capacity, Entry{ EMPTY_KEY, 0 });
+    std::vector<Voxel> freshVoxels(std::max<size_t>(requested.maxVoxels, 1));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        options = requested;
+        options.voxelSizeMM = std::max(requested.voxelSizeMM, 1e-3f);
+        inverseVoxelSize = 1.f / options.voxelSizeMM;
+        table.swap(freshTable);
+        voxels.swap(freshVoxels);
+        mask = capacity - 1;
+        voxelCount = 0;
+        stats = AtracsysSurfaceStats();
+        geometryId.store(geometry, std::memory_order_release);
+        requestedSession.fetch_add(1, std::memory_order_release);
+    }
+    // The old storage is released here, on the caller's thread.
+}
+
+void SurfaceAccumulator::stop() {
+    geometryId.store(NO_GEOMETRY, std::memory_order_release);
+}
+
+void SurfaceAccumulator::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fill(table.begin(), table.end(), Entry{ EMPTY_KEY, 0 });
+    voxelCount = 0;
+    stats = AtracsysSurfaceStats();
+    requestedSession.fetch_add(1, std::memory_order_release);
+}
+
+size_t SurfaceAccumulator::getPoints(std::vector<std::array<float, 3>>& points) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t first = points.size();
+    points.resize(first + voxelCount);
+    for (size_t i = 0; i < voxelCount; ++i) {
+        const Voxel& voxel = voxels[i];
+        const float scale = 1.f / float(voxel.count);
+        points[first + i] = { { voxel.first[0] + voxel.offsetSum[0] * scale,
+                                voxel.first[1] + voxel.offsetSum[1] * scale,
+                                voxel.first[2] + voxel.offsetSum[2] * scale } };
+    }
+    return voxelCount;
+}
+
+AtracsysSurfaceStats SurfaceAccumulator::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    AtracsysSurfaceStats result = stats;
+    result.voxels = voxelCount;
+    return result;
+}
+
+void SurfaceAccumulator::onFrame(const AtracsysFrame& frame) {
+    syncSession();
+
+    const uint32_t geometry = geometryId.load(std::memory_order_acquire);
+    if (geometry == NO_GEOMETRY) {
+        return;
+    }
+    const AtracsysPose* pose = frame.findPose(geometry);
+    if (pose == nullptr) {
+        return;
+    }
+    const Tip tip = { pose->hasTip, pose->hasReferenceTip, pose->tipUncertaintyMM, pose->tipMM, pose->tipInReferenceMM };
+
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        if (pendingCount < PENDING_CAPACITY) {
+            pending[pendingCount++] = tip;
+        }
+        else {
+            ++pendingDropped;
+        }
+        return;
+    }
+    // start() and clear() bump the session under the lock, so this check is
+    // final. If one ran since the check above, this tip was taken for the
+    // previous sweep as well.
+    if (syncSession()) {
+        return;
+    }
+
+    for (size_t i = 0; i < pendingCount; ++i) {
+        add(pending[i]);
+    }
+    pendingCount = 0;
+    stats.skipped += pendingDropped;
+    pendingDropped = 0;
+    add(tip);
+}
+
+bool SurfaceAccumulator::syncSession() {
+    const uint32_t requested = requestedSession.load(std::memory_order_acquire);
+    if (requested == session) {
+        return false;
+    }
+    // Tips held back during the previous sweep belong to the old surface.
+    session = requested;
+    pendingCount = 0;
+    pendingDropped = 0;
+    return true;
+}
+
+void SurfaceAccumulator::add(const Tip& tip) {
+    ++stats.samples;
+    const bool usable = tip.hasTip && (!options.useReference || tip.hasReferenceTip) &&
+                        (options.maxTipUncertaintyMM <= 0.f || tip.uncertaintyMM <= options.maxTipUncertaintyMM);
+    if (!usable || table.empty()) {
+        ++stats.skipped;
+        return;
+    }
+    insert(options.useReference ? tip.referenceMM : tip.cameraMM);
+}
+
+void SurfaceAccumulator::insert(const std::array<float, 3>& point) {
+    uint64_t key = 0;
+    for (int k = 0; k < 3; ++k) {
+        const int64_t coordinate = int64_t(std::floor(point[k] * inverseVoxelSize)) + COORDINATE_BIAS;
+        key |= (uint64_t(coordinate) & COORDINATE_MASK) << (21 * k);
+    }
+
+    for (uint64_t slot = mix(key) & mask;; slot = (slot + 1) & mask) {
+        Entry& entry = table[slot];
+        if (entry.key == key) {
+            Voxel& voxel = voxels[entry.voxel];
+            voxel.offsetSum[0] += point[0] - voxel.first[0];
+            voxel.offsetSum[1] += point[1] - voxel.first[1];
+            voxel.offsetSum[2] += point[2] - voxel.first[2];
+            ++voxel.count;
+            return;
+        }
+        if (entry.key == EMPTY_KEY) {
+            if (voxelCount == voxels.size()) {
+                ++stats.refused;
+                return;
+            }
+            entry.key = key;
+            entry.voxel = uint32_t(voxelCount);
+            voxels[voxelCount++] = { { point[0], point[1], point[2] }, { 0.f, 0.f, 0.f }, 1 };
+            return;
+        }
+    }
+}
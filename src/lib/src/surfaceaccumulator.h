@@ -0,0 +1,85 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <atracsyswrapper/atracsyssurface.h>
+#include "framelistener.h"
+
+/** \brief Voxel-hashed accumulator for swept surface points.
+ *
+ * An open-addressing table (linear probing, load factor at most 1/2) maps
+ * packed voxel coordinates to an index into a dense voxel array, so an
+ * insert is one hash and a short probe and export is a linear copy. All
+ * storage is sized in start(); the acquisition thread never allocates.
+ *
+ * onFrame() only try-locks the accumulator: while getPoints() copies, new
+ * tips wait in a small pending buffer and are inserted on the next frame.
+ * start() and clear() begin a new session, which discards pending tips.
+ */
+class SurfaceAccumulator : public FrameListener {
+public:
+    static const uint32_t NO_GEOMETRY = UINT32_MAX;
+    static const size_t PENDING_CAPACITY = 256;
+
+    void start(uint32_t geometryId, const AtracsysSurfaceOptions& options);
+    void stop();
+    void clear();
+
+    // Appends the voxel means to `points`; returns the number appended.
+    size_t getPoints(std::vector<std::array<float, 3>>& points);
+    AtracsysSurfaceStats getStats();
+
+    void onFrame(const AtracsysFrame& frame) override;
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t voxel;
+    };
+
+    // Sums are kept relative to the first point, which keeps float precision for long sweeps.
+    struct Voxel {
+        float first[3];
+        float offsetSum[3];
+        uint32_t count;
+    };
+
+    struct Tip {
+        bool hasTip;
+        bool hasReferenceTip;
+        float uncertaintyMM;
+        std::array<float, 3> cameraMM;
+        std::array<float, 3> referenceMM;
+    };
+
+    static const uint64_t EMPTY_KEY = UINT64_MAX;
+
+    // True, with the pending tips discarded, when start() or clear() ran since the last frame.
+    bool syncSession();
+    void add(const Tip& tip);
+    void insert(const std::array<float, 3>& point);
+
+    std::mutex mutex;
+    std::atomic<uint32_t> geometryId{NO_GEOMETRY};
+    AtracsysSurfaceOptions options;
+    float inverseVoxelSize = 1.f;
+    std::vector<Entry> table;
+    uint64_t mask = 0;
+    std::vector<Voxel> voxels;
+    size_t voxelCount = 0;
+    AtracsysSurfaceStats stats;
+    std::atomic<uint32_t> requestedSession{0};
+
+    // Acquisition thread only.
+    uint32_t session = 0;
+    std::array<Tip, PENDING_CAPACITY> pending;
+    size_t pendingCount = 0;
+    uint64_t pendingDropped = 0;
+};
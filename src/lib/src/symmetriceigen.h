@@ -0,0 +1,65 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+
+/** \brief Eigen decomposition of a small symmetric matrix by cyclic Jacobi rotations.
+ *
+ * `m` is destroyed; `values` receives the eigenvalues (unsorted) and
+ * `vectors` the matching eigenvectors as columns.
+ */
+template<int N>
+void symmetricEigen(double m[N][N], double values[N], double vectors[N][N]) {
+    for (int row = 0; row < N; ++row) {
+        for (int column = 0; column < N; ++column) {
+            vectors[row][column] = row == column ? 1.0 : 0.0;
+        }
+    }
+
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        double offDiagonal = 0.0;
+        for (int p = 0; p < N - 1; ++p) {
+            for (int q = p + 1; q < N; ++q) {
+                offDiagonal += m[p][q] * m[p][q];
+            }
+        }
+        if (offDiagonal < 1e-20) {
+            break;
+        }
+        for (int p = 0; p < N - 1; ++p) {
+            for (int q = p + 1; q < N; ++q) {
+                if (std::fabs(m[p][q]) < 1e-30) {
+                    continue;
+                }
+                const double theta = (m[q][q] - m[p][p]) / (2.0 * m[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < N; ++k) {
+                    const double kp = m[k][p];
+                    const double kq = m[k][q];
+                    m[k][p] = c * kp - s * kq;
+                    m[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < N; ++k) {
+                    const double pk = m[p][k];
+                    const double qk = m[q][k];
+                    m[p][k] = c * pk - s * qk;
+                    m[q][k] = s * pk + c * qk;
+                }
+                for (int k = 0; k < N; ++k) {
+                    const double kp = vectors[k][p];
+                    const double kq = vectors[k][q];
+                    vectors[k][p] = c * kp - s * kq;
+                    vectors[k][q] = s * kp + c * kq;
+                }
+            }
+        }
+    }
+    for (int k = 0; k < N; ++k) {
+        values[k] = m[k][k];
+    }
+}
@@ -0,0 +1,90 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "threadpool.h"
+
+namespace {
+
+thread_local bool insideParallelFor = false;
+
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (workers.empty() || count <= 1 || insideParallelFor) {
+        for (size_t index = 0; index < count; ++index) {
+            body(index);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(callerMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobCount = count;
+        next.store(0, std::memory_order_relaxed);
+        pending = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::run() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        if (--pending == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::drain() {
+    // job and jobCount are stable until every worker has checked out.
+    const std::function<void(size_t)>& body = *job;
+    const size_t count = jobCount;
+
+    insideParallelFor = true;
+    for (size_t index = next.fetch_add(1, std::memory_order_relaxed); index < count;
+         index = next.fetch_add(1, std::memory_order_relaxed)) {
+        body(index);
+    }
+    insideParallelFor = false;
+}
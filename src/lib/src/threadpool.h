@@ -0,0 +1,53 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \brief Fixed set of worker threads for data-parallel loops.
+ *
+ * parallelFor() hands out indices dynamically, so uneven work balances
+ * itself, and the calling thread works along instead of sleeping. A
+ * parallelFor() issued from inside a running body executes inline, which
+ * makes nested use (a batch of jobs that are themselves parallel) safe.
+ * Concurrent callers are serialised.
+ */
+class ThreadPool {
+public:
+    // `threads` counts the caller; 0 uses one thread per hardware thread.
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    // Calls body(index) for every index in [0, count) and returns once all are done.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+private:
+    void run();
+    void drain();
+
+    std::vector<std::thread> workers;
+    std::mutex callerMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> next{0};
+    size_t pending = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
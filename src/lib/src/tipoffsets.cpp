@@ -0,0 +1,162 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "tipoffsets.h"
+#include "symmetriceigen.h"
+
+#include <cmath>
+
+namespace {
+
+const int MAX_READ_ATTEMPTS = 64;
+
+}
+
+TipOffsets::Slot* TipOffsets::findSlot(uint32_t geometryId) const {
+    for (const Slot& slot : slots) {
+        const uint32_t id = slot.geometryId.load(std::memory_order_acquire);
+        if (id == geometryId) {
+            return const_cast<Slot*>(&slot);
+        }
+        if (id == UINT32_MAX) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+bool TipOffsets::setGeometry(uint32_t geometryId, const std::array<float, 3>* fiducials, size_t count) {
+    if (count > MAX_FIDUCIALS) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot* slot = findSlot(geometryId);
+    if (slot == nullptr) {
+        for (Slot& candidate : slots) {
+            if (candidate.geometryId.load(std::memory_order_relaxed) == UINT32_MAX) {
+                slot = &candidate;
+                break;
+            }
+        }
+        if (slot == nullptr) {
+            return false;
+        }
+    }
+
+    slot->fiducialCount = count;
+    for (size_t i = 0; i < count; ++i) {
+        slot->fiducials[i] = fiducials[i];
+    }
+    if (slot->geometryId.load(std::memory_order_relaxed) == UINT32_MAX) {
+        write(*slot, false, slot->tipMM);
+        slot->geometryId.store(geometryId, std::memory_order_release);
+    }
+    else if (slot->hasTip) {
+        write(*slot, true, slot->tipMM);
+    }
+    return true;
+}
+
+bool TipOffsets::setTip(uint32_t geometryId, const std::array<float, 3>& tipMM) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot* slot = findSlot(geometryId);
+    if (slot == nullptr) {
+        return false;
+    }
+    write(*slot, true, tipMM);
+    return true;
+}
+
+bool TipOffsets::clearTip(uint32_t geometryId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot* slot = findSlot(geometryId);
+    if (slot == nullptr) {
+        return false;
+    }
+    write(*slot, false, slot->tipMM);
+    return true;
+}
+
+void TipOffsets::write(Slot& slot, bool hasTip, const std::array<float, 3>& tipMM) {
+    const float scale = hasTip ? computeUncertaintyScale(slot, tipMM) : 0.f;
+
+    const uint32_t before = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(before + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.hasTip = hasTip;
+    slot.tipMM = tipMM;
+    slot.uncertaintyScale = scale;
+    slot.sequence.store(before + 2, std::memory_order_release);
+}
+
+bool TipOffsets::getTip(uint32_t geometryId, std::array<float, 3>& tipMM, float& uncertaintyScale) const {
+    const Slot* slot = findSlot(geometryId);
+    if (slot == nullptr) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = slot->sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            continue;
+        }
+        const bool hasTip = slot->hasTip;
+        tipMM = slot->tipMM;
+        uncertaintyScale = slot->uncertaintyScale;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == before) {
+            return hasTip;
+        }
+    }
+    return false;
+}
+
+float TipOffsets::computeUncertaintyScale(const Slot& slot, const std::array<float, 3>& tipMM) {
+    const size_t count = slot.fiducialCount;
+    if (count < 3) {
+        // Without a fiducial layout fall back to TRE = FRE.
+        return 1.f;
+    }
+
+    double centroid[3] = { 0.0, 0.0, 0.0 };
+    for (size_t i = 0; i < count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            centroid[k] += slot.fiducials[i][k] / double(count);
+        }
+    }
+
+    double covariance[3][3] = {};
+    for (size_t i = 0; i < count; ++i) {
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                covariance[row][column] += (slot.fiducials[i][row] - centroid[row]) *
+                                           (slot.fiducials[i][column] - centroid[column]) / double(count);
+            }
+        }
+    }
+
+    double values[3];
+    double axes[3][3];
+    symmetricEigen<3>(covariance, values, axes);
+
+    const double tip[3] = { tipMM[0] - centroid[0], tipMM[1] - centroid[1], tipMM[2] - centroid[2] };
+    const double tipSquared = tip[0] * tip[0] + tip[1] * tip[1] + tip[2] * tip[2];
+    const double trace = values[0] + values[1] + values[2];
+
+    double ratio = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        const double along = tip[0] * axes[0][k] + tip[1] * axes[1][k] + tip[2] * axes[2][k];
+        // Squared distances to axis k: of the tip, and mean over fiducials.
+        const double d2 = tipSquared - along * along;
+        const double f2 = trace - values[k];
+        if (f2 > 1e-12) {
+            ratio += d2 / f2;
+        }
+    }
+
+    const double n = double(count);
+    const double fleFromFre = 1.0 / (1.0 - 2.0 / n);
+    return float(std::sqrt(fleFromFre / n * (1.0 + ratio / 3.0)));
+}
@@ -0,0 +1,59 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "markermatcher.h"
+
+/** \brief Tool tip offsets per geometry, read from the acquisition hot path.
+ *
+ * Besides the tip (in marker coordinates) every slot keeps the factor that
+ * turns the marker registration error into a tip uncertainty, following
+ * Fitzpatrick's target registration error approximation:
+ *
+ *     FLE^2 = FRE^2 / (1 - 2/N)
+ *     TRE^2 = FLE^2 / N * (1 + 1/3 * sum_k d_k^2 / f_k^2)
+ *
+ * with d_k the distance of the tip to principal axis k of the fiducials and
+ * f_k the RMS distance of the fiducials to that axis. Updates are serialised
+ * by a mutex; reads are seqlocked and never block.
+ */
+class TipOffsets {
+public:
+    static const size_t MAX_GEOMETRIES = MarkerMatcher::MAX_GEOMETRIES;
+    static const size_t MAX_FIDUCIALS = 16;
+
+    // Registers the fiducials of a geometry, needed for the uncertainty factor.
+    bool setGeometry(uint32_t geometryId, const std::array<float, 3>* fiducials, size_t count);
+
+    bool setTip(uint32_t geometryId, const std::array<float, 3>& tipMM);
+    bool clearTip(uint32_t geometryId);
+
+    bool getTip(uint32_t geometryId, std::array<float, 3>& tipMM, float& uncertaintyScale) const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> geometryId{UINT32_MAX};
+        std::atomic<uint32_t> sequence{0};
+        bool hasTip = false;
+        std::array<float, 3> tipMM = { { 0.f, 0.f, 0.f } };
+        float uncertaintyScale = 0.f;
+
+        // Written under the mutex only.
+        size_t fiducialCount = 0;
+        std::array<std::array<float, 3>, MAX_FIDUCIALS> fiducials{};
+    };
+
+    Slot* findSlot(uint32_t geometryId) const;
+    void write(Slot& slot, bool hasTip, const std::array<float, 3>& tipMM);
+    static float computeUncertaintyScale(const Slot& slot, const std::array<float, 3>& tipMM);
+
+    std::array<Slot, MAX_GEOMETRIES> slots;
+    std::mutex mutex;
+};
@@ -0,0 +1,46 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "waitprimitives.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, uint64_t timeoutUS) {
+#ifdef _WIN32
+    DWORD timeoutMs = static_cast<DWORD>((timeoutUS + 999) / 1000);
+    WaitOnAddress(&word, &expected, sizeof(expected), timeoutMs);
+#elif defined(__linux__)
+    timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(timeoutUS / 1000000);
+    timeout.tv_nsec = static_cast<long>((timeoutUS % 1000000) * 1000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+#else
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(timeoutUS < 100 ? timeoutUS : 100));
+    }
+#endif
+}
+
+void futexWakeAll(std::atomic<uint32_t>& word) {
+#ifdef _WIN32
+    WakeByAddressAll(&word);
+#elif defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void) word;
+#endif
+}
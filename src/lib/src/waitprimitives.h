@@ -0,0 +1,25 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Spin-loop hint: lets the sibling hyper-thread run and avoids the memory-order exit penalty.
+inline void cpuRelax() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Sleeps while `word` still equals `expected`, at most `timeoutUS`; may wake spuriously.
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, uint64_t timeoutUS);
+void futexWakeAll(std::atomic<uint32_t>& word);
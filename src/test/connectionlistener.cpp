@@ -4,53 +4,682 @@
 
 #include "connectionlistener.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace {
+
+const uint64_t LISTENER_TAG = ~0ull;
+const uint64_t WAKE_TAG = ~0ull - 1;
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool setNonBlocking(SocketHandle socket) {
+#ifdef _WIN32
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+#else
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+bool wouldBlock() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+struct PollEvent {
+    uint64_t tag = 0;
+    bool readable = false;
+    bool writable = false;
+    bool closed = false;
+};
+
+}
+
+/** \brief Socket readiness for the I/O thread, plus a wake-up signal for send().
+ *
+ * epoll and an eventfd on Linux; elsewhere select() over every registered
+ * socket and a loopback UDP socket that wake() sends a byte to. Only wake()
+ * may be called from other threads.
+ */
+class EventPoller {
+public:
+    static const int MAX_EVENTS = 64;
+
+    ~EventPoller();
+
+    bool open();
+    bool add(SocketHandle socket, uint64_t tag);
+    void setWritable(SocketHandle socket, uint64_t tag, bool writable);
+    void remove(SocketHandle socket);
+
+    // Fills at most MAX_EVENTS events; a wake() is reported once as WAKE_TAG.
+    int wait(PollEvent* events, int timeoutMs);
+    void wake();
+
+private:
+#ifdef __linux__
+    int epollSocket = -1;
+    int wakeSocket = -1;
+#else
+    struct Entry {
+        SocketHandle socket;
+        uint64_t tag;
+        bool writable;
+    };
+
+    std::vector<Entry> entries;
+    SocketHandle wakeSocket = INVALID_SOCKET_HANDLE;
+#endif
+};
+
+#ifdef __linux__
+
+EventPoller::~EventPoller() {
+    for (int* fd : {&epollSocket, &wakeSocket}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+bool EventPoller::open() {
+    epollSocket = epoll_create1(EPOLL_CLOEXEC);
+    wakeSocket = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollSocket < 0 || wakeSocket < 0) {
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_TAG;
+    return epoll_ctl(epollSocket, EPOLL_CTL_ADD, wakeSocket, &event) == 0;
+}
+
+bool EventPoller::add(SocketHandle socket, uint64_t tag) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.u64 = tag;
+    return epoll_ctl(epollSocket, EPOLL_CTL_ADD, socket, &event) == 0;
+}
+
+void EventPoller::setWritable(SocketHandle socket, uint64_t tag, bool writable) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (writable ? EPOLLOUT : 0u);
+    event.data.u64 = tag;
+    epoll_ctl(epollSocket, EPOLL_CTL_MOD, socket, &event);
+}
+
+void EventPoller::remove(SocketHandle socket) {
+    epoll_ctl(epollSocket, EPOLL_CTL_DEL, socket, nullptr);
+}
+
+int EventPoller::wait(PollEvent* events, int timeoutMs) {
+    epoll_event ready[MAX_EVENTS];
+    const int count = epoll_wait(epollSocket, ready, MAX_EVENTS, timeoutMs);
+    for (int i = 0; i < count; ++i) {
+        events[i].tag = ready[i].data.u64;
+        events[i].readable = (ready[i].events & EPOLLIN) != 0;
+        events[i].writable = (ready[i].events & EPOLLOUT) != 0;
+        events[i].closed = (ready[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0;
+        if (events[i].tag == WAKE_TAG) {
+            uint64_t value;
+            while (read(wakeSocket, &value, sizeof(value)) > 0) {}
+        }
+    }
+    return std::max(count, 0);
+}
+
+void EventPoller::wake() {
+    uint64_t one = 1;
+    if (wakeSocket >= 0) {
+        ssize_t r = write(wakeSocket, &one, sizeof(one));
+        (void) r;
+    }
+}
+
+#else
+
+EventPoller::~EventPoller() {
+    if (wakeSocket != INVALID_SOCKET_HANDLE) {
+        closeSocket(wakeSocket);
+        wakeSocket = INVALID_SOCKET_HANDLE;
+    }
+}
+
+bool EventPoller::open() {
+    wakeSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (wakeSocket == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+    // Connected to itself, so wake() and the drain in wait() need no address.
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    return bind(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+           getsockname(wakeSocket, reinterpret_cast<sockaddr*>(&address), &length) == 0 &&
+           connect(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+           setNonBlocking(wakeSocket);
+}
+
+bool EventPoller::add(SocketHandle socket, uint64_t tag) {
+    // One fd_set slot stays reserved for the wake socket.
+    if (entries.size() + 1 >= FD_SETSIZE) {
+        return false;
+    }
+    entries.push_back({socket, tag, false});
+    return true;
+}
+
+void EventPoller::setWritable(SocketHandle socket, uint64_t, bool writable) {
+    for (Entry& entry : entries) {
+        if (entry.socket == socket) {
+            entry.writable = writable;
+        }
+    }
+}
+
+void EventPoller::remove(SocketHandle socket) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [socket](const Entry& entry) { return entry.socket == socket; }),
+                  entries.end());
+}
+
+int EventPoller::wait(PollEvent* events, int timeoutMs) {
+    fd_set readable;
+    fd_set writable;
+    FD_ZERO(&readable);
+    FD_ZERO(&writable);
+    FD_SET(wakeSocket, &readable);
+    SocketHandle highest = wakeSocket;
+    for (const Entry& entry : entries) {
+        FD_SET(entry.socket, &readable);
+        if (entry.writable) {
+            FD_SET(entry.socket, &writable);
+        }
+        highest = std::max(highest, entry.socket);
+    }
+
+    timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+    if (select(static_cast<int>(highest) + 1, &readable, &writable, nullptr, &timeout) <= 0) {
+        return 0;
+    }
+
+    int count = 0;
+    if (FD_ISSET(wakeSocket, &readable)) {
+        char value[16];
+        while (recv(wakeSocket, value, sizeof(value), 0) > 0) {}
+        events[count].tag = WAKE_TAG;
+        events[count].readable = true;
+        ++count;
+    }
+    for (const Entry& entry : entries) {
+        if (count == MAX_EVENTS) {
+            break;
+        }
+        const bool canRead = FD_ISSET(entry.socket, &readable) != 0;
+        const bool canWrite = FD_ISSET(entry.socket, &writable) != 0;
+        if (canRead || canWrite) {
+            events[count].tag = entry.tag;
+            events[count].readable = canRead;
+            events[count].writable = canWrite;
+            events[count].closed = false;
+            ++count;
+        }
+    }
+    return count;
+}
+
+void EventPoller::wake() {
+    if (wakeSocket != INVALID_SOCKET_HANDLE) {
+        const char one = 1;
+        ::send(wakeSocket, &one, 1, 0);
+    }
+}
+
+#endif
 
 ConnectionListener::ConnectionListener() {}
 
 ConnectionListener::~ConnectionListener() {
-	run = false;
-	connectionListener.detach();
-    serverSocket->CloseSocket();
+    shutdown();
 }
 
-void ConnectionListener::init() {
-    serverSocket = igtl::ServerSocket::New();
-    int r = serverSocket->CreateServer(22222);
-    if(r == 0){
-		run = true;
-		connectionListener = std::thread(&ConnectionListener::listenForConnections, this);
+bool ConnectionListener::init(uint16_t port) {
+    if (run) {
+        return false;
+    }
+
+    serverSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (serverSocket == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!setNonBlocking(serverSocket) ||
+        bind(serverSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(serverSocket, 64) != 0) {
+        shutdown();
+        return false;
     }
+
+    poller = std::make_unique<EventPoller>();
+    if (!poller->open() || !poller->add(serverSocket, LISTENER_TAG)) {
+        shutdown();
+        return false;
+    }
+
+    run = true;
+    connectionListener = std::thread(&ConnectionListener::listenForConnections, this);
+    return true;
 }
 
-void ConnectionListener::listenForConnections() {
-	while (run) {
-		igtl::Socket::Pointer socket;
-		socket = serverSocket->WaitForConnection(10000);
-		if (!socket.IsNotNull()) {
-			std::cout << "No connection" << std::endl;
-		}
-		else {
-			std::string address;
-			int port;
-			socket->GetSocketAddressAndPort(address, port);
-			std::cout << "connection from " << address << ":" << port << std::endl;
-			connections.push_back(socket);
-		}
-	}
+void ConnectionListener::shutdown() {
+    if (run.exchange(false)) {
+        wake();
+    }
+    if (connectionListener.joinable()) {
+        connectionListener.join();
+    }
+
+    for (Client& client : connections) {
+        closeClient(client);
+    }
+    connections.clear();
+    clientCount = 0;
+
+    if (serverSocket != INVALID_SOCKET_HANDLE) {
+        closeSocket(serverSocket);
+        serverSocket = INVALID_SOCKET_HANDLE;
+    }
+    poller.reset();
+}
+
+size_t ConnectionListener::registerTool(const std::string& name) {
+    tools.push_back(name);
+    return tools.size() - 1;
+}
+
+size_t ConnectionListener::getSubscriptions(Subscription* subscriptions, size_t count) const {
+    std::lock_guard<std::mutex> lock(groupsMutex);
+    size_t found = 0;
+    for (const Group& group : groups) {
+        if (group.clients > 0 && found < count) {
+            subscriptions[found++] = group.subscription;
+        }
+    }
+    return found;
+}
+
+void ConnectionListener::send(const Subscription& subscription, PacketRef packet) {
+    if (!run || clientCount == 0 || !packet) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(groupsMutex);
+        for (Group& group : groups) {
+            if (group.clients > 0 && group.subscription == subscription) {
+                group.latest = std::move(packet);
+                ++group.generation;
+                break;
+            }
+        }
+    }
+    wake();
 }
 
 void ConnectionListener::send(igtl::TrackingDataMessage::Pointer message) {
-    if(connections.size() > 0) {
-		auto iter = connections.begin();
-        while (iter != connections.end()) {
-			auto socket = *iter;
-			int r = socket->Send(message->GetPackPointer(), message->GetPackSize());
-			if (r != 1) {
-				iter = connections.erase(iter);
-			}
-			else {
-				++iter;
-			}
+    send(message->GetPackPointer(), message->GetPackSize());
+}
+
+void ConnectionListener::send(const void* data, size_t size) {
+    if (!run || clientCount == 0) {
+        return;
+    }
+
+    send(pool.acquire(data, size));
+}
+
+void ConnectionListener::send(PacketRef packet) {
+    if (!run || clientCount == 0 || !packet) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(groupsMutex);
+        for (Group& group : groups) {
+            if (group.clients > 0) {
+                group.latest = packet;
+                ++group.generation;
+            }
+        }
+    }
+    wake();
+}
+
+size_t ConnectionListener::getClientCount() const {
+    return clientCount;
+}
+
+uint64_t ConnectionListener::getDroppedCount() const {
+    return dropped;
+}
+
+void ConnectionListener::wake() {
+    if (poller != nullptr) {
+        poller->wake();
+    }
+}
+
+void ConnectionListener::listenForConnections() {
+    PollEvent events[EventPoller::MAX_EVENTS];
+
+    while (run) {
+        const int count = poller->wait(events, 100);
+
+        bool published = false;
+        for (int i = 0; i < count; ++i) {
+            const uint64_t tag = events[i].tag;
+            if (tag == LISTENER_TAG) {
+                acceptClients();
+            }
+            else if (tag == WAKE_TAG) {
+                published = true;
+            }
+            else {
+                const SocketHandle socket = static_cast<SocketHandle>(tag);
+                auto iter = std::find_if(connections.begin(), connections.end(),
+                                         [socket](const Client& c) { return c.socket == socket; });
+                if (iter == connections.end()) {
+                    continue;
+                }
+                if (events[i].closed) {
+                    closeClient(*iter);
+                    continue;
+                }
+                if (events[i].readable && !receive(*iter)) {
+                    closeClient(*iter);
+                    continue;
+                }
+                if (events[i].writable) {
+                    flush(*iter);
+                }
+            }
+        }
+
+        const int64_t now = nowMs();
+        for (Client& client : connections) {
+            if (client.socket == INVALID_SOCKET_HANDLE) {
+                continue;
+            }
+            if (published && !client.inFlight) {
+                flush(client);
+            }
+            if (client.inFlight && client.stalledSinceMs != 0 &&
+                now - client.stalledSinceMs > STALL_TIMEOUT_MS) {
+                closeClient(client);
+            }
+        }
+
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const Client& c) { return c.socket == INVALID_SOCKET_HANDLE; }),
+                          connections.end());
+        clientCount = connections.size();
+    }
+}
+
+void ConnectionListener::acceptClients() {
+    while (true) {
+        SocketHandle socket = accept(serverSocket, nullptr, nullptr);
+        if (socket == INVALID_SOCKET_HANDLE) {
+            return;
+        }
+
+        int enabled = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+#ifdef SO_NOSIGPIPE
+        setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+        if (!setNonBlocking(socket) || !poller->add(socket, static_cast<uint64_t>(socket))) {
+            closeSocket(socket);
+            continue;
+        }
+
+        Client client;
+        client.socket = socket;
+        if (!subscribe(client, Subscription())) {
+            closeClient(client);
+            continue;
+        }
+        connections.push_back(std::move(client));
+        clientCount = connections.size();
+    }
+}
+
+bool ConnectionListener::receive(Client& client) {
+    while (true) {
+        unsigned char discard[512];
+        unsigned char* target = client.received.data() + client.receivedSize;
+        size_t wanted;
+        const bool header = client.receivedSize < HEADER_SIZE;
+        if (client.skip > 0) {
+            target = discard;
+            wanted = static_cast<size_t>(std::min<uint64_t>(client.skip, sizeof(discard)));
+        }
+        else if (header) {
+            wanted = HEADER_SIZE - client.receivedSize;
+        }
+        else {
+            wanted = static_cast<size_t>(HEADER_SIZE + client.bodySize - client.receivedSize);
+        }
+
+        const int r = recv(client.socket, reinterpret_cast<char*>(target), static_cast<int>(wanted), 0);
+        if (r == 0) {
+            return false;
         }
+        if (r < 0) {
+            return wouldBlock();
+        }
+
+        if (client.skip > 0) {
+            client.skip -= static_cast<uint64_t>(r);
+            continue;
+        }
+
+        client.receivedSize += static_cast<size_t>(r);
+        if (header && client.receivedSize == HEADER_SIZE) {
+            client.bodySize = 0;
+            for (size_t i = 42; i < 50; ++i) {
+                client.bodySize = (client.bodySize << 8) | client.received[i];
+            }
+            if (client.bodySize > MAX_BODY_SIZE) {
+                // Nothing we handle has a large body.
+                client.skip = client.bodySize;
+                client.receivedSize = 0;
+                continue;
+            }
+        }
+        if (client.receivedSize == HEADER_SIZE + client.bodySize) {
+            if (!handleMessage(client)) {
+                return false;
+            }
+            client.receivedSize = 0;
+        }
+    }
+}
+
+bool ConnectionListener::handleMessage(Client& client) {
+    const char* type = reinterpret_cast<const char*>(client.received.data() + 2);
+    const char* deviceName = reinterpret_cast<const char*>(client.received.data() + 14);
+    const unsigned char* body = client.received.data() + HEADER_SIZE;
+
+    if (strncmp(type, "STT_TDATA", 12) == 0) {
+        Subscription subscription;
+        if (client.bodySize >= 4) {
+            subscription.intervalMs = (uint32_t(body[0]) << 24) | (uint32_t(body[1]) << 16) |
+                                      (uint32_t(body[2]) << 8) | uint32_t(body[3]);
+        }
+        subscription.toolMask = parseToolMask(deviceName, 20);
+        return subscribe(client, subscription);
+    }
+    if (strncmp(type, "STP_TDATA", 12) == 0) {
+        unsubscribe(client);
+    }
+    return true;
+}
+
+uint64_t ConnectionListener::parseToolMask(const char* names, size_t size) const {
+    uint64_t mask = 0;
+    size_t begin = 0;
+    while (begin < size && names[begin] != '\0') {
+        size_t end = begin;
+        while (end < size && names[end] != '\0' && names[end] != ',') {
+            ++end;
+        }
+        for (size_t tool = 0; tool < tools.size() && tool < 64; ++tool) {
+            if (tools[tool].size() == end - begin && tools[tool].compare(0, end - begin, names + begin, end - begin) == 0) {
+                mask |= 1ull << tool;
+            }
+        }
+        begin = end + 1;
+    }
+    // An empty or unknown name addresses the tracker itself, i.e. every tool.
+    return mask != 0 ? mask : ALL_TOOLS;
+}
+
+bool ConnectionListener::subscribe(Client& client, const Subscription& subscription) {
+    std::lock_guard<std::mutex> lock(groupsMutex);
+
+    if (client.group != NO_GROUP && groups[client.group].subscription == subscription) {
+        return true;
+    }
+
+    size_t target = NO_GROUP;
+    for (size_t i = 0; i < groups.size(); ++i) {
+        // The client's own group is free when it is the only member.
+        const size_t others = groups[i].clients - (i == client.group ? 1u : 0u);
+        if (others > 0 && groups[i].subscription == subscription) {
+            target = i;
+            break;
+        }
+        if (others == 0 && target == NO_GROUP) {
+            target = i;
+        }
+    }
+    if (target == NO_GROUP) {
+        return false;
+    }
+
+    if (client.group != NO_GROUP && --groups[client.group].clients == 0) {
+        groups[client.group].latest.reset();
+    }
+
+    Group& group = groups[target];
+    group.subscription = subscription;
+    ++group.clients;
+    client.group = target;
+    // Start with the next message of the group, not a stale one.
+    client.sentGeneration = group.generation;
+    return true;
+}
+
+void ConnectionListener::unsubscribe(Client& client) {
+    std::lock_guard<std::mutex> lock(groupsMutex);
+    if (client.group != NO_GROUP && --groups[client.group].clients == 0) {
+        groups[client.group].latest.reset();
+    }
+    client.group = NO_GROUP;
+}
+
+bool ConnectionListener::flush(Client& client) {
+    while (client.socket != INVALID_SOCKET_HANDLE) {
+        if (!client.inFlight) {
+            if (client.group == NO_GROUP) {
+                break;
+            }
+            std::lock_guard<std::mutex> lock(groupsMutex);
+            const Group& group = groups[client.group];
+            if (group.generation == client.sentGeneration || !group.latest) {
+                break;
+            }
+            dropped += group.generation - client.sentGeneration - 1;
+            client.inFlight = group.latest;
+            client.inFlightGeneration = group.generation;
+            client.inFlightGroup = client.group;
+            client.offset = 0;
+        }
+
+        const PacketBuffer& packet = *client.inFlight;
+        const int sent = ::send(client.socket, reinterpret_cast<const char*>(packet.data() + client.offset),
+                                static_cast<int>(packet.size() - client.offset), SEND_FLAGS);
+        if (sent < 0) {
+            if (wouldBlock()) {
+                break;
+            }
+            closeClient(client);
+            return false;
+        }
+
+        client.offset += static_cast<size_t>(sent);
+        client.stalledSinceMs = 0;
+        if (client.offset == packet.size()) {
+            if (client.inFlightGroup == client.group) {
+                client.sentGeneration = client.inFlightGeneration;
+            }
+            client.inFlight.reset();
+        }
+    }
+
+    const bool pending = client.socket != INVALID_SOCKET_HANDLE && client.inFlight;
+    if (pending && client.stalledSinceMs == 0) {
+        client.stalledSinceMs = nowMs();
+    }
+    if (client.socket != INVALID_SOCKET_HANDLE && pending != client.writeArmed) {
+        poller->setWritable(client.socket, static_cast<uint64_t>(client.socket), pending);
+        client.writeArmed = pending;
+    }
+    return true;
+}
+
+void ConnectionListener::closeClient(Client& client) {
+    if (client.socket == INVALID_SOCKET_HANDLE) {
+        return;
     }
+    unsubscribe(client);
+    poller->remove(client.socket);
+    closeSocket(client.socket);
+    client.socket = INVALID_SOCKET_HANDLE;
+    client.inFlight.reset();
 }
@@ -5,25 +5,130 @@
 #pragma once
 
 
-#include <igtl/igtlServerSocket.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 #include <igtl/igtlTrackingDataMessage.h>
+#include "../lib/src/socketcompat.h"
+#include "packetpool.h"
 
+class EventPoller;
+
+/** \brief Non-blocking OpenIGTLink streaming server.
+ *
+ * send() only publishes the packed message as the latest one and wakes the
+ * I/O thread; it never touches a socket. The I/O thread waits with epoll on
+ * Linux and select() elsewhere, keeps one in-flight buffer and offset per
+ * client and only waits for writability while a client has unsent bytes. A client that is still busy with an older message skips
+ * straight to the latest one once it is done (drop-to-latest), and a client
+ * that makes no progress for STALL_TIMEOUT_MS is disconnected.
+ *
+ * Every client sends from the same pooled PacketBuffer, so a message is
+ * packed and copied once regardless of the number of clients.
+ *
+ * Clients are grouped by subscription. A client that sends STT_TDATA gets
+ * the requested resolution and, if the message device name lists registered
+ * tools (comma separated), only those tools; STP_TDATA stops it. Clients that
+ * never send STT_TDATA receive every tool at full rate. Once all
+ * MAX_SUBSCRIPTIONS groups are taken, a client asking for yet another
+ * subscription is disconnected.
+ */
 class ConnectionListener {
 public:
+    static const int STALL_TIMEOUT_MS = 2000;
+    static const size_t MAX_SUBSCRIPTIONS = 16;
+    static const uint64_t ALL_TOOLS = ~0ull;
+
+    struct Subscription {
+        uint32_t intervalMs = 0;
+        uint64_t toolMask = ALL_TOOLS;
+
+        bool operator==(const Subscription& other) const {
+            return intervalMs == other.intervalMs && toolMask == other.toolMask;
+        }
+    };
+
     ConnectionListener();
 
     virtual ~ConnectionListener();
 
-    void init();
-    
-	void listenForConnections();
+    bool init(uint16_t port = 22222);
+    void shutdown();
+
+    // Tools must be registered before init(); the returned index is the bit used in toolMask.
+    size_t registerTool(const std::string& name);
+
+    // Subscriptions that at least one streaming client currently holds.
+    size_t getSubscriptions(Subscription* subscriptions, size_t count) const;
+
+    void send(const Subscription& subscription, PacketRef packet);
+
+    // Sends to every streaming client regardless of its subscription.
     void send(igtl::TrackingDataMessage::Pointer message);
+    void send(const void* data, size_t size);
+    void send(PacketRef packet);
+
+    size_t getClientCount() const;
+    uint64_t getDroppedCount() const;
 private:
-	bool run;
+    static const size_t NO_GROUP = MAX_SUBSCRIPTIONS;
+    static const size_t HEADER_SIZE = 58;
+    static const size_t MAX_BODY_SIZE = 64;
+
+    struct Group {
+        Subscription subscription;
+        size_t clients = 0;
+        PacketRef latest;
+        uint64_t generation = 0;
+    };
+
+    struct Client {
+        SocketHandle socket = INVALID_SOCKET_HANDLE;
+        size_t group = NO_GROUP;
+        size_t inFlightGroup = NO_GROUP;
+        PacketRef inFlight;
+        size_t offset = 0;
+        uint64_t inFlightGeneration = 0;
+        uint64_t sentGeneration = 0;
+        bool writeArmed = false;
+        int64_t stalledSinceMs = 0;
+
+        std::array<unsigned char, HEADER_SIZE + MAX_BODY_SIZE> received{};
+        size_t receivedSize = 0;
+        uint64_t bodySize = 0;
+        uint64_t skip = 0;
+    };
+
+    void listenForConnections();
+    void acceptClients();
+    bool receive(Client& client);
+    bool handleMessage(Client& client);
+    uint64_t parseToolMask(const char* names, size_t size) const;
+    // False when every group is taken by other subscriptions.
+    bool subscribe(Client& client, const Subscription& subscription);
+    void unsubscribe(Client& client);
+    bool flush(Client& client);
+    void closeClient(Client& client);
+    void wake();
+
+    SocketLibrary socketLibrary;
+    std::atomic<bool> run{false};
     std::thread connectionListener;
-    igtl::ServerSocket::Pointer serverSocket;
-    std::vector<igtl::Socket::Pointer> connections;
-};
+    SocketHandle serverSocket = INVALID_SOCKET_HANDLE;
+    std::unique_ptr<EventPoller> poller;
 
+    std::vector<Client> connections;
+    std::vector<std::string> tools;
 
+    mutable std::mutex groupsMutex;
+    std::array<Group, MAX_SUBSCRIPTIONS> groups;
+    PacketPool pool;
+
+    std::atomic<size_t> clientCount{0};
+    std::atomic<uint64_t> dropped{0};
+};
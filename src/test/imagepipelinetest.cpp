@@ -0,0 +1,202 @@
+//
+// Created on 19/10/2026.
+//
+// Lossless round trip through AtracsysImagePipeline: synthetic camera frames,
+// fiducial blobs on a noisy background in padded rows, are pushed like the
+// wrapper's image thread pushes the SDK images and must come back from
+// decodeImage() pixel for pixel after Rice coding. Covers 8 and 16-bit
+// pixels, widths that are not a multiple of the 32-pixel Rice block, white
+// noise whose residuals take the escape path, and downsampling against a box
+// average computed here.
+//
+
+#include <atracsyswrapper/atracsysimages.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+const uint8_t PADDING = 0xCD;
+const uint32_t WAIT_MS = 2000;
+
+struct CameraImage {
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t bytesPerPixel = 1;
+    int32_t strideBytes = 0;
+    // Rows of strideBytes, the bytes past the pixels set to PADDING.
+    std::vector<uint8_t> rows;
+};
+
+uint32_t readPixel(const uint8_t* pixels, size_t index, uint8_t bytesPerPixel) {
+    return bytesPerPixel == 2 ? uint32_t(pixels[2 * index]) | uint32_t(pixels[2 * index + 1]) << 8 : pixels[index];
+}
+
+void writePixel(uint8_t* pixels, size_t index, uint8_t bytesPerPixel, uint32_t value) {
+    if (bytesPerPixel == 2) {
+        pixels[2 * index] = uint8_t(value);
+        pixels[2 * index + 1] = uint8_t(value >> 8);
+    }
+    else {
+        pixels[index] = uint8_t(value);
+    }
+}
+
+CameraImage emptyImage(uint16_t width, uint16_t height, uint8_t bytesPerPixel, int32_t paddingBytes) {
+    CameraImage image;
+    image.width = width;
+    image.height = height;
+    image.bytesPerPixel = bytesPerPixel;
+    image.strideBytes = int32_t(width) * bytesPerPixel + paddingBytes;
+    image.rows.assign(size_t(image.strideBytes) * height, PADDING);
+    return image;
+}
+
+void setPixel(CameraImage& image, size_t x, size_t y, uint32_t value) {
+    writePixel(image.rows.data() + y * size_t(image.strideBytes), x, image.bytesPerPixel, value);
+}
+
+// Dark background with sensor noise and a few saturated-centre Gaussian blobs, like an IR frame of fiducials.
+CameraImage fiducialImage(std::mt19937& random, uint16_t width, uint16_t height, uint8_t bytesPerPixel,
+                          int32_t paddingBytes) {
+    CameraImage image = emptyImage(width, height, bytesPerPixel, paddingBytes);
+    const float maximum = bytesPerPixel == 2 ? 4095.f : 255.f;
+    std::normal_distribution<float> noise(0.f, maximum / 200.f);
+    std::uniform_real_distribution<float> column(0.f, float(width));
+    std::uniform_real_distribution<float> row(0.f, float(height));
+    std::uniform_real_distribution<float> radius(2.f, 8.f);
+
+    std::vector<float> blobs;
+    for (int i = 0; i < 12; ++i) {
+        blobs.push_back(column(random));
+        blobs.push_back(row(random));
+        blobs.push_back(radius(random));
+    }
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            float value = maximum * 0.05f + noise(random);
+            for (size_t b = 0; b < blobs.size(); b += 3) {
+                const float dx = float(x) - blobs[b];
+                const float dy = float(y) - blobs[b + 1];
+                value += maximum * std::exp(-(dx * dx + dy * dy) / (2.f * blobs[b + 2] * blobs[b + 2]));
+            }
+            setPixel(image, x, y, uint32_t(std::min(std::max(value, 0.f), maximum)));
+        }
+    }
+    return image;
+}
+
+// Uniform noise over the whole range: most residuals need the escape code.
+CameraImage noiseImage(std::mt19937& random, uint16_t width, uint16_t height, uint8_t bytesPerPixel,
+                       int32_t paddingBytes) {
+    CameraImage image = emptyImage(width, height, bytesPerPixel, paddingBytes);
+    std::uniform_int_distribution<uint32_t> value(0, bytesPerPixel == 2 ? 0xFFFFu : 0xFFu);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            setPixel(image, x, y, value(random));
+        }
+    }
+    return image;
+}
+
+// The packed pixels the pipeline should return, box-averaged over `factor` x `factor` with rounding.
+std::vector<uint8_t> expectedPixels(const CameraImage& image, uint32_t factor) {
+    const size_t outWidth = image.width / factor;
+    const size_t outHeight = image.height / factor;
+    const uint32_t area = factor * factor;
+    std::vector<uint8_t> pixels(outWidth * outHeight * image.bytesPerPixel);
+    for (size_t y = 0; y < outHeight; ++y) {
+        for (size_t x = 0; x < outWidth; ++x) {
+            uint32_t sum = 0;
+            for (size_t dy = 0; dy < factor; ++dy) {
+                const uint8_t* row = image.rows.data() + (y * factor + dy) * size_t(image.strideBytes);
+                for (size_t dx = 0; dx < factor; ++dx) {
+                    sum += readPixel(row, x * factor + dx, image.bytesPerPixel);
+                }
+            }
+            writePixel(pixels.data(), y * outWidth + x, image.bytesPerPixel, (sum + area / 2) / area);
+        }
+    }
+    return pixels;
+}
+
+bool roundTrip(const char* name, const CameraImage& source, uint32_t downsample) {
+    AtracsysImageOptions options;
+    options.enabled = true;
+    options.compress = true;
+    options.downsample = downsample;
+    AtracsysImagePipeline pipeline(options);
+
+    const std::vector<uint8_t> expected = expectedPixels(source, downsample);
+    AtracsysImage image;
+    std::vector<uint8_t> decoded;
+    size_t encodedBytes = 0;
+    for (uint64_t frameIndex = 0; frameIndex < 4; ++frameIndex) {
+        const AtracsysCamera camera = frameIndex % 2 == 0 ? AtracsysCamera::Left : AtracsysCamera::Right;
+        if (!pipeline.push(camera, frameIndex, 1000 * frameIndex, source.rows.data(), source.width, source.height,
+                           source.strideBytes, source.bytesPerPixel)) {
+            printf("FAIL: %s: frame %llu dropped\n", name, static_cast<unsigned long long>(frameIndex));
+            return false;
+        }
+        if (!pipeline.wait(image, WAIT_MS)) {
+            printf("FAIL: %s: frame %llu never came out\n", name, static_cast<unsigned long long>(frameIndex));
+            return false;
+        }
+        if (image.frameIndex != frameIndex || image.camera != camera || image.timestampUS != 1000 * frameIndex ||
+            image.encoding != AtracsysImageEncoding::DeltaRice || image.width != source.width / downsample ||
+            image.height != source.height / downsample || image.bytesPerPixel != source.bytesPerPixel) {
+            printf("FAIL: %s: frame %llu came out with the wrong header\n", name,
+                   static_cast<unsigned long long>(frameIndex));
+            return false;
+        }
+        if (!decodeImage(image, decoded)) {
+            printf("FAIL: %s: frame %llu does not decode\n", name, static_cast<unsigned long long>(frameIndex));
+            return false;
+        }
+        if (decoded.size() != expected.size()) {
+            printf("FAIL: %s: %zu bytes decoded instead of %zu\n", name, decoded.size(), expected.size());
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (decoded[i] != expected[i]) {
+                printf("FAIL: %s: byte %zu is %u instead of %u\n", name, i, unsigned(decoded[i]),
+                       unsigned(expected[i]));
+                return false;
+            }
+        }
+        encodedBytes = image.data.size();
+    }
+
+    const AtracsysImageStats stats = pipeline.getStats();
+    if (stats.pushed != 4 || stats.processed != 4 || stats.dropped != 0) {
+        printf("FAIL: %s: %llu pushed, %llu processed, %llu dropped\n", name,
+               static_cast<unsigned long long>(stats.pushed), static_cast<unsigned long long>(stats.processed),
+               static_cast<unsigned long long>(stats.dropped));
+        return false;
+    }
+    printf("%-24s %5zu -> %5zu bytes\n", name, expected.size(), encodedBytes);
+    return true;
+}
+
+}
+
+int main() {
+    std::mt19937 random(20261019u);
+    const bool passed =
+            roundTrip("8-bit fiducials", fiducialImage(random, 333, 201, 1, 19), 1) &&
+            roundTrip("16-bit fiducials", fiducialImage(random, 250, 130, 2, 12), 1) &&
+            roundTrip("8-bit noise", noiseImage(random, 97, 61, 1, 3), 1) &&
+            roundTrip("16-bit noise", noiseImage(random, 97, 61, 2, 6), 1) &&
+            roundTrip("single column", fiducialImage(random, 1, 40, 2, 2), 1) &&
+            roundTrip("8-bit downsampled x2", fiducialImage(random, 333, 201, 1, 19), 2) &&
+            roundTrip("16-bit downsampled x3", fiducialImage(random, 250, 130, 2, 0), 3);
+    if (!passed) {
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
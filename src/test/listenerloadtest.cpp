@@ -0,0 +1,206 @@
+//
+// Created on 19/10/2026.
+//
+// ConnectionListener under load: 50 local clients read 4 KB messages sent at
+// 500 Hz for 4 s while one more client never reads; the messages are large
+// enough for that client to fill its socket send buffer (up to 4 MB) early
+// in the run. Every reader must get the messages intact and in order and
+// keep up with at least 95% of them, the send rate must hold, and the
+// stalled client must be disconnected after STALL_TIMEOUT_MS without
+// holding back the others.
+//
+
+#include "connectionlistener.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint16_t PORT = 22231;
+const size_t READERS = 50;
+const size_t MESSAGE_SIZE = 4096;
+const size_t MESSAGES = 2000;
+const std::chrono::microseconds PERIOD(2000);
+
+struct Reader {
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    std::vector<unsigned char> pending;
+    uint64_t received = 0;
+    uint64_t last = 0;
+    bool corrupt = false;
+};
+
+SocketHandle connectClient(int receiveBuffer) {
+    SocketHandle socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket == INVALID_SOCKET_HANDLE) {
+        return socket;
+    }
+    if (receiveBuffer > 0) {
+        setsockopt(socket, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(PORT);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(socket);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return socket;
+}
+
+// Messages carry their 1-based sequence number, followed by that number's low byte as filler.
+void fillMessage(std::vector<unsigned char>& message, uint64_t sequence) {
+    memcpy(message.data(), &sequence, sizeof(sequence));
+    memset(message.data() + sizeof(sequence), static_cast<int>(sequence & 0xff), message.size() - sizeof(sequence));
+}
+
+void consume(Reader& reader, const unsigned char* data, size_t size) {
+    reader.pending.insert(reader.pending.end(), data, data + size);
+    size_t offset = 0;
+    for (; reader.pending.size() - offset >= MESSAGE_SIZE; offset += MESSAGE_SIZE) {
+        const unsigned char* message = reader.pending.data() + offset;
+        uint64_t sequence = 0;
+        memcpy(&sequence, message, sizeof(sequence));
+        bool intact = sequence > reader.last;
+        for (size_t i = sizeof(sequence); i < MESSAGE_SIZE && intact; ++i) {
+            intact = message[i] == (sequence & 0xff);
+        }
+        reader.corrupt = reader.corrupt || !intact;
+        reader.last = sequence;
+        ++reader.received;
+    }
+    reader.pending.erase(reader.pending.begin(), reader.pending.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+// Polls every reader until all of them have seen the last message or `deadline` passes.
+void readAll(std::vector<Reader>& readers, std::chrono::steady_clock::time_point deadline) {
+    std::vector<pollfd> descriptors(readers.size());
+    for (size_t i = 0; i < readers.size(); ++i) {
+        descriptors[i].fd = readers[i].socket;
+        descriptors[i].events = POLLIN;
+    }
+    unsigned char buffer[65536];
+    while (std::chrono::steady_clock::now() < deadline) {
+        size_t done = 0;
+        for (const Reader& reader : readers) {
+            done += reader.last == MESSAGES ? 1 : 0;
+        }
+        if (done == readers.size()) {
+            return;
+        }
+        if (poll(descriptors.data(), descriptors.size(), 10) <= 0) {
+            continue;
+        }
+        for (size_t i = 0; i < readers.size(); ++i) {
+            if ((descriptors[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                continue;
+            }
+            const ssize_t size = recv(readers[i].socket, buffer, sizeof(buffer), 0);
+            if (size <= 0) {
+                descriptors[i].fd = -1;
+                continue;
+            }
+            consume(readers[i], buffer, static_cast<size_t>(size));
+        }
+    }
+}
+
+}
+
+int main() {
+    ConnectionListener listener;
+    if (!listener.init(PORT)) {
+        printf("FAIL: cannot listen on port %u\n", unsigned(PORT));
+        return 1;
+    }
+
+    std::vector<Reader> readers(READERS);
+    for (Reader& reader : readers) {
+        reader.socket = connectClient(0);
+        if (reader.socket == INVALID_SOCKET_HANDLE) {
+            printf("FAIL: cannot connect to port %u\n", unsigned(PORT));
+            return 1;
+        }
+    }
+    // A small receive window makes the client that never reads stall quickly.
+    const SocketHandle stalled = connectClient(4096);
+    if (stalled == INVALID_SOCKET_HANDLE) {
+        printf("FAIL: cannot connect to port %u\n", unsigned(PORT));
+        return 1;
+    }
+    const auto connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (listener.getClientCount() < READERS + 1 && std::chrono::steady_clock::now() < connectDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (listener.getClientCount() != READERS + 1) {
+        printf("FAIL: %zu of %zu clients accepted\n", listener.getClientCount(), READERS + 1);
+        return 1;
+    }
+
+    std::thread sender([&listener]() {
+        std::vector<unsigned char> message(MESSAGE_SIZE);
+        auto next = std::chrono::steady_clock::now();
+        for (uint64_t sequence = 1; sequence <= MESSAGES; ++sequence) {
+            next += PERIOD;
+            std::this_thread::sleep_until(next);
+            fillMessage(message, sequence);
+            listener.send(message.data(), message.size());
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    readAll(readers, start + PERIOD * MESSAGES + std::chrono::seconds(5));
+    sender.join();
+    const double elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = true;
+    uint64_t fewest = MESSAGES;
+    for (size_t i = 0; i < READERS; ++i) {
+        const Reader& reader = readers[i];
+        fewest = std::min(fewest, reader.received);
+        if (reader.corrupt || reader.last != MESSAGES || reader.received < MESSAGES * 95 / 100) {
+            printf("FAIL: reader %zu got %llu messages up to %llu%s\n", i,
+                   static_cast<unsigned long long>(reader.received), static_cast<unsigned long long>(reader.last),
+                   reader.corrupt ? ", corrupt or out of order" : "");
+            ok = false;
+        }
+    }
+    const double rateHz = double(MESSAGES) / elapsedS;
+    if (rateHz < 450.0) {
+        printf("FAIL: only %.0f Hz sent\n", rateHz);
+        ok = false;
+    }
+
+    // Readers are done by now, so the stalled client has had the whole run to stall.
+    const auto stallDeadline = std::chrono::steady_clock::now() +
+                               std::chrono::milliseconds(2 * ConnectionListener::STALL_TIMEOUT_MS);
+    while (listener.getClientCount() > READERS && std::chrono::steady_clock::now() < stallDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (listener.getClientCount() != READERS) {
+        printf("FAIL: the client that never reads was not disconnected\n");
+        ok = false;
+    }
+
+    printf("%zu readers, %zu messages of %zu bytes at %.0f Hz: fewest received %llu, %llu dropped to latest\n",
+           READERS, MESSAGES, MESSAGE_SIZE, rateHz, static_cast<unsigned long long>(fewest),
+           static_cast<unsigned long long>(listener.getDroppedCount()));
+
+    listener.shutdown();
+    for (Reader& reader : readers) {
+        closeSocket(reader.socket);
+    }
+    closeSocket(stalled);
+    if (!ok) {
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
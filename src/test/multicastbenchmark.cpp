@@ -0,0 +1,125 @@
+//
+// Created on 19/10/2026.
+//
+// Pose datagram throughput against the number of tools: encoding alone, then
+// an unpaced burst and a 1 kHz stream through MulticastPosePublisher to an
+// AtracsysPoseReceiver on the same host, counting what arrives and what the
+// receiver reports lost. The group defaults to 239.255.42.99; pass another
+// address, e.g. 127.0.0.1 where multicast is not routed, as the argument.
+//
+
+#include "multicastposepublisher.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const uint16_t PORT = 22232;
+const size_t ENCODE_FRAMES = 200000;
+const size_t BURST_FRAMES = 20000;
+const size_t PACED_FRAMES = 2000;
+const std::chrono::microseconds PERIOD(1000);
+
+void fillFrame(AtracsysFrame& frame, uint32_t toolCount) {
+    frame.poseCount = toolCount;
+    for (uint32_t i = 0; i < toolCount; ++i) {
+        AtracsysPose& pose = frame.poses[i];
+        pose.geometryId = i;
+        pose.registrationErrorMM = 0.1f;
+        pose.transform[0][3] = 10.f * float(i);
+        pose.transform[1][3] = -20.f;
+        pose.transform[2][3] = 1500.f;
+    }
+}
+
+struct StreamStats {
+    double sendUs = 0.0;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t sendErrors = 0;
+};
+
+// Sends `frames` frames, paced when `period` is non-zero, while a receiver thread drains the group.
+bool stream(const std::string& group, uint32_t toolCount, size_t frames, std::chrono::microseconds period,
+            StreamStats& stats) {
+    AtracsysPoseReceiver receiver;
+    MulticastPosePublisher publisher;
+    if (!receiver.open(group, PORT) || !publisher.open(group, PORT, 0)) {
+        return false;
+    }
+
+    std::atomic<bool> sending{true};
+    std::thread reader([&receiver, &sending]() {
+        AtracsysFrame received;
+        while (receiver.receive(received, 200) || sending) {
+        }
+    });
+
+    AtracsysFrame frame;
+    fillFrame(frame, toolCount);
+    const Clock::time_point start = Clock::now();
+    Clock::time_point next = start;
+    double busyUs = 0.0;
+    for (size_t i = 0; i < frames; ++i) {
+        if (period.count() > 0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+        frame.index = i;
+        frame.timestampUS = i * 1000;
+        const Clock::time_point sendStart = Clock::now();
+        publisher.onFrame(frame);
+        busyUs += std::chrono::duration<double, std::micro>(Clock::now() - sendStart).count();
+    }
+    sending = false;
+    reader.join();
+
+    stats.sendUs = busyUs / double(frames);
+    stats.received = receiver.getReceivedCount();
+    stats.lost = receiver.getLostCount();
+    stats.sendErrors = publisher.getSendErrors();
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::string group = argc > 1 ? argv[1] : "239.255.42.99";
+    SocketLibrary sockets;
+
+    printf("group %s:%u\n", group.c_str(), unsigned(PORT));
+    printf("tools  bytes  encode us  burst send us  burst received  lost  1 kHz received  lost\n");
+    for (uint32_t toolCount : { 1u, 4u, 16u, 51u, AtracsysFrame::MAX_POSES }) {
+        AtracsysFrame frame;
+        fillFrame(frame, toolCount);
+        uint8_t buffer[AtracsysPoseDatagram::MAX_SIZE];
+        size_t size = 0;
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < ENCODE_FRAMES; ++i) {
+            size = AtracsysPoseDatagram::encode(frame, 1, uint32_t(i), buffer, sizeof(buffer));
+        }
+        const double encodeUs =
+                std::chrono::duration<double, std::micro>(Clock::now() - start).count() / double(ENCODE_FRAMES);
+
+        StreamStats burst;
+        StreamStats paced;
+        if (!stream(group, toolCount, BURST_FRAMES, std::chrono::microseconds(0), burst) ||
+            !stream(group, toolCount, PACED_FRAMES, PERIOD, paced)) {
+            fprintf(stderr, "cannot open %s:%u\n", group.c_str(), unsigned(PORT));
+            return 1;
+        }
+        printf("%5u  %5zu  %9.3f  %13.2f  %14llu  %4llu  %14llu  %4llu\n", toolCount, size, encodeUs, burst.sendUs,
+               static_cast<unsigned long long>(burst.received), static_cast<unsigned long long>(burst.lost),
+               static_cast<unsigned long long>(paced.received), static_cast<unsigned long long>(paced.lost));
+        if (burst.sendErrors + paced.sendErrors > 0) {
+            printf("       %llu send errors\n", static_cast<unsigned long long>(burst.sendErrors + paced.sendErrors));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+class PacketPool;
+
+/** \brief Packed message bytes shared by every client socket.
+ *
+ * Buffers belong to a PacketPool and go back to it when the last PacketRef
+ * is released, so steady-state publishing never touches the heap. The pool
+ * holds one reference of its own on every buffer: a buffer is free while
+ * that is the only one, and whichever of the pool and the last PacketRef
+ * lets go last deletes it, so refs may outlive the pool.
+ */
+class PacketBuffer {
+public:
+    const unsigned char* data() const { return bytes.data(); }
+    size_t size() const { return used; }
+
+private:
+    friend class PacketPool;
+    friend class PacketRef;
+
+    std::vector<unsigned char> bytes;
+    size_t used = 0;
+    std::atomic<int> references{0};
+};
+
+class PacketRef {
+public:
+    PacketRef() = default;
+    explicit PacketRef(PacketBuffer* buffer) : buffer(buffer) {}
+
+    PacketRef(const PacketRef& other) : buffer(other.buffer) {
+        if (buffer != nullptr) {
+            buffer->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    PacketRef(PacketRef&& other) noexcept : buffer(other.buffer) {
+        other.buffer = nullptr;
+    }
+    PacketRef& operator=(PacketRef other) noexcept {
+        std::swap(buffer, other.buffer);
+        return *this;
+    }
+    ~PacketRef() {
+        reset();
+    }
+
+    void reset() {
+        if (buffer != nullptr) {
+            release(buffer);
+            buffer = nullptr;
+        }
+    }
+
+    const PacketBuffer* operator->() const { return buffer; }
+    const PacketBuffer& operator*() const { return *buffer; }
+    explicit operator bool() const { return buffer != nullptr; }
+
+private:
+    friend class PacketPool;
+
+    static void release(PacketBuffer* buffer) {
+        if (buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete buffer;
+        }
+    }
+
+    PacketBuffer* buffer = nullptr;
+};
+
+/** \brief Recycling pool of PacketBuffer.
+ *
+ * acquire() must be called from a single publishing thread; references may
+ * be released from any thread. The pool only grows when every buffer is
+ * still held, e.g. while many slow clients each keep a different message in
+ * flight.
+ */
+class PacketPool {
+public:
+    explicit PacketPool(size_t count = 8, size_t capacity = 4096) {
+        for (size_t i = 0; i < count; ++i) {
+            grow(capacity);
+        }
+    }
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    ~PacketPool() {
+        for (PacketBuffer* buffer : buffers) {
+            PacketRef::release(buffer);
+        }
+    }
+
+    PacketRef acquire(const void* data, size_t size) {
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            PacketBuffer& buffer = *buffers[(next + i) % buffers.size()];
+            int expected = 1;
+            if (buffer.references.compare_exchange_strong(expected, 2, std::memory_order_acquire)) {
+                next = (next + i + 1) % buffers.size();
+                return fill(buffer, data, size);
+            }
+        }
+        PacketBuffer& buffer = grow(size);
+        buffer.references.store(2, std::memory_order_relaxed);
+        return fill(buffer, data, size);
+    }
+
+    size_t getBufferCount() const {
+        return buffers.size();
+    }
+
+private:
+    PacketBuffer& grow(size_t capacity) {
+        std::unique_ptr<PacketBuffer> buffer(new PacketBuffer());
+        buffer->bytes.resize(capacity);
+        buffer->references.store(1, std::memory_order_relaxed);
+        buffers.push_back(buffer.get());
+        return *buffer.release();
+    }
+
+    static PacketRef fill(PacketBuffer& buffer, const void* data, size_t size) {
+        if (buffer.bytes.size() < size) {
+            buffer.bytes.resize(size);
+        }
+        memcpy(buffer.bytes.data(), data, size);
+        buffer.used = size;
+        return PacketRef(&buffer);
+    }
+
+    std::vector<PacketBuffer*> buffers;
+    size_t next = 0;
+};
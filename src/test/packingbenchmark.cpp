@@ -0,0 +1,146 @@
+//
+// Created on 19/10/2026.
+//
+// Cost of packing and handing one TDATA frame to the listener against the
+// number of tools, with one local client draining the stream. Also counts
+// the heap allocations made per frame once the publisher is warmed up, which
+// should be zero.
+//
+
+#include "connectionlistener.h"
+#include "trackingdatapublisher.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+const uint16_t PORT = 22230;
+const size_t WARMUP_FRAMES = 1000;
+const size_t FRAMES = 20000;
+
+// Reads and discards everything the server sends until it disconnects.
+class DrainingClient {
+public:
+    bool connect(uint16_t port) {
+        socket = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (socket == INVALID_SOCKET_HANDLE ||
+            ::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return false;
+        }
+        reader = std::thread([this]() {
+            char buffer[65536];
+            while (recv(socket, buffer, sizeof(buffer), 0) > 0) {
+            }
+        });
+        return true;
+    }
+
+    ~DrainingClient() {
+        if (socket != INVALID_SOCKET_HANDLE) {
+#ifdef _WIN32
+            ::shutdown(socket, SD_BOTH);
+#else
+            ::shutdown(socket, SHUT_RDWR);
+#endif
+        }
+        if (reader.joinable()) {
+            reader.join();
+        }
+        if (socket != INVALID_SOCKET_HANDLE) {
+            closeSocket(socket);
+        }
+    }
+
+private:
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    std::thread reader;
+};
+
+void fillFrame(AtracsysFrame& frame, size_t toolCount, size_t index) {
+    frame.index = index;
+    frame.poseCount = static_cast<uint32_t>(toolCount);
+    for (size_t i = 0; i < toolCount; ++i) {
+        AtracsysPose& pose = frame.poses[i];
+        pose.geometryId = static_cast<uint32_t>(i);
+        pose.transform[0][3] = static_cast<float>(i);
+        pose.transform[1][3] = static_cast<float>(index % 100);
+        pose.transform[2][3] = 500.f;
+    }
+}
+
+}
+
+int main() {
+    SocketLibrary sockets;
+    AtracsysFrame frame;
+
+    printf("tools  us/frame  allocations/frame\n");
+    for (size_t toolCount = 1; toolCount <= AtracsysFrame::MAX_POSES; toolCount *= 2) {
+        ConnectionListener listener;
+        TrackingDataPublisher publisher(listener);
+        for (size_t i = 0; i < toolCount; ++i) {
+            publisher.addTool(i, "tool" + std::to_string(i));
+        }
+        if (!listener.init(PORT)) {
+            fprintf(stderr, "cannot listen on port %u\n", unsigned(PORT));
+            return 1;
+        }
+
+        DrainingClient client;
+        if (!client.connect(PORT)) {
+            fprintf(stderr, "cannot connect to port %u\n", unsigned(PORT));
+            return 1;
+        }
+        while (listener.getClientCount() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        size_t index = 0;
+        for (size_t i = 0; i < WARMUP_FRAMES; ++i, ++index) {
+            fillFrame(frame, toolCount, index);
+            publisher.publish(frame);
+        }
+
+        const uint64_t allocationsBefore = allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < FRAMES; ++i, ++index) {
+            fillFrame(frame, toolCount, index);
+            publisher.publish(frame);
+        }
+        const double elapsedUs = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+        const uint64_t allocated = allocations.load() - allocationsBefore;
+
+        printf("%5zu  %8.2f  %17.3f\n", toolCount, elapsedUs / FRAMES, double(allocated) / FRAMES);
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+//
+// Created on 19/10/2026.
+//
+// Paired-point registration against known transforms: Horn on noisy
+// landmarks, RANSAC with 30% of the pairs displaced by 10 to 50 mm, which
+// must all be rejected and nothing else, and a batch of RANSAC problems
+// spread over the registration's threads.
+//
+
+#include <atracsyswrapper/atracsysregistration.h>
+#include "transformcheck.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace transformcheck;
+
+namespace {
+
+typedef AtracsysRegistration::Point Point;
+
+const float NOISE_MM = 0.1f;
+const float MAX_ROTATION_ERROR_DEG = 0.2f;
+const float MAX_TRANSLATION_ERROR_MM = 0.2f;
+const size_t BATCH_PROBLEMS = 200;
+
+struct Pairs {
+    Transform truth;
+    std::vector<Point> source;
+    std::vector<Point> target;
+    std::vector<uint8_t> outlier;
+};
+
+// Source points spread over a 200 mm cube, target points through `truth` plus noise.
+Pairs randomPairs(std::mt19937& random, size_t count, float outlierFraction) {
+    std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::uniform_real_distribution<float> displacement(10.f, 50.f);
+    std::normal_distribution<float> noise(0.f, NOISE_MM);
+    std::normal_distribution<float> gaussian;
+
+    Pairs pairs;
+    pairs.truth = randomTransform(random, 60.f, 100.f);
+    for (size_t i = 0; i < count; ++i) {
+        const Point source = { { coordinate(random), coordinate(random), coordinate(random) } };
+        Point target = posemath::transformPoint(pairs.truth, source);
+        const bool outlier = unit(random) < outlierFraction;
+        if (outlier) {
+            Point direction = { { gaussian(random), gaussian(random), gaussian(random) } };
+            const float length =
+                    std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+            const float distance = displacement(random);
+            for (int k = 0; k < 3; ++k) {
+                target[k] += direction[k] / length * distance;
+            }
+        }
+        else {
+            for (float& value : target) {
+                value += noise(random);
+            }
+        }
+        pairs.source.push_back(source);
+        pairs.target.push_back(target);
+        pairs.outlier.push_back(outlier ? 1 : 0);
+    }
+    return pairs;
+}
+
+bool checkTransform(const AtracsysRegistrationResult& result, const Pairs& pairs, const char* name) {
+    const float rotationDeg = rotationErrorDeg(result.transform, pairs.truth);
+    const float translationMM = translationErrorMM(result.transform, pairs.truth);
+    if (!result.valid || rotationDeg > MAX_ROTATION_ERROR_DEG || translationMM > MAX_TRANSLATION_ERROR_MM) {
+        printf("FAIL: %s: off by %.3f deg / %.3f mm\n", name, rotationDeg, translationMM);
+        return false;
+    }
+    return true;
+}
+
+bool checkInliers(const AtracsysRegistrationResult& result, const Pairs& pairs, const char* name) {
+    for (size_t i = 0; i < pairs.outlier.size(); ++i) {
+        if ((result.inliers[i] != 0) == (pairs.outlier[i] != 0)) {
+            printf("FAIL: %s: pair %zu %s\n", name, i,
+                   pairs.outlier[i] != 0 ? "is an outlier but was kept" : "was rejected");
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main() {
+    std::mt19937 random(20261019u);
+    AtracsysRegistration registration;
+
+    const Pairs exact = randomPairs(random, 4, 0.f);
+    AtracsysRegistrationResult result;
+    std::vector<Point> noiseless;
+    for (const Point& source : exact.source) {
+        noiseless.push_back(posemath::transformPoint(exact.truth, source));
+    }
+    if (!registration.registerPoints(exact.source, noiseless, result) || result.freMM > 1e-3f ||
+        rotationErrorDeg(result.transform, exact.truth) > 1e-2f ||
+        translationErrorMM(result.transform, exact.truth) > 1e-3f) {
+        printf("FAIL: Horn did not recover a noiseless transform from 4 pairs\n");
+        return 1;
+    }
+
+    const Pairs landmarks = randomPairs(random, 32, 0.f);
+    if (!registration.registerPoints(landmarks.source, landmarks.target, result) ||
+        !checkTransform(result, landmarks, "Horn")) {
+        return 1;
+    }
+    // The FRE stays around the 3D noise, NOISE_MM * sqrt(3).
+    if (result.freMM > 2.f * NOISE_MM * std::sqrt(3.f)) {
+        printf("FAIL: Horn FRE %.3f mm for %.2f mm noise\n", result.freMM, NOISE_MM);
+        return 1;
+    }
+
+    AtracsysRansacOptions options;
+    options.inlierThresholdMM = 1.f;
+    const Pairs contaminated = randomPairs(random, 64, 0.3f);
+    if (!registration.registerPointsRansac(contaminated.source, contaminated.target, options, result) ||
+        !checkTransform(result, contaminated, "RANSAC") || !checkInliers(result, contaminated, "RANSAC")) {
+        return 1;
+    }
+    printf("RANSAC: %zu of %zu pairs kept after %u hypotheses, FRE %.3f mm\n", result.inlierCount,
+           contaminated.source.size(), result.hypotheses, result.freMM);
+
+    std::vector<Pairs> batch;
+    std::vector<AtracsysRegistrationProblem> problems;
+    for (size_t i = 0; i < BATCH_PROBLEMS; ++i) {
+        batch.push_back(randomPairs(random, 32, 0.3f));
+        AtracsysRegistrationProblem problem;
+        problem.source = batch.back().source;
+        problem.target = batch.back().target;
+        problem.ransac = true;
+        problem.ransacOptions = options;
+        problem.ransacOptions.seed = i + 1;
+        problems.push_back(problem);
+    }
+    std::vector<AtracsysRegistrationResult> results;
+    const size_t valid = registration.registerBatch(problems, results);
+    if (valid != BATCH_PROBLEMS || results.size() != BATCH_PROBLEMS) {
+        printf("FAIL: %zu of %zu batch problems solved\n", valid, BATCH_PROBLEMS);
+        return 1;
+    }
+    for (size_t i = 0; i < BATCH_PROBLEMS; ++i) {
+        if (!checkTransform(results[i], batch[i], "batch") || !checkInliers(results[i], batch[i], "batch")) {
+            printf("in problem %zu\n", i);
+            return 1;
+        }
+    }
+
+    printf("OK\n");
+    return 0;
+}
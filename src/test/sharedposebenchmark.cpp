@@ -0,0 +1,131 @@
+//
+// Created on 19/10/2026.
+//
+// One writer publishing 16-pose frames at 1 kHz into the shared-memory ring
+// while 8 readers, each with its own mapping, poll for new frames. Prints
+// the cost of a publish and, per reader, the frames seen, the reads lost to
+// the writer and the delay from publish to read.
+//
+
+#include "sharedposepublisher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+const size_t READERS = 8;
+const size_t FRAMES = 5000;
+const uint32_t POSES = 16;
+const uint32_t CAPACITY = 1024;
+const std::chrono::microseconds PERIOD(1000);
+
+uint64_t nowUS() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct ReaderStats {
+    size_t seen = 0;
+    size_t failed = 0;
+    std::vector<uint64_t> delaysUS;
+};
+
+void readLoop(const std::string& name, ReaderStats& stats) {
+    AtracsysSharedPoseReader reader;
+    if (!reader.open(name)) {
+        return;
+    }
+    stats.delaysUS.reserve(FRAMES);
+
+    AtracsysFrame frame;
+    uint64_t lastSeen = 0;
+    while (reader.isPublisherOpen()) {
+        const uint64_t published = reader.getPublishedCount();
+        if (published == lastSeen) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (!reader.readLatest(frame)) {
+            ++stats.failed;
+            continue;
+        }
+        stats.delaysUS.push_back(nowUS() - frame.timestampUS);
+        ++stats.seen;
+        lastSeen = published;
+    }
+}
+
+uint64_t percentile(std::vector<uint64_t>& values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * double(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+}
+
+int main() {
+    const std::string name = "/atracsys-sharedposebenchmark-" + std::to_string(getpid());
+    SharedPosePublisher publisher;
+    if (!publisher.open(name, CAPACITY)) {
+        fprintf(stderr, "cannot create %s\n", name.c_str());
+        return 1;
+    }
+
+    std::vector<ReaderStats> stats(READERS);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < READERS; ++i) {
+        readers.emplace_back(readLoop, name, std::ref(stats[i]));
+    }
+
+    AtracsysFrame frame;
+    frame.poseCount = POSES;
+    for (uint32_t i = 0; i < POSES; ++i) {
+        frame.poses[i].geometryId = i;
+    }
+
+    double totalUs = 0.0;
+    double worstUs = 0.0;
+    auto next = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < FRAMES; ++i) {
+        next += PERIOD;
+        std::this_thread::sleep_until(next);
+
+        frame.index = i;
+        frame.timestampUS = nowUS();
+        const auto start = std::chrono::steady_clock::now();
+        publisher.onFrame(frame);
+        const double elapsedUs = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+        totalUs += elapsedUs;
+        worstUs = std::max(worstUs, elapsedUs);
+    }
+
+    // Readers stop once they see the segment closed.
+    publisher.close();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    printf("%zu frames of %u poses at 1 kHz: publish mean %.2f us, worst %.2f us\n",
+           FRAMES, POSES, totalUs / double(FRAMES), worstUs);
+    printf("reader  seen  failed  delay p50 us  p99 us  max us\n");
+    for (size_t i = 0; i < READERS; ++i) {
+        std::vector<uint64_t>& delays = stats[i].delaysUS;
+        const uint64_t p50 = percentile(delays, 0.5);
+        const uint64_t p99 = percentile(delays, 0.99);
+        const uint64_t worst = delays.empty() ? 0 : *std::max_element(delays.begin(), delays.end());
+        printf("%6zu  %4zu  %6zu  %12llu  %6llu  %6llu\n", i, stats[i].seen, stats[i].failed,
+               static_cast<unsigned long long>(p50), static_cast<unsigned long long>(p99),
+               static_cast<unsigned long long>(worst));
+    }
+    return 0;
+}
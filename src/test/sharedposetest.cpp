@@ -0,0 +1,111 @@
+//
+// Created on 19/10/2026.
+//
+// Lifetime of the shared-memory pose ring: a reader must notice when the
+// writer closes the segment, a second writer must not take over the segment
+// of a running one, and a writer that died without closing must be replaced
+// by the next one, with the readers of the dead segment told so.
+//
+
+#include "sharedposepublisher.h"
+
+#include <cstdio>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t CAPACITY = 16;
+
+void publish(SharedPosePublisher& publisher, uint64_t index) {
+    AtracsysFrame frame;
+    frame.index = index;
+    frame.poseCount = 1;
+    frame.poses[0].geometryId = 7;
+    publisher.onFrame(frame);
+}
+
+bool expectLatest(const AtracsysSharedPoseReader& reader, uint64_t index, const char* step) {
+    AtracsysFrame frame;
+    if (!reader.readLatest(frame) || frame.index != index) {
+        printf("FAIL: %s: latest frame is not %llu\n", step, static_cast<unsigned long long>(index));
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main() {
+    const std::string name = "/atracsys-sharedposetest-" + std::to_string(getpid());
+
+    SharedPosePublisher first;
+    if (!first.open(name, CAPACITY)) {
+        printf("FAIL: cannot create %s\n", name.c_str());
+        return 1;
+    }
+    AtracsysSharedPoseReader reader;
+    if (!reader.open(name)) {
+        printf("FAIL: cannot open %s\n", name.c_str());
+        return 1;
+    }
+    publish(first, 1);
+    if (!expectLatest(reader, 1, "open")) {
+        return 1;
+    }
+
+    SharedPosePublisher second;
+    if (second.open(name, CAPACITY)) {
+        printf("FAIL: a second writer took over the segment of a running one\n");
+        return 1;
+    }
+    if (!reader.isPublisherOpen() || !expectLatest(reader, 1, "second writer refused")) {
+        return 1;
+    }
+
+    first.close();
+    AtracsysFrame frame;
+    if (reader.isPublisherOpen() || reader.readLatest(frame) || reader.getPublishedCount() != 0) {
+        printf("FAIL: reader did not notice the writer closing the segment\n");
+        return 1;
+    }
+    reader.close();
+
+    // A writer that exits without closing leaves its segment behind.
+    const pid_t child = fork();
+    if (child == 0) {
+        SharedPosePublisher dying;
+        if (!dying.open(name, CAPACITY)) {
+            _exit(1);
+        }
+        publish(dying, 2);
+        _exit(0);
+    }
+    int status = 0;
+    if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("FAIL: the dying writer did not publish\n");
+        return 1;
+    }
+    if (!reader.open(name) || !expectLatest(reader, 2, "stale segment")) {
+        return 1;
+    }
+
+    if (!second.open(name, CAPACITY)) {
+        printf("FAIL: cannot replace the segment of a dead writer\n");
+        return 1;
+    }
+    if (reader.isPublisherOpen() || reader.readLatest(frame)) {
+        printf("FAIL: reader did not notice the stale segment being replaced\n");
+        return 1;
+    }
+
+    AtracsysSharedPoseReader current;
+    publish(second, 3);
+    if (!current.open(name) || !expectLatest(current, 3, "replacement")) {
+        return 1;
+    }
+
+    printf("OK\n");
+    return 0;
+}
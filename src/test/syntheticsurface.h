@@ -0,0 +1,106 @@
+//
+// Created on 19/10/2026.
+//
+// Bone-like test surface and digitized points for the surface registration
+// test and benchmark.
+//
+
+#pragma once
+
+#include <atracsyswrapper/atracsysmesh.h>
+#include <atracsyswrapper/atracsyssurfaceregistration.h>
+#include "transformcheck.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace syntheticsurface {
+
+using transformcheck::PI;
+
+typedef AtracsysSurfaceRegistration::Point Point;
+
+inline Point surfacePoint(double theta, double phi) {
+    // Uneven bumps, so that no rotation maps the surface onto itself.
+    const double r = 1.0 + 0.12 * std::sin(3.0 * theta) * std::cos(2.0 * phi + 0.5) +
+                     0.08 * std::cos(5.0 * phi) * std::sin(theta) * std::sin(theta) +
+                     0.05 * std::cos(2.0 * theta + phi);
+    return { { float(40.0 * r * std::sin(theta) * std::cos(phi)), float(30.0 * r * std::sin(theta) * std::sin(phi)),
+               float(55.0 * r * std::cos(theta)) } };
+}
+
+// Lumpy ellipsoid of about 80 x 60 x 110 mm, open at the poles, with 2 * stacks * slices triangles.
+inline AtracsysMesh lumpyEllipsoid(uint32_t stacks, uint32_t slices) {
+    AtracsysMesh mesh;
+    for (uint32_t i = 0; i <= stacks; ++i) {
+        const double theta = PI * (0.05 + 0.9 * double(i) / double(stacks));
+        for (uint32_t j = 0; j < slices; ++j) {
+            mesh.vertices.push_back(surfacePoint(theta, 2.0 * PI * double(j) / double(slices)));
+        }
+    }
+    for (uint32_t i = 0; i < stacks; ++i) {
+        for (uint32_t j = 0; j < slices; ++j) {
+            const uint32_t a = i * slices + j;
+            const uint32_t b = i * slices + (j + 1) % slices;
+            mesh.triangles.push_back({ { a, a + slices, b } });
+            mesh.triangles.push_back({ { b, a + slices, b + slices } });
+        }
+    }
+    return mesh;
+}
+
+/** \brief Points digitized on the x > -10 mm side of the mesh, in mesh coordinates.
+ *
+ * Each point gets Gaussian noise of `noiseMM` per axis; `outlierFraction`
+ * of them are instead lifted 3 to 10 mm off the surface along its normal.
+ */
+inline std::vector<Point> digitize(const AtracsysMesh& mesh, size_t count, float noiseMM, float outlierFraction,
+                                   std::mt19937& random) {
+    std::uniform_int_distribution<size_t> pickTriangle(0, mesh.triangles.size() - 1);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::uniform_real_distribution<float> lift(3.f, 10.f);
+    std::normal_distribution<float> noise(0.f, noiseMM);
+
+    std::vector<Point> points;
+    while (points.size() < count) {
+        const std::array<uint32_t, 3>& triangle = mesh.triangles[pickTriangle(random)];
+        const Point& a = mesh.vertices[triangle[0]];
+        const Point& b = mesh.vertices[triangle[1]];
+        const Point& c = mesh.vertices[triangle[2]];
+        float u = unit(random);
+        float v = unit(random);
+        if (u + v > 1.f) {
+            u = 1.f - u;
+            v = 1.f - v;
+        }
+        Point point;
+        for (int k = 0; k < 3; ++k) {
+            point[k] = a[k] + u * (b[k] - a[k]) + v * (c[k] - a[k]);
+        }
+        if (point[0] < -10.f) {
+            continue;
+        }
+
+        if (unit(random) < outlierFraction) {
+            const Point ab = { { b[0] - a[0], b[1] - a[1], b[2] - a[2] } };
+            const Point ac = { { c[0] - a[0], c[1] - a[1], c[2] - a[2] } };
+            Point normal = { { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2],
+                               ab[0] * ac[1] - ab[1] * ac[0] } };
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            const float distance = lift(random);
+            for (int k = 0; k < 3; ++k) {
+                point[k] += normal[k] / length * distance;
+            }
+        }
+        else {
+            for (float& coordinate : point) {
+                coordinate += noise(random);
+            }
+        }
+        points.push_back(point);
+    }
+    return points;
+}
+
+}
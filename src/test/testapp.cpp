@@ -33,6 +33,7 @@
 
 #include "../lib/src/helpers.hpp"
 #include "../lib/src/geometryHelper.hpp"
+#include "../lib/src/deviceoptions.h"
 
 #include <iomanip>
 #include <iostream>
@@ -42,8 +43,6 @@
 #endif
 
 using namespace std;
-static const unsigned ENABLE_ONBOARD_PROCESSING_OPTION = 6000;
-static const unsigned SENDING_IMAGES_OPTION = 6003;
 
 ftkLibrary lib = 0;
 uint64 sn( 0uLL );
@@ -97,13 +96,13 @@ int main( int argc, char** argv )
     if (DEV_SPRYTRACK_180 == device.Type)
     {
         cout << "Enable onboard processing" << endl;
-        if ( ftkSetInt32( lib, sn, ENABLE_ONBOARD_PROCESSING_OPTION, 1 ) != FTK_OK )
+        if ( ftkSetInt32( lib, sn, getDeviceOptionInfo( DeviceOption::OnboardProcessing ).id, 1 ) != FTK_OK )
         {
             error( "Cannot process data directly on the SpryTrack." );
         }
 
         cout << "Disable images sending" << endl;
-        if ( ftkSetInt32( lib, sn, SENDING_IMAGES_OPTION, 0 ) != FTK_OK )
+        if ( ftkSetInt32( lib, sn, getDeviceOptionInfo( DeviceOption::SendingImages ).id, 0 ) != FTK_OK )
         {
             error( "Cannot disable images sending on the SpryTrack." );
         }
@@ -0,0 +1,158 @@
+//
+// Created on 19/10/2026.
+//
+
+#include "trackingdatapublisher.h"
+
+TrackingDataPublisher::TrackingDataPublisher(ConnectionListener& listener)
+        : listener(listener) {
+    // Active streams never exceed the subscription count, so this never reallocates.
+    streams.reserve(ConnectionListener::MAX_SUBSCRIPTIONS);
+}
+
+void TrackingDataPublisher::addTool(size_t geometryId, const std::string& name) {
+    igtl::TrackingDataElement::Pointer element = igtl::TrackingDataElement::New();
+    element->SetName(name.c_str());
+    element->SetType(igtl::TrackingDataElement::TYPE_6D);
+
+    igtl::Matrix4x4 identity = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+    element->SetMatrix(identity);
+
+    listener.registerTool(name);
+    tools.push_back({ geometryId, element, false });
+}
+
+void TrackingDataPublisher::publish(const AtracsysFrame& frame) {
+    const Clock::time_point now = Clock::now();
+    if (lastFrame != Clock::time_point()) {
+        const double period = std::chrono::duration<double, std::milli>(now - lastFrame).count();
+        framePeriodMs = framePeriodMs == 0.0 ? period : 0.9 * framePeriodMs + 0.1 * period;
+    }
+    lastFrame = now;
+
+    ConnectionListener::Subscription subscriptions[ConnectionListener::MAX_SUBSCRIPTIONS];
+    const size_t count = listener.getSubscriptions(subscriptions, ConnectionListener::MAX_SUBSCRIPTIONS);
+    if (tools.empty() || count == 0) {
+        return;
+    }
+
+    // Mark every stream still subscribed before creating new ones, so that a
+    // new subscription only ever takes over an abandoned stream.
+    Stream* matched[ConnectionListener::MAX_SUBSCRIPTIONS];
+    for (Stream& stream : streams) {
+        stream.active = false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        matched[i] = findStream(subscriptions[i]);
+        if (matched[i] != nullptr) {
+            matched[i]->active = true;
+        }
+    }
+
+    Stream* due[ConnectionListener::MAX_SUBSCRIPTIONS];
+    size_t dueCount = 0;
+    uint64_t dueTools = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Stream& stream = matched[i] != nullptr ? *matched[i] : createStream(subscriptions[i]);
+        stream.active = true;
+        if (isDue(stream, now)) {
+            due[dueCount++] = &stream;
+            dueTools |= stream.subscription.toolMask;
+        }
+    }
+    if (dueCount == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < tools.size(); ++i) {
+        const AtracsysPose* pose = frame.findPose(static_cast<uint32_t>(tools[i].geometryId));
+        if ((pose != nullptr) != tools[i].visible) {
+            tools[i].visible = pose != nullptr;
+            ++visibilityVersion;
+        }
+        if (pose == nullptr || (i < 64 && (dueTools & (1ull << i)) == 0)) {
+            continue;
+        }
+
+        igtl::Matrix4x4 matrix;
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                matrix[r][c] = pose->transform[r][c];
+            }
+        }
+        tools[i].element->SetMatrix(matrix);
+    }
+
+    for (size_t i = 0; i < dueCount; ++i) {
+        if (due[i]->visibilityVersion != visibilityVersion) {
+            addElements(*due[i]);
+        }
+        igtl::TrackingDataMessage::Pointer& message = due[i]->message;
+        message->Pack();
+        listener.send(due[i]->subscription,
+                      pool.acquire(message->GetPackPointer(), static_cast<size_t>(message->GetPackSize())));
+    }
+}
+
+TrackingDataPublisher::Stream* TrackingDataPublisher::findStream(const ConnectionListener::Subscription& subscription) {
+    for (Stream& stream : streams) {
+        if (stream.subscription == subscription) {
+            return &stream;
+        }
+    }
+    return nullptr;
+}
+
+TrackingDataPublisher::Stream& TrackingDataPublisher::createStream(const ConnectionListener::Subscription& subscription) {
+    // Subscriptions are few and long lived: build the message once and reuse
+    // an idle stream's slot if there is one.
+    Stream* stream = nullptr;
+    for (Stream& candidate : streams) {
+        if (!candidate.active) {
+            stream = &candidate;
+            break;
+        }
+    }
+    if (stream == nullptr) {
+        streams.emplace_back();
+        stream = &streams.back();
+    }
+
+    stream->subscription = subscription;
+    stream->message = igtl::TrackingDataMessage::New();
+    stream->message->SetDeviceName("Atracsys");
+    stream->visibilityVersion = 0;
+    stream->nextDue = Clock::time_point();
+    return *stream;
+}
+
+void TrackingDataPublisher::addElements(Stream& stream) {
+    stream.message->ClearTrackingDataElements();
+    for (size_t i = 0; i < tools.size(); ++i) {
+        if (tools[i].visible && (i >= 64 || (stream.subscription.toolMask & (1ull << i)) != 0)) {
+            stream.message->AddTrackingDataElement(tools[i].element);
+        }
+    }
+    stream.visibilityVersion = visibilityVersion;
+}
+
+bool TrackingDataPublisher::isDue(Stream& stream, Clock::time_point now) const {
+    if (stream.subscription.intervalMs == 0) {
+        return true;
+    }
+
+    // Send the frame closest to each requested instant: a frame counts as due
+    // once it is within half a device period of the deadline.
+    const auto interval = std::chrono::milliseconds(stream.subscription.intervalMs);
+    const auto halfPeriod = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(framePeriodMs / 2.0));
+    if (now + halfPeriod < stream.nextDue) {
+        return false;
+    }
+
+    stream.nextDue += interval;
+    if (stream.nextDue + interval < now) {
+        stream.nextDue = now + interval;
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+//
+// Created on 19/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <igtl/igtlTrackingDataMessage.h>
+#include <atracsyswrapper/atracsysframe.h>
+#include "connectionlistener.h"
+#include "packetpool.h"
+
+/** \brief Builds TDATA messages for the subscriptions clients hold.
+ *
+ * Elements are created once in addTool() and shared by one preallocated
+ * message per subscription (tool subset and interval). publish() only packs
+ * the messages of subscriptions that are due in this frame, decimating the
+ * device rate to the requested interval, and hands each packed buffer to
+ * the clients of that subscription. A tool that is not in the frame is
+ * left out of the messages until it is seen again; the messages are only
+ * rebuilt, and repacked at a new size, when the set of visible tools changes.
+ */
+class TrackingDataPublisher {
+public:
+    explicit TrackingDataPublisher(ConnectionListener& listener);
+
+    // Must be called before the listener is started.
+    void addTool(size_t geometryId, const std::string& name);
+
+    void publish(const AtracsysFrame& frame);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Tool {
+        size_t geometryId;
+        igtl::TrackingDataElement::Pointer element;
+        bool visible = false;
+    };
+
+    struct Stream {
+        ConnectionListener::Subscription subscription;
+        igtl::TrackingDataMessage::Pointer message;
+        Clock::time_point nextDue;
+        uint64_t visibilityVersion = 0;
+        bool active = false;
+    };
+
+    Stream* findStream(const ConnectionListener::Subscription& subscription);
+    Stream& createStream(const ConnectionListener::Subscription& subscription);
+    bool isDue(Stream& stream, Clock::time_point now) const;
+    void addElements(Stream& stream);
+
+    ConnectionListener& listener;
+    std::vector<Tool> tools;
+    std::vector<Stream> streams;
+    PacketPool pool;
+    // Bumped whenever a tool appears or disappears.
+    uint64_t visibilityVersion = 1;
+
+    Clock::time_point lastFrame;
+    double framePeriodMs = 0.0;
+};
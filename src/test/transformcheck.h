@@ -0,0 +1,66 @@
+//
+// Created on 19/10/2026.
+//
+// Random rigid transforms and how far a recovered transform is from the
+// truth, shared by the registration tests and benchmarks.
+//
+
+#pragma once
+
+#include <atracsyswrapper/atracsysmarker.h>
+#include "posemath.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace transformcheck {
+
+typedef AtracsysMarker::Transform Transform;
+
+const double PI = 3.14159265358979323846;
+
+// Rotation by `angleDeg` about a random axis followed by a translation of `translationMM` in a random direction.
+inline Transform randomTransform(std::mt19937& random, float angleDeg, float translationMM) {
+    std::normal_distribution<float> gaussian;
+    std::array<float, 3> axis = { { gaussian(random), gaussian(random), gaussian(random) } };
+    std::array<float, 3> direction = { { gaussian(random), gaussian(random), gaussian(random) } };
+    const float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    const float directionLength =
+            std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+
+    const double half = 0.5 * double(angleDeg) * PI / 180.0;
+    posemath::Quaternion q;
+    q.w = float(std::cos(half));
+    q.x = float(std::sin(half)) * axis[0] / axisLength;
+    q.y = float(std::sin(half)) * axis[1] / axisLength;
+    q.z = float(std::sin(half)) * axis[2] / axisLength;
+
+    Transform transform = posemath::identity();
+    posemath::setRotation(posemath::normalized(q), transform);
+    for (int k = 0; k < 3; ++k) {
+        transform[k][3] = direction[k] / directionLength * translationMM;
+    }
+    return transform;
+}
+
+// Rotation angle between two transforms.
+inline float rotationErrorDeg(const Transform& a, const Transform& b) {
+    double trace = 0.0;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            trace += double(a[row][column]) * double(b[row][column]);
+        }
+    }
+    return float(std::acos(std::max(-1.0, std::min(1.0, 0.5 * (trace - 1.0)))) * 180.0 / PI);
+}
+
+inline float translationErrorMM(const Transform& a, const Transform& b) {
+    const float dx = a[0][3] - b[0][3];
+    const float dy = a[1][3] - b[1][3];
+    const float dz = a[2][3] - b[2][3];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+}
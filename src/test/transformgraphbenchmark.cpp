@@ -0,0 +1,116 @@
+//
+// Created on 19/10/2026.
+//
+// AtracsysTransformGraph query cost against graph size. A chain of N frames
+// hangs off one tracked marker and the query spans the whole chain: a cache
+// hit, a recompute after update() moved the marker, and a cold lookup that
+// also searches the path. A star of up to 64 tracked markers around the
+// camera then shows the cost of update() and of a marker-to-marker query
+// after one of the two markers moved.
+//
+
+#include <atracsyswrapper/atracsystransformgraph.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef AtracsysTransformGraph::Transform Transform;
+
+Transform translation(float x, float y, float z) {
+    return { { { 1, 0, 0, x }, { 0, 1, 0, y }, { 0, 0, 1, z }, { 0, 0, 0, 1 } } };
+}
+
+// Mean time of `repeats` calls in microseconds.
+template<typename Call>
+double timeUs(size_t repeats, Call&& call) {
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+        call(i);
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / double(repeats);
+}
+
+void chain(size_t nodes) {
+    AtracsysTransformGraph graph;
+    graph.addTrackedEdge("frame0", "camera", 0);
+    for (size_t i = 1; i < nodes; ++i) {
+        graph.setStaticEdge("frame" + std::to_string(i), "frame" + std::to_string(i - 1), translation(0.f, 0.f, 1.f));
+    }
+    const AtracsysTransformGraph::NodeId tip = graph.findNode("frame" + std::to_string(nodes - 1));
+    const AtracsysTransformGraph::NodeId camera = graph.findNode("camera");
+
+    AtracsysFrame frame;
+    frame.poseCount = 1;
+    frame.poses[0].geometryId = 0;
+    graph.update(frame);
+
+    Transform result;
+    const size_t repeats = std::max<size_t>(100, 400000 / nodes);
+    graph.lookup(tip, camera, result);
+    const double hitUs = timeUs(repeats, [&](size_t) { graph.lookup(tip, camera, result); });
+
+    const double updatedUs = timeUs(repeats, [&](size_t i) {
+        frame.poses[0].transform[0][3] = float(i);
+        graph.update(frame);
+        graph.lookup(tip, camera, result);
+    });
+
+    // Every added edge invalidates the cached paths.
+    size_t added = 0;
+    const double coldUs = timeUs(std::max<size_t>(10, repeats / 10), [&](size_t) {
+        graph.setStaticEdge("extra" + std::to_string(added++), "camera", translation(1.f, 0.f, 0.f));
+        graph.lookup(tip, camera, result);
+    });
+
+    printf("%6zu  %10.3f  %14.3f  %9.3f\n", nodes, hitUs, updatedUs, coldUs);
+}
+
+void star(uint32_t markers) {
+    AtracsysTransformGraph graph;
+    AtracsysFrame frame;
+    frame.poseCount = markers;
+    for (uint32_t i = 0; i < markers; ++i) {
+        graph.addTrackedEdge("marker" + std::to_string(i), "camera", i);
+        frame.poses[i].geometryId = i;
+    }
+    const AtracsysTransformGraph::NodeId first = graph.findNode("marker0");
+    const AtracsysTransformGraph::NodeId last = graph.findNode("marker" + std::to_string(markers - 1));
+
+    Transform result;
+    graph.update(frame);
+    graph.lookup(first, last, result);
+    const size_t repeats = 100000;
+    const double updateUs = timeUs(repeats, [&](size_t i) {
+        frame.poses[0].transform[0][3] = float(i);
+        graph.update(frame);
+    });
+    const double queryUs = timeUs(repeats, [&](size_t i) {
+        frame.poses[0].transform[0][3] = float(i);
+        graph.update(frame);
+        graph.lookup(first, last, result);
+    }) - updateUs;
+
+    printf("%7u  %9.3f  %16.3f\n", markers, updateUs, queryUs);
+}
+
+}
+
+int main() {
+    printf("chain: query from the end of the chain into the camera\n");
+    printf(" nodes  cache hit us  after update us  cold us\n");
+    for (size_t nodes = 8; nodes <= 4096; nodes *= 4) {
+        chain(nodes);
+    }
+
+    printf("\nstar: tracked markers around the camera, query between two of them\n");
+    printf("markers  update us  query after update us\n");
+    for (uint32_t markers : { 2u, 8u, 16u, 32u, AtracsysFrame::MAX_POSES }) {
+        star(markers);
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+// Created on 19/10/2026.
+//
+// Wake-up latency of in-process frame consumers for each wait strategy: a
+// writer publishes 2000 frames at 1 kHz into a FrameChannel while 1 or 4
+// consumers wait on it. Prints the delay from publish to the consumer
+// holding the frame, the frames missed and the CPU used by the whole
+// process, which is mostly the waiting consumers.
+//
+
+#include "framechannel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const size_t FRAMES = 2000;
+const std::chrono::microseconds PERIOD(1000);
+const uint32_t SPIN_ITERATIONS = 20000;
+
+uint64_t nowUS() {
+    return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count());
+}
+
+uint64_t percentile(std::vector<uint64_t>& values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * double(values.size())));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void run(AtracsysWaitStrategy strategy, const char* name, size_t consumerCount) {
+    std::shared_ptr<FrameChannel> channel = std::make_shared<FrameChannel>();
+    std::vector<std::vector<uint64_t>> delays(consumerCount);
+    std::vector<uint64_t> missed(consumerCount, 0);
+
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < consumerCount; ++i) {
+        consumers.emplace_back([&channel, &delays, &missed, strategy, i]() {
+            FrameConsumer consumer(channel, strategy, SPIN_ITERATIONS);
+            AtracsysFrame frame;
+            delays[i].reserve(FRAMES);
+            while (consumer.waitNext(frame, 1000)) {
+                delays[i].push_back(nowUS() - frame.timestampUS);
+            }
+            missed[i] = consumer.getMissedCount();
+        });
+    }
+    // Let the consumers reach their wait before the first frame.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const std::clock_t cpuStart = std::clock();
+    const Clock::time_point start = Clock::now();
+    Clock::time_point next = start;
+    AtracsysFrame frame;
+    for (size_t i = 0; i < FRAMES; ++i) {
+        next += PERIOD;
+        std::this_thread::sleep_until(next);
+        frame.index = i;
+        frame.timestampUS = nowUS();
+        channel->onFrame(frame);
+    }
+    const double cpuS = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const double wallS = std::chrono::duration<double>(Clock::now() - start).count();
+    channel->close();
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::vector<uint64_t> all;
+    uint64_t totalMissed = 0;
+    for (size_t i = 0; i < consumerCount; ++i) {
+        all.insert(all.end(), delays[i].begin(), delays[i].end());
+        totalMissed += missed[i];
+    }
+    const uint64_t p50 = percentile(all, 0.5);
+    const uint64_t p99 = percentile(all, 0.99);
+    const uint64_t worst = all.empty() ? 0 : *std::max_element(all.begin(), all.end());
+    printf("%-12s  %9zu  %6llu  %6llu  %6llu  %6llu  %5.0f\n", name, consumerCount,
+           static_cast<unsigned long long>(p50), static_cast<unsigned long long>(p99),
+           static_cast<unsigned long long>(worst), static_cast<unsigned long long>(totalMissed),
+           100.0 * cpuS / wallS);
+}
+
+}
+
+int main() {
+    printf("%zu frames at 1 kHz, %u spin iterations\n", FRAMES, SPIN_ITERATIONS);
+    printf("strategy      consumers  p50 us  p99 us  max us  missed  cpu %%\n");
+    for (size_t consumerCount : { size_t(1), size_t(4) }) {
+        run(AtracsysWaitStrategy::BusySpin, "BusySpin", consumerCount);
+        run(AtracsysWaitStrategy::SpinThenPark, "SpinThenPark", consumerCount);
+        run(AtracsysWaitStrategy::Block, "Block", consumerCount);
+    }
+    return 0;
+}
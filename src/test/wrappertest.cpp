@@ -4,6 +4,8 @@
 
 #include "../../lib/src/atracsyswrapperimpl.h"
 #include "connectionlistener.h"
+#include "trackingdatapublisher.h"
+#include <atracsyswrapper/atracsysframeconsumer.h>
 #include <thread>
 #include <chrono>
 
@@ -34,28 +36,31 @@ void printMarkers(std::map<size_t, AtracsysMarker> markers)
 
 int main(int argc, char **argv) {
     auto wrapper = AtracsysWrapper::New();
-    wrapper->init();
-
-    ConnectionListener cl;
-    cl.init();
+    AtracsysStatus status = wrapper->init();
+    if (!status) {
+        std::cerr << status.getMessage() << ": " << wrapper->getLastErrorString() << std::endl;
+        return 1;
+    }
 
     wrapper->addGeometry("geometry/geometry002.ini", "Pointer");
 	wrapper->addGeometry("geometry/geometry003.ini", "Ultrasound");
     wrapper->startTracking();
 
+    ConnectionListener cl;
+	TrackingDataPublisher publisher(cl);
+	for (const auto& entry : wrapper->getMarkers()) {
+		publisher.addTool(entry.first, entry.second.getName());
+	}
+    cl.init();
+
+	// Frames only list the tools seen in them, so hidden tools drop out of the stream.
+	auto consumer = wrapper->createConsumer();
+	AtracsysFrame frame;
 	bool run = true;
 	while (run) {
 		wrapper->getMarkerPositions();
-		auto markers = wrapper->getMarkers();
-
-		for (auto entry : markers) {
-
-			igtl::Matrix4x4 matrix;
-			for (int i = 0; i < 4; ++i) {
-				for (int j = 0; j < 4; ++j) {
-					matrix[i][j] = entry.second.getTransform()[i][j];
-				}
-			}
+		if (consumer->tryNext(frame)) {
+			publisher.publish(frame);
 		}
 
 		std::this_thread::sleep_for(20ms);